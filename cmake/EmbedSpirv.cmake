@@ -0,0 +1,52 @@
+# ##############################################################################
+# A Logan Thomas Barnes project
+# ##############################################################################
+# Writes every SPIR-V file in SPIRV_FILES ("|" separated) to OUTPUT_FILE as a
+# constexpr uint32 array, along with a table of the arrays keyed by each file's
+# path relative to SHADER_DIR.
+#
+# cmake -D SHADER_DIR=... -D SPIRV_FILES=... -D OUTPUT_FILE=... -P EmbedSpirv.cmake
+# ##############################################################################
+string( REPLACE "|" ";" SPIRV_FILES "${SPIRV_FILES}" )
+
+set( ARRAYS "" )
+set( ENTRIES "" )
+set( SPIRV_COUNT 0 )
+
+foreach( SPIRV_FILE ${SPIRV_FILES} )
+  file( RELATIVE_PATH SPIRV_NAME ${SHADER_DIR} ${SPIRV_FILE} )
+  string( MAKE_C_IDENTIFIER ${SPIRV_NAME} ARRAY_NAME )
+
+  # SPIR-V is a stream of little endian words
+  file( READ ${SPIRV_FILE} SPIRV_HEX HEX )
+  string(
+    REGEX REPLACE
+    "([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])"
+    "0x\\4\\3\\2\\1U, "
+    SPIRV_WORDS
+    "${SPIRV_HEX}"
+  )
+  # Eight words per line
+  string( REPEAT "0x[0-9a-f]+U, " 8 LINE_PATTERN )
+  string( REGEX REPLACE "(${LINE_PATTERN})" "\\1\n    " SPIRV_WORDS "${SPIRV_WORDS}" )
+  string( REPLACE ", \n" ",\n" SPIRV_WORDS "${SPIRV_WORDS}" )
+  string( STRIP "${SPIRV_WORDS}" SPIRV_WORDS )
+
+  string( APPEND ARRAYS "constexpr uint32 ${ARRAY_NAME}[] = {\n    ${SPIRV_WORDS}\n};\n\n" )
+  string( APPEND ENTRIES "    EmbeddedSpirv{ \"${SPIRV_NAME}\", ${ARRAY_NAME} },\n" )
+  math( EXPR SPIRV_COUNT "${SPIRV_COUNT} + 1" )
+endforeach()
+
+file(
+  WRITE ${OUTPUT_FILE}
+  "// Generated by cmake/EmbedSpirv.cmake. Do not edit.\n"
+  "#pragma once\n\n"
+  "#include \"ltb/vlk/embedded_spirv.hpp\"\n\n"
+  "#include <array>\n\n"
+  "namespace ltb::vlk::detail\n{\n\n"
+  "${ARRAYS}"
+  "constexpr auto embedded_spirv_table = std::array< EmbeddedSpirv, ${SPIRV_COUNT} >{\n"
+  "${ENTRIES}"
+  "};\n\n"
+  "} // namespace ltb::vlk::detail\n"
+)
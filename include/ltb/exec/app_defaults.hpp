@@ -12,7 +12,9 @@
 namespace ltb::exec
 {
 
-constexpr auto max_frames_in_flight = 3U;
-constexpr auto max_possible_timeout = std::numeric_limits< uint64 >::max( );
+/// \brief The number of frames given their own resources when `--frames-in-flight` is not
+///        passed (see `AppSettings::frames_in_flight`).
+constexpr auto default_frames_in_flight = 3U;
+constexpr auto max_possible_timeout     = std::numeric_limits< uint64 >::max( );
 
 } // namespace ltb::exec
@@ -4,6 +4,8 @@
 #pragma once
 
 // project
+#include "ltb/exec/app_settings.hpp"
+#include "ltb/utils/cpu_profiler.hpp"
 #include "ltb/window/glfw_context.hpp"
 #include "ltb/window/glfw_update_loop.hpp"
 #include "ltb/window/glfw_window.hpp"
@@ -11,33 +13,56 @@
 // external
 #include <spdlog/spdlog.h>
 
+// standard
+#include <cstdlib>
+
 namespace ltb::exec
 {
 namespace detail
 {
 
 template < typename WindowedApp >
-auto windowed_app_main_impl( window::WindowSettings window_settings ) -> utils::Result< void >
+auto windowed_app_main_impl( window::WindowSettings window_settings, AppSettings app_settings )
+    -> utils::Result< void >
 {
 #if !defined( NDEBUG )
     spdlog::set_level( spdlog::level::debug );
 #endif
 
+    // Setting LTB_CPU_TRACE to a file path records the whole run, initialization included.
+    auto const* const trace_path = std::getenv( "LTB_CPU_TRACE" );
+    if ( nullptr != trace_path )
+    {
+        utils::set_cpu_profiler_thread_name( "Main" );
+        utils::set_cpu_profiler_enabled( true );
+    }
+
     auto glfw   = window::GlfwContext{ };
     auto window = window::GlfwWindow{ glfw, std::move( window_settings ) };
 
-    auto app = WindowedApp{ glfw, window };
+    auto app = WindowedApp{ glfw, window, std::move( app_settings ) };
+
+    LTB_CHECK( window::run_update_loop( glfw, window, app ) );
+
+    if ( nullptr != trace_path )
+    {
+        LTB_CHECK( utils::write_cpu_trace_json( trace_path ) );
+        spdlog::info( "CPU trace written to '{}'", trace_path );
+    }
 
-    return window::run_update_loop( glfw, window, app );
+    return utils::success( );
 }
 
 } // namespace detail
 
 template < typename WindowedApp >
-auto windowed_app_main( window::WindowSettings window_settings ) -> int32
+auto windowed_app_main( window::WindowSettings window_settings, AppSettings app_settings = { } )
+    -> int32
 {
-    if ( auto result
-         = detail::windowed_app_main_impl< WindowedApp >( std::move( window_settings ) ) )
+    if ( auto result = detail::windowed_app_main_impl< WindowedApp >(
+             std::move( window_settings ),
+             std::move( app_settings )
+         ) )
     {
         spdlog::info( "Exiting without errors" );
         return EXIT_SUCCESS;
@@ -60,7 +85,17 @@ auto windowed_app_main( int32 const argc, char const* const* const argv ) -> int
         title = executable_path.filename( ).string( );
     }
 
-    return windowed_app_main< WindowedApp >( window::WindowSettings{ .title = title } );
+    auto app_settings = parse_app_settings( argc, argv );
+    if ( !app_settings )
+    {
+        spdlog::error( app_settings.error( ).debug_error_message( ) );
+        return EXIT_FAILURE;
+    }
+
+    return windowed_app_main< WindowedApp >(
+        window::WindowSettings{ .title = title },
+        std::move( app_settings.value( ) )
+    );
 }
 
 } // namespace ltb::exec
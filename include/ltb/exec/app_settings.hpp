@@ -0,0 +1,25 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/exec/app_defaults.hpp"
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+
+namespace ltb::exec
+{
+
+/// \brief Options shared by every windowed app, passed to the app's constructor.
+struct AppSettings
+{
+    /// \brief The number of frames given their own command buffers, uniforms and
+    ///        descriptor sets. Set with `--frames-in-flight`.
+    uint32 frames_in_flight = default_frames_in_flight;
+};
+
+/// \brief Parses the command line options that fill `AppSettings`.
+auto parse_app_settings( int32 argc, char const* const* argv ) -> utils::Result< AppSettings >;
+
+} // namespace ltb::exec
@@ -0,0 +1,104 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/exec/app_defaults.hpp"
+#include "ltb/utils/duration.hpp"
+#include "ltb/utils/types.hpp"
+
+// standard
+#include <chrono>
+#include <deque>
+
+namespace ltb::exec
+{
+
+enum class FramePacingMode
+{
+    /// \brief At most two frames in flight. The start of each frame is also delayed so
+    ///        the CPU finishes recording just before the GPU is ready for it, keeping
+    ///        the time between reading input and presenting the result short.
+    LowLatency,
+    /// \brief The CPU runs as far ahead as every allocated frame allows so the GPU is
+    ///        never left waiting on it.
+    Throughput,
+};
+
+struct FramePacerSettings
+{
+    /// \brief The number of frames given their own resources. It is chosen when an app is
+    ///        initialized and changing it means rebuilding everything sized by it. The
+    ///        pacing mode only limits how many of these frames are used.
+    uint32 max_frames_in_flight = default_frames_in_flight;
+
+    FramePacingMode mode = FramePacingMode::LowLatency;
+
+    /// \brief In `LowLatency` mode, the time the CPU is still left waiting on the GPU each
+    ///        frame. It absorbs frame time jitter so the GPU does not go idle.
+    utils::Duration wait_margin = utils::duration_micros( 500 );
+};
+
+/// \brief Measures the latency from the start of each CPU frame to the completion of its
+///        GPU work and throttles the CPU so it only runs as far ahead of the GPU as the
+///        pacing mode asks for.
+///
+///        Each frame: wait for the frame's resources, call `frames_completed` and then
+///        `begin_frame` before reading any input.
+class FramePacer
+{
+public:
+    explicit( false ) FramePacer( FramePacerSettings settings );
+
+    auto set_mode( FramePacingMode mode ) -> void;
+
+    /// \brief The number of frames that may currently be in flight.
+    [[nodiscard( "Const computation" )]]
+    auto frames_in_flight( ) const -> uint32;
+
+    /// \brief Records the completion of every begun frame with an id up to `completed_id`.
+    auto frames_completed( uint64 completed_id ) -> void;
+
+    /// \brief Starts frame `frame_id`, which must be larger than every previous id.
+    ///        `blocked` is how long the CPU waited for the frame's resources. In
+    ///        `LowLatency` mode this sleeps for the current delay before returning.
+    auto begin_frame( uint64 frame_id, utils::Duration blocked ) -> void;
+
+    /// \brief The smoothed time from `begin_frame` to the completion of a frame.
+    [[nodiscard( "Const getter" )]]
+    auto latency( ) const -> utils::Duration;
+
+    /// \brief The smoothed time between successive calls to `begin_frame`.
+    [[nodiscard( "Const getter" )]]
+    auto frame_interval( ) const -> utils::Duration;
+
+    /// \brief The time `begin_frame` currently sleeps for.
+    [[nodiscard( "Const getter" )]]
+    auto delay( ) const -> utils::Duration;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> FramePacerSettings const&;
+
+private:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    struct StartedFrame
+    {
+        uint64    frame_id   = 0U;
+        TimePoint start_time = { };
+    };
+
+    FramePacerSettings settings_;
+
+    std::deque< StartedFrame > started_frames_ = { };
+    TimePoint                  last_start_     = { };
+
+    utils::Duration latency_        = utils::Duration::zero( );
+    utils::Duration frame_interval_ = utils::Duration::zero( );
+    utils::Duration delay_          = utils::Duration::zero( );
+
+    auto update_delay( utils::Duration blocked ) -> void;
+};
+
+} // namespace ltb::exec
@@ -4,6 +4,7 @@
 #pragma once
 
 // program
+#include "ltb/utils/cpu_profiler.hpp"
 #include "ltb/utils/duration.hpp"
 #include "ltb/utils/result.hpp"
 #include "ltb/utils/types.hpp"
@@ -72,6 +73,8 @@ template < typename App >
 auto single_loop_iteration( InternalLoopState& internal_state, UpdateLoopStatus& status, App& app )
     -> void
 {
+    LTB_PROFILE_ZONE( "single_loop_iteration" );
+
     auto const new_time          = std::chrono::steady_clock::now( );
     auto       frame_time        = new_time - internal_state.previous_time;
     internal_state.previous_time = new_time;
@@ -91,6 +94,7 @@ auto single_loop_iteration( InternalLoopState& internal_state, UpdateLoopStatus&
             status.cumulative_time += status.update_time_step;
             internal_state.accumulator -= status.update_time_step;
 
+            LTB_PROFILE_ZONE( "fixed_step_update" );
             status.requests = app.fixed_step_update( status );
         }
 
@@ -102,7 +106,10 @@ auto single_loop_iteration( InternalLoopState& internal_state, UpdateLoopStatus&
             / utils::to_seconds< float64 >( status.update_time_step );
     }
 
-    status.requests = app.frame_update( status );
+    {
+        LTB_PROFILE_ZONE( "frame_update" );
+        status.requests = app.frame_update( status );
+    }
 }
 
 template < typename App >
@@ -116,7 +123,10 @@ template < typename App >
     requires IsUpdatable< App >
 auto run_update_loop( App& app, UpdateLoopStatus status ) -> utils::Result< void >
 {
-    LTB_CHECK( status, app.initialize( ) );
+    {
+        LTB_PROFILE_ZONE( "initialize" );
+        LTB_CHECK( status, app.initialize( ) );
+    }
 
     auto internal_state = InternalLoopState{ status.update_time_step };
 
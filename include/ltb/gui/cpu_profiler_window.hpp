@@ -0,0 +1,13 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace ltb::gui
+{
+
+/// \brief Shows a "CPU Profiler" window that starts and stops recording profile zones and
+///        exports the recording as a Chrome trace.
+auto configure_cpu_profiler_window( ) -> void;
+
+} // namespace ltb::gui
@@ -0,0 +1,16 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/objs/fwd.hpp"
+
+namespace ltb::gui
+{
+
+/// \brief Shows a "GPU Memory" window with the usage and budget of every memory
+///        heap followed by the memory held by each allocation tag.
+auto configure_gpu_memory_window( vlk::objs::VulkanGpu const& gpu ) -> void;
+
+} // namespace ltb::gui
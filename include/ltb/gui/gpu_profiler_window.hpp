@@ -0,0 +1,21 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/objs/fwd.hpp"
+
+// standard
+#include <vector>
+
+namespace ltb::gui
+{
+
+/// \brief Shows a "GPU Profiler" window with the min/avg/p99 GPU time of every scope
+///        measured by `profilers` and buttons that export the table as CSV or JSON.
+auto configure_gpu_profiler_window(
+    std::vector< vlk::objs::VulkanGpuProfiler const* > const& profilers
+) -> void;
+
+} // namespace ltb::gui
@@ -0,0 +1,78 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/macro.hpp"
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/timers.hpp"
+#include "ltb/utils/types.hpp"
+
+// standard
+#include <atomic>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace ltb::utils
+{
+namespace detail
+{
+
+inline auto cpu_profiler_enabled = std::atomic< bool >{ false };
+
+} // namespace detail
+
+/// \brief Starts or stops recording zones. Zones that begin while recording is off cost a
+///        single relaxed load.
+auto set_cpu_profiler_enabled( bool enabled ) -> void;
+
+[[nodiscard( "Const getter" )]]
+inline auto is_cpu_profiler_enabled( ) -> bool
+{
+    return detail::cpu_profiler_enabled.load( std::memory_order_relaxed );
+}
+
+/// \brief The name of the calling thread in exported traces.
+auto set_cpu_profiler_thread_name( std::string name ) -> void;
+
+/// \brief Discards every recorded zone, on every thread.
+auto clear_cpu_profile( ) -> void;
+
+/// \brief Writes every recorded zone as Chrome `trace_event` JSON, which can be opened
+///        with chrome://tracing or https://ui.perfetto.dev.
+auto write_cpu_trace_json( std::filesystem::path const& file_path ) -> Result< void >;
+
+/// \brief Records the time from its construction to its destruction to the calling thread's
+///        event buffer. Zones on the same thread nest by time, so they must be destroyed in
+///        the reverse order they were created, which scoped variables guarantee.
+class CpuProfileZone
+{
+public:
+    /// \brief `name` is stored by pointer and must outlive the profile, e.g. a literal.
+    explicit CpuProfileZone( char const* name );
+    ~CpuProfileZone( );
+
+    CpuProfileZone( CpuProfileZone const& )                    = delete;
+    CpuProfileZone( CpuProfileZone&& )                         = delete;
+    auto operator=( CpuProfileZone const& ) -> CpuProfileZone& = delete;
+    auto operator=( CpuProfileZone&& ) -> CpuProfileZone&      = delete;
+
+private:
+    char const* name_ = nullptr;
+
+    // Only started while recording so disabled zones never read the clock.
+    std::optional< Timer > timer_ = std::nullopt;
+};
+
+} // namespace ltb::utils
+
+/// \brief Profiles the rest of the enclosing scope as a zone called `name`. Defining
+///        LTB_VLK_DISABLE_CPU_PROFILER compiles zones out entirely.
+#if defined( LTB_VLK_DISABLE_CPU_PROFILER )
+#define LTB_PROFILE_ZONE( name ) static_cast< void >( 0 )
+#else
+#define LTB_PROFILE_ZONE( name )                                                                   \
+    ::ltb::utils::CpuProfileZone const LTB_UNIQUE_NAME( ltb_profile_zone_ )( name )
+#endif
@@ -0,0 +1,16 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// standard
+#include <string>
+#include <string_view>
+
+namespace ltb::utils
+{
+
+/// \brief Escapes quotes and backslashes so `text` can be written inside a JSON string.
+auto escape_json( std::string_view text ) -> std::string;
+
+} // namespace ltb::utils
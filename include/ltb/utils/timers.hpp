@@ -18,11 +18,16 @@ class Timer
 public:
     Timer( );
 
+    using TimePoint = std::chrono::time_point< std::chrono::steady_clock >;
+
     auto start( ) -> void;
     auto duration_since_start( ) -> Duration;
 
+    [[nodiscard( "Const getter" )]]
+    auto start_time( ) const -> TimePoint;
+
 private:
-    std::chrono::time_point< std::chrono::steady_clock > start_time_;
+    TimePoint start_time_;
 };
 
 class ScopedTimer
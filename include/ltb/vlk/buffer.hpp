@@ -41,6 +41,11 @@ public:
     [[nodiscard( "Const getter" )]]
     auto memory_requirements( ) const -> vk::MemoryRequirements const&;
 
+    /// \brief Needs `eShaderDeviceAddress` usage, memory that was allocated with
+    ///        `eDeviceAddress`, and a device with `PhysicalDevice::has_bindless`.
+    [[nodiscard( "Const computation" )]]
+    auto device_address( ) const -> vk::DeviceAddress;
+
 private:
     Device& device_;
 
@@ -14,10 +14,19 @@ namespace ltb::vlk
 class ComputePipeline
 {
 public:
-    ComputePipeline( Device& device, ShaderModule& shader_module, PipelineLayout& pipeline_layout );
+    ComputePipeline(
+        Device&         device,
+        PipelineCache&  pipeline_cache,
+        ShaderModule&   shader_module,
+        PipelineLayout& pipeline_layout
+    );
 
     auto initialize( ) -> utils::Result< void >;
 
+    /// \brief Creates a new pipeline from the current shader module and returns the old
+    ///        one, which must be kept alive until the GPU is done with it.
+    auto rebuild( ) -> utils::Result< vk::UniquePipeline >;
+
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
@@ -27,10 +36,13 @@ public:
 
 private:
     Device&         device_;
+    PipelineCache&  pipeline_cache_;
     ShaderModule&   shader_module_;
     PipelineLayout& pipeline_layout_;
 
     vk::UniquePipeline pipeline_ = { };
+
+    auto create( ) const -> utils::Result< vk::UniquePipeline >;
 };
 
 } // namespace ltb::vlk
@@ -8,8 +8,10 @@
 #include "ltb/vlk/dd/simple_mesh_2.hpp"
 #include "ltb/vlk/fwd.hpp"
 #include "ltb/vlk/objs/fwd.hpp"
+#include "ltb/vlk/objs/vulkan_bindless_table.hpp"
 #include "ltb/vlk/objs/vulkan_buffer.hpp"
 #include "ltb/vlk/objs/vulkan_graphics_pipeline.hpp"
+#include "ltb/vlk/objs/vulkan_uniform_arena.hpp"
 
 // standard
 #include <list>
@@ -18,9 +20,29 @@ namespace ltb::vlk::dd
 {
 struct LinesPipeline2Settings
 {
-    uint32                    frame_count = 0U;
-    objs::VulkanBuffer const& camera_ubo;
+    /// \brief The camera block is read from this arena at the offset passed to `draw`.
+    objs::VulkanUniformArena const& camera_uniforms;
+    vk::DeviceSize                  camera_uniforms_size = 0U;
+
+    /// \brief Draws the meshes through this table when set. Every frame then writes one
+    ///        record per mesh and each draw only selects its record, so nothing is pushed
+    ///        or bound between draws. The table must outlive the pipeline.
+    objs::VulkanBindlessTable* bindless = nullptr;
+
+    /// \brief The most meshes that can be drawn through `bindless`.
+    uint32 max_bindless_meshes = 1024U;
+};
+
+/// \brief A mesh as `lines_2d_bindless.vert` reads it from the bindless table.
+struct BindlessMeshRecord
+{
+    SimpleMeshUniforms uniforms  = { };
+    vk::DeviceAddress  positions = 0U;
+
+    // std430 rounds the record up to the 16 byte alignment of the matrix columns.
+    uint64 padding = 0U;
 };
+static_assert( sizeof( BindlessMeshRecord ) == 80U );
 
 class LinesPipeline2
 {
@@ -32,11 +54,20 @@ public:
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
-    auto
-    initialize_mesh( SimpleMesh2 const& mesh, CommandPool& command_pool, vk::Queue const& queue )
+    /// \brief Queues the mesh upload on `uploader`. The caller is responsible for
+    ///        submitting and acquiring the upload before the mesh is drawn.
+    auto initialize_mesh( SimpleMesh2 const& mesh, objs::VulkanUploader& uploader )
         -> utils::Result< SimpleMeshUniforms* >;
 
-    auto draw( objs::FrameInfo const& frame ) -> utils::Result< void >;
+    auto draw( objs::FrameInfo const& frame, uint32 camera_offset ) -> utils::Result< void >;
+
+    /// \brief Splits the meshes across `recorder`'s workers. The render pass must have been
+    ///        begun with `vk::SubpassContents::eSecondaryCommandBuffers`.
+    auto draw(
+        objs::FrameInfo const&        frame,
+        uint32                        camera_offset,
+        objs::VulkanParallelRecorder& recorder
+    ) -> utils::Result< void >;
 
 private:
     objs::VulkanGpu&          gpu_;
@@ -46,13 +77,37 @@ private:
 
     objs::VulkanGraphicsPipeline pipeline_ = { gpu_, presentation_ };
 
+    // Null unless the meshes are drawn through a bindless table.
+    objs::VulkanBindlessTable* bindless_ = nullptr;
+
+    // A region of records per frame in flight, each added to the table.
+    objs::VulkanBuffer                  mesh_records_        = { gpu_ };
+    std::vector< objs::BindlessHandle > frame_records_       = { };
+    uint32                              max_bindless_meshes_ = 0U;
+
     bool initialized_ = false;
 
     using MeshAndUniforms = MeshData< SimpleMeshUniforms >;
 
     std::list< MeshAndUniforms > mesh_data_ = { };
 
-    auto draw_mesh( MeshAndUniforms const& mesh_data, objs::FrameInfo const& frame )
+    // Random access to `mesh_data_` so ranges of meshes can be recorded in parallel.
+    std::vector< MeshAndUniforms const* > draw_list_ = { };
+
+    // The device address of each mesh's positions in bindless mode, indexed like `draw_list_`.
+    std::vector< vk::DeviceAddress > mesh_addresses_ = { };
+
+    auto initialize_vertex_pipeline( ) -> utils::Result< void >;
+    auto initialize_bindless_pipeline( LinesPipeline2Settings const& settings )
+        -> utils::Result< void >;
+
+    /// \brief Copies every mesh's uniforms into the frame's records before it is drawn.
+    auto write_mesh_records( objs::FrameInfo const& frame ) -> utils::Result< void >;
+
+    /// \brief Binds the table and selects the frame's records on `frame.command_buffer`.
+    auto bind_bindless( objs::FrameInfo const& frame ) -> utils::Result< void >;
+
+    auto draw_mesh( std::size_t mesh_index, objs::FrameInfo const& frame )
         -> utils::Result< void >;
 };
 
@@ -0,0 +1,81 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/vlk/descriptor_pool.hpp"
+#include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/vulkan.hpp"
+
+namespace ltb::vlk
+{
+
+struct DescriptorAllocatorSettings
+{
+    /// \brief The typical number of descriptors of each type in one set. Every pool has
+    ///        room for its number of sets with this mix.
+    std::vector< vk::DescriptorPoolSize > descriptors_per_set = {
+        { vk::DescriptorType::eUniformBuffer, 1U },
+        { vk::DescriptorType::eUniformBufferDynamic, 1U },
+        { vk::DescriptorType::eStorageBuffer, 2U },
+        { vk::DescriptorType::eStorageBufferDynamic, 1U },
+        { vk::DescriptorType::eCombinedImageSampler, 1U },
+        { vk::DescriptorType::eStorageImage, 1U },
+    };
+
+    /// \brief The number of sets in the first pool. Each pool added after it has room for
+    ///        twice as many, up to `max_sets_per_pool`.
+    uint32 sets_per_pool     = 16U;
+    uint32 max_sets_per_pool = 1024U;
+};
+
+/// \brief Allocates descriptor sets from a list of pools and adds a pool whenever the
+///        current one runs out. Sets are not freed one at a time. `reset` returns every
+///        set to the pools at once, so the allocator either lives as long as its sets or
+///        is reset once the GPU is done with all of them (e.g. once per frame).
+class DescriptorAllocator
+{
+public:
+    explicit( false ) DescriptorAllocator( Device& device );
+
+    /// \brief Pools are only created once sets are allocated.
+    auto initialize( DescriptorAllocatorSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    auto allocate( std::vector< vk::DescriptorSetLayout > const& layouts )
+        -> utils::Result< std::vector< vk::DescriptorSet > >;
+
+    auto allocate( vk::DescriptorSetLayout const& layout ) -> utils::Result< vk::DescriptorSet >;
+
+    /// \brief Frees every set allocated so far with `vkResetDescriptorPool` and keeps the
+    ///        pools for later sets. The GPU must be done with all of them.
+    auto reset( ) -> void;
+
+    [[nodiscard( "Const computation" )]]
+    auto pool_count( ) const -> std::size_t;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> DescriptorAllocatorSettings const&;
+
+private:
+    Device& device_;
+
+    DescriptorAllocatorSettings settings_ = { };
+
+    // Sets are allocated from the back of `ready_pools_`. Pools that ran out wait in
+    // `full_pools_` until the next reset.
+    std::vector< DescriptorPool > ready_pools_ = { };
+    std::vector< DescriptorPool > full_pools_  = { };
+
+    uint32 next_sets_per_pool_ = 0U;
+    bool   initialized_        = false;
+
+    auto add_pool( ) -> utils::Result< void >;
+};
+
+} // namespace ltb::vlk
@@ -14,27 +14,15 @@ namespace ltb::vlk
 
 struct DescriptorPoolSettings
 {
-    constexpr static auto default_descriptor_size = 1000u;
-
-    std::vector< vk::DescriptorPoolSize > pool_sizes = {
-        { vk::DescriptorType::eSampler, default_descriptor_size },
-        { vk::DescriptorType::eCombinedImageSampler, default_descriptor_size },
-        { vk::DescriptorType::eSampledImage, default_descriptor_size },
-        { vk::DescriptorType::eStorageImage, default_descriptor_size },
-        { vk::DescriptorType::eUniformTexelBuffer, default_descriptor_size },
-        { vk::DescriptorType::eStorageTexelBuffer, default_descriptor_size },
-        { vk::DescriptorType::eUniformBuffer, default_descriptor_size },
-        { vk::DescriptorType::eStorageBuffer, default_descriptor_size },
-        { vk::DescriptorType::eUniformBufferDynamic, default_descriptor_size },
-        { vk::DescriptorType::eStorageBufferDynamic, default_descriptor_size },
-        { vk::DescriptorType::eInputAttachment, default_descriptor_size },
-    };
-
-    uint32_t max_sets = default_descriptor_size * static_cast< uint32 >( pool_sizes.size( ) );
-
-    vk::DescriptorPoolCreateFlags flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
+    std::vector< vk::DescriptorPoolSize > pool_sizes = { };
+
+    uint32 max_sets = 0U;
+
+    vk::DescriptorPoolCreateFlags flags = { };
 };
 
+/// \brief A single fixed size pool. Most sets come from a `DescriptorAllocator`, which
+///        adds pools as they fill up.
 class DescriptorPool
 {
 public:
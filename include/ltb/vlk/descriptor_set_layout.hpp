@@ -14,6 +14,13 @@ namespace ltb::vlk
 struct DescriptorSetLayoutSettings
 {
     std::vector< vk::DescriptorSetLayoutBinding > bindings = { };
+
+    vk::DescriptorSetLayoutCreateFlags flags = { };
+
+    /// \brief Empty, or one entry per binding (e.g. `eUpdateAfterBind | ePartiallyBound`).
+    std::vector< vk::DescriptorBindingFlags > binding_flags = { };
+
+    auto operator==( DescriptorSetLayoutSettings const& ) const -> bool = default;
 };
 
 class DescriptorSetLayout
@@ -23,6 +30,10 @@ public:
 
     auto initialize( DescriptorSetLayoutSettings settings ) -> utils::Result< void >;
 
+    /// \brief Shares the layout `cache` holds for equal settings instead of owning one.
+    auto initialize( DescriptorSetLayoutSettings settings, ObjectCache& cache )
+        -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
@@ -30,11 +41,17 @@ public:
     auto get( ) const -> vk::DescriptorSetLayout const&;
     auto get( ) -> vk::DescriptorSetLayout&;
 
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> DescriptorSetLayoutSettings const&;
+
 private:
     Device& device_;
 
-    DescriptorSetLayoutSettings   settings_              = { };
-    vk::UniqueDescriptorSetLayout descriptor_set_layout_ = { };
+    DescriptorSetLayoutSettings settings_              = { };
+    vk::DescriptorSetLayout     descriptor_set_layout_ = { };
+
+    // Empty when the layout is shared from an `ObjectCache`.
+    vk::UniqueDescriptorSetLayout owned_layout_ = { };
 };
 
 } // namespace ltb::vlk
@@ -5,27 +5,49 @@
 
 // project
 #include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
 #include "ltb/vlk/fwd.hpp"
 #include "ltb/vlk/vulkan.hpp"
 
+// standard
+#include <span>
+
 namespace ltb::vlk
 {
 
+/// \brief One descriptor written by `DescriptorSets::update`. The member that is read
+///        depends on the type of the binding it is written to.
+union DescriptorInfo
+{
+    vk::DescriptorBufferInfo buffer = { };
+    vk::DescriptorImageInfo  image;
+    vk::BufferView           texel_buffer;
+};
+
 struct DescriptorSetsSettings
 {
     std::vector< vk::DescriptorSetLayout > layouts = { };
+
+    /// \brief The bindings every layout was created with. When set, `update` writes all
+    ///        of a set's descriptors with one `vkUpdateDescriptorSetWithTemplate`.
+    std::vector< vk::DescriptorSetLayoutBinding > bindings = { };
 };
 
 class DescriptorSets
 {
 public:
-    DescriptorSets( Device& device, DescriptorPool& descriptor_pool );
+    DescriptorSets( Device& device, DescriptorAllocator& descriptor_allocator );
 
     auto initialize( DescriptorSetsSettings settings ) -> utils::Result< void >;
 
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
+    /// \brief Writes every descriptor of the set at `set_index`. `descriptors` has one
+    ///        entry per array element of each binding, ordered by binding number.
+    auto update( uint32 set_index, std::span< DescriptorInfo const > descriptors )
+        -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto get( ) const -> std::vector< vk::DescriptorSet > const&;
     auto get( ) -> std::vector< vk::DescriptorSet >&;
@@ -36,11 +58,17 @@ public:
     auto settings( ) const -> DescriptorSetsSettings const&;
 
 private:
-    Device&         device_;
-    DescriptorPool& descriptor_pool_;
+    Device&              device_;
+    DescriptorAllocator& descriptor_allocator_;
 
     DescriptorSetsSettings           settings_        = { };
     std::vector< vk::DescriptorSet > descriptor_sets_ = { };
+
+    // Null unless the settings have bindings.
+    vk::UniqueDescriptorUpdateTemplate update_template_  = { };
+    uint32                             descriptor_count_ = 0U;
+
+    auto initialize_update_template( ) -> utils::Result< void >;
 };
 
 } // namespace ltb::vlk
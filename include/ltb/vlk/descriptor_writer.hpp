@@ -0,0 +1,56 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/types.hpp"
+#include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/vulkan.hpp"
+
+// standard
+#include <deque>
+#include <vector>
+
+namespace ltb::vlk
+{
+
+/// \brief Queues descriptor writes and applies them all with a single
+///        `vkUpdateDescriptorSets` when flushed. A set must not be written once it is
+///        bound in a command buffer that is still recording or pending, so every write to
+///        a set has to be flushed before the set is bound.
+class DescriptorWriter
+{
+public:
+    explicit( false ) DescriptorWriter( Device& device );
+
+    auto write_buffer(
+        vk::DescriptorSet               descriptor_set,
+        uint32                          binding,
+        vk::DescriptorType              type,
+        vk::DescriptorBufferInfo const& info
+    ) -> void;
+
+    auto write_image(
+        vk::DescriptorSet              descriptor_set,
+        uint32                         binding,
+        vk::DescriptorType             type,
+        vk::DescriptorImageInfo const& info
+    ) -> void;
+
+    /// \brief Applies everything queued since the last flush. Does nothing when empty.
+    auto flush( ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto empty( ) const -> bool;
+
+private:
+    Device& device_;
+
+    // Deques so the writes can keep pointing at infos queued before them.
+    std::deque< vk::DescriptorBufferInfo > buffer_infos_ = { };
+    std::deque< vk::DescriptorImageInfo >  image_infos_  = { };
+    std::vector< vk::WriteDescriptorSet >  writes_       = { };
+};
+
+} // namespace ltb::vlk
@@ -37,6 +37,14 @@ struct CheckFeatureSupport
         -> utils::Result< vk::PhysicalDevice >;
 };
 
+/// \brief Vulkan 1.3 and the core features every `Device` enables: timeline semaphores,
+///        host query resets and synchronization2.
+struct CheckCoreFeatureSupport
+{
+    auto operator( )( vk::PhysicalDevice const& physical_device ) const
+        -> utils::Result< vk::PhysicalDevice >;
+};
+
 struct CheckSurfaceSupport
 {
     vk::SurfaceKHR const& surface;
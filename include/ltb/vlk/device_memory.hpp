@@ -17,6 +17,9 @@ struct DeviceMemorySettings
 
     vk::DeviceSize allocation_size   = 0UZ;
     uint32         memory_type_index = 0U;
+
+    /// \brief `eDeviceAddress` lets buffers bound to the memory return device addresses.
+    vk::MemoryAllocateFlags allocate_flags = { };
 };
 
 struct MemoryRange
@@ -0,0 +1,154 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/vlk/device_memory.hpp"
+#include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/vulkan.hpp"
+
+// standard
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ltb::vlk
+{
+
+struct DeviceMemoryAllocatorSettings
+{
+    /// \brief The size of each pooled block of device memory. Requests larger
+    ///        than this get a dedicated block that is released when freed.
+    vk::DeviceSize block_size = 64UZ * 1024UZ * 1024UZ;
+};
+
+enum class AllocationTiling
+{
+    Linear,
+    Optimal,
+};
+
+/// \brief A sub-range of a pooled block of device memory.
+struct DeviceAllocation
+{
+    vk::DeviceMemory memory            = nullptr;
+    MemoryRange      range             = { };
+    uint32           memory_type_index = 0U;
+    uint32           tag_index         = 0U;
+
+    /// \brief Points to the start of `range` when the block is host visible.
+    uint8* mapped_data = nullptr;
+};
+
+/// \brief Device memory consumption of a single memory heap.
+struct MemoryHeapUsage
+{
+    vk::MemoryHeapFlags flags = { };
+    vk::DeviceSize      size  = 0U;
+
+    /// \brief How much this process can allocate from the heap before performance suffers.
+    ///        Reported by `VK_EXT_memory_budget` when available, otherwise the heap size.
+    vk::DeviceSize budget = 0U;
+
+    /// \brief The process wide usage of the heap. Reported by `VK_EXT_memory_budget` when
+    ///        available, otherwise the bytes allocated by this allocator.
+    vk::DeviceSize usage = 0U;
+
+    /// \brief Bytes of device memory blocks owned by this allocator.
+    vk::DeviceSize allocated = 0U;
+
+    /// \brief Bytes of those blocks currently handed out to resources.
+    vk::DeviceSize used = 0U;
+
+    /// \brief True when `budget` and `usage` came from the driver.
+    bool from_driver = false;
+};
+
+/// \brief Live allocations that were made with the same tag.
+struct MemoryTagUsage
+{
+    std::string    tag              = { };
+    vk::DeviceSize used             = 0U;
+    uint32         allocation_count = 0U;
+};
+
+class DeviceMemoryAllocator
+{
+public:
+    explicit( false ) DeviceMemoryAllocator( Device& device );
+
+    auto initialize( DeviceMemoryAllocatorSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    auto reset( ) -> void;
+
+    auto allocate(
+        vk::MemoryRequirements const& memory_requirements,
+        vk::MemoryPropertyFlags       memory_properties,
+        AllocationTiling              tiling,
+        std::string_view              tag
+    ) -> utils::Result< DeviceAllocation >;
+
+    auto free( DeviceAllocation const& allocation ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> DeviceMemoryAllocatorSettings const&;
+
+    /// \brief Queries the current usage and budget of every memory heap.
+    [[nodiscard( "Const computation" )]]
+    auto heap_usage( ) const -> std::vector< MemoryHeapUsage >;
+
+    /// \brief Usage per allocation tag. Tags stay listed after their last allocation is freed.
+    [[nodiscard( "Const getter" )]]
+    auto tag_usage( ) const -> std::vector< MemoryTagUsage > const&;
+
+private:
+    struct MemoryBlock
+    {
+        explicit MemoryBlock( Device& device );
+
+        DeviceMemory   memory;
+        vk::DeviceSize size      = 0U;
+        bool           dedicated = false;
+        uint8*         mapped    = nullptr;
+
+        /// \brief Free ranges keyed by offset. Adjacent ranges are always merged.
+        std::map< vk::DeviceSize, vk::DeviceSize > free_ranges = { };
+    };
+
+    Device& device_;
+
+    DeviceMemoryAllocatorSettings settings_ = { };
+
+    vk::PhysicalDeviceMemoryProperties memory_properties_      = { };
+    vk::DeviceSize                     image_granularity_      = 1U;
+    vk::DeviceSize                     non_coherent_atom_size_ = 1U;
+    bool                               has_budget_ext_         = false;
+
+    std::unordered_map< uint32, std::list< MemoryBlock > > blocks_ = { };
+
+    // Internal accounting indexed by memory heap.
+    std::vector< vk::DeviceSize > heap_allocated_ = { };
+    std::vector< vk::DeviceSize > heap_used_      = { };
+
+    std::vector< MemoryTagUsage >                  tags_        = { };
+    std::map< std::string, uint32, std::less< > > tag_indices_ = { };
+
+    bool initialized_ = false;
+
+    auto allocate_block( uint32 memory_type_index, vk::DeviceSize size, bool dedicated )
+        -> utils::Result< MemoryBlock* >;
+    auto find_or_add_tag( std::string_view tag ) -> uint32;
+    auto heap_index( uint32 memory_type_index ) const -> uint32;
+};
+
+} // namespace ltb::vlk
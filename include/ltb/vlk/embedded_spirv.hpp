@@ -0,0 +1,40 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/types.hpp"
+#include "ltb/vlk/shader_module.hpp"
+
+// standard
+#include <span>
+#include <string_view>
+
+namespace ltb::vlk
+{
+
+/// \brief SPIR-V compiled into the library when it is built with LTB_VLK_EMBED_SPIRV.
+struct EmbeddedSpirv
+{
+    /// \brief The SPIR-V file's path relative to the shader directory, e.g.
+    ///        "particles2.comp.spv" or "lessons/lesson1.comp.spv".
+    std::string_view          name = { };
+    std::span< uint32 const > code = { };
+};
+
+/// \brief Every embedded shader. Empty unless built with LTB_VLK_EMBED_SPIRV.
+[[nodiscard( "Const getter" )]]
+auto embedded_spirv( ) -> std::span< EmbeddedSpirv const >;
+
+/// \brief The embedded code of `name`, or an empty span if it was not embedded.
+[[nodiscard( "Const computation" )]]
+auto find_embedded_spirv( std::string_view name ) -> std::span< uint32 const >;
+
+/// \brief Settings that use the embedded code of `spirv_name` when it exists and
+///        otherwise load it from `config::shader_dir_path( )`.
+[[nodiscard( "Const computation" )]]
+auto shader_module_settings( std::string_view spirv_name, vk::ShaderStageFlagBits stage )
+    -> ShaderModuleSettings;
+
+} // namespace ltb::vlk
@@ -10,16 +10,21 @@ class Buffer;
 class CommandBuffer;
 class CommandPool;
 class ComputePipeline;
+class DescriptorAllocator;
 class DescriptorPool;
 class DescriptorSets;
 class DescriptorSetLayout;
+class DescriptorWriter;
 class Device;
 class Fence;
 class GraphicsPipeline;
 class ImageView;
 class Instance;
+class ObjectCache;
+class PipelineCache;
 class PipelineLayout;
 class PhysicalDevice;
+class QueryPool;
 class RenderPass;
 class Semaphore;
 class ShaderModule;
@@ -64,6 +64,7 @@ class GraphicsPipeline
 public:
     GraphicsPipeline(
         Device&                      device,
+        PipelineCache&               pipeline_cache,
         RenderPass&                  render_pass,
         std::vector< ShaderModule >& shader_modules,
         PipelineLayout&              pipeline_layout
@@ -71,6 +72,10 @@ public:
 
     auto initialize( GraphicsPipelineSettings settings ) -> utils::Result< void >;
 
+    /// \brief Creates a new pipeline from the current shader modules and settings and
+    ///        returns the old one, which must be kept alive until the GPU is done with it.
+    auto rebuild( ) -> utils::Result< vk::UniquePipeline >;
+
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
@@ -85,12 +90,16 @@ public:
 
 private:
     Device&                      device_;
+    PipelineCache&               pipeline_cache_;
     RenderPass&                  render_pass_;
     std::vector< ShaderModule >& shader_modules_;
     PipelineLayout&              pipeline_layout_;
 
     GraphicsPipelineSettings settings_ = { };
     vk::UniquePipeline       pipeline_ = { };
+
+    auto create( GraphicsPipelineSettings const& settings ) const
+        -> utils::Result< vk::UniquePipeline >;
 };
 
 } // namespace ltb::vlk
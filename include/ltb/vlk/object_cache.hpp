@@ -0,0 +1,71 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/vlk/descriptor_set_layout.hpp"
+#include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/pipeline_layout.hpp"
+#include "ltb/vlk/vulkan.hpp"
+
+// standard
+#include <mutex>
+#include <unordered_map>
+
+namespace ltb::vlk
+{
+
+struct ObjectCacheHash
+{
+    auto operator( )( DescriptorSetLayoutSettings const& settings ) const -> std::size_t;
+    auto operator( )( PipelineLayoutSettings const& settings ) const -> std::size_t;
+    auto operator( )( vk::SamplerCreateInfo const& create_info ) const -> std::size_t;
+};
+
+/// \brief Creates each descriptor set layout, pipeline layout and sampler once and hands
+///        out the same handle for every equal create info. Pipelines that share a layout
+///        can then share bound descriptor sets. The objects live as long as the cache.
+///        Safe to use from several threads.
+class ObjectCache
+{
+public:
+    explicit( false ) ObjectCache( Device& device );
+
+    auto initialize( ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Bindings with immutable samplers are not supported.
+    auto descriptor_set_layout( DescriptorSetLayoutSettings const& settings )
+        -> utils::Result< vk::DescriptorSetLayout >;
+
+    auto pipeline_layout( PipelineLayoutSettings const& settings )
+        -> utils::Result< vk::PipelineLayout >;
+
+    /// \brief `create_info` must not have a `pNext` chain.
+    auto sampler( vk::SamplerCreateInfo const& create_info ) -> utils::Result< vk::Sampler >;
+
+    /// \brief The number of distinct objects created so far.
+    [[nodiscard( "Const computation" )]]
+    auto object_count( ) const -> std::size_t;
+
+private:
+    Device& device_;
+
+    template < typename Key, typename Object >
+    using CacheMap = std::unordered_map< Key, Object, ObjectCacheHash >;
+
+    mutable std::mutex mutex_ = { };
+
+    CacheMap< DescriptorSetLayoutSettings, vk::UniqueDescriptorSetLayout > descriptor_set_layouts_
+        = { };
+    CacheMap< PipelineLayoutSettings, vk::UniquePipelineLayout > pipeline_layouts_ = { };
+    CacheMap< vk::SamplerCreateInfo, vk::UniqueSampler >         samplers_         = { };
+
+    bool initialized_ = false;
+};
+
+} // namespace ltb::vlk
@@ -0,0 +1,68 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/types.hpp"
+#include "ltb/vlk/objs/fwd.hpp"
+#include "ltb/vlk/vulkan.hpp"
+
+// standard
+#include <span>
+#include <vector>
+
+namespace ltb::vlk::objs
+{
+
+struct BoundDescriptorSets
+{
+    vk::PipelineLayout               pipeline_layout = nullptr;
+    std::vector< vk::DescriptorSet > descriptor_sets = { };
+    std::vector< uint32 >            dynamic_offsets = { };
+};
+
+/// \brief The descriptor sets last bound to a command buffer at set 0 of each bind point.
+///        Pipeline layouts come from `VulkanGpu::object_cache`, so pipelines with equal
+///        layouts have the same handle and can keep using the sets bound for another.
+class DescriptorBindState
+{
+public:
+    /// \brief Forgets every binding. Called when `command_buffer` starts recording and
+    ///        after anything that leaves its bindings undefined, like executing secondary
+    ///        command buffers or binding descriptor sets without `bind_descriptor_sets`.
+    auto reset( vk::CommandBuffer command_buffer ) -> void;
+
+    /// \brief False if the sets are already bound. Otherwise records them as bound.
+    auto update(
+        vk::PipelineBindPoint                bind_point,
+        vk::PipelineLayout                   pipeline_layout,
+        std::span< vk::DescriptorSet const > descriptor_sets,
+        std::vector< uint32 > const&         dynamic_offsets
+    ) -> bool;
+
+    [[nodiscard( "Const getter" )]]
+    auto command_buffer( ) const -> vk::CommandBuffer;
+
+private:
+    vk::CommandBuffer command_buffer_ = nullptr;
+
+    BoundDescriptorSets graphics_ = { };
+    BoundDescriptorSets compute_  = { };
+
+    /// \brief Null for bind points that are not tracked.
+    auto bound_at( vk::PipelineBindPoint bind_point ) -> BoundDescriptorSets*;
+};
+
+/// \brief Binds `descriptor_sets` from set 0 unless the frame's `descriptor_bind_state`
+///        shows they are already bound with the same layout and dynamic offsets. Writes
+///        queued on the frame's `descriptor_writer` are flushed first.
+auto bind_descriptor_sets(
+    FrameInfo const&                     frame,
+    vk::PipelineBindPoint                bind_point,
+    vk::PipelineLayout                   pipeline_layout,
+    std::span< vk::DescriptorSet const > descriptor_sets,
+    std::vector< uint32 > const&         dynamic_offsets
+) -> void;
+
+} // namespace ltb::vlk::objs
@@ -5,6 +5,8 @@
 
 // project
 #include "ltb/utils/types.hpp"
+#include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/objs/fwd.hpp"
 #include "ltb/vlk/vulkan.hpp"
 
 // standard
@@ -21,6 +23,28 @@ struct FrameInfo
 
     vk::Semaphore image_semaphore = nullptr;
     uint32        image_index     = std::numeric_limits< uint32 >::max( );
+
+    /// \brief Set instead of `frame_fence` when frames are synchronized with a timeline
+    ///        semaphore. The frame's submission signals `timeline_value` on it.
+    vk::Semaphore timeline_semaphore = nullptr;
+    uint64        timeline_value     = 0U;
+
+    /// \brief Set when the frame's commands can be measured with GPU timestamps
+    ///        (see `begin_gpu_scope` and `end_gpu_scope`).
+    VulkanGpuProfiler* profiler = nullptr;
+
+    /// \brief Set when the descriptor sets bound to `command_buffer` are tracked, so
+    ///        pipelines that share a layout skip binding the same sets again.
+    DescriptorBindState* descriptor_bind_state = nullptr;
+
+    /// \brief Set when the frame has descriptor sets of its own. They are freed all at
+    ///        once when the frame starts again, after its previous commands complete.
+    DescriptorAllocator* descriptor_allocator = nullptr;
+
+    /// \brief Set when descriptor writes can be queued for the frame. They are applied
+    ///        with one `vkUpdateDescriptorSets` right before the frame first binds
+    ///        descriptor sets with `bind_descriptor_sets`.
+    DescriptorWriter* descriptor_writer = nullptr;
 };
 
 } // namespace ltb::vlk::objs
@@ -8,12 +8,26 @@ namespace ltb::vlk::objs
 
 struct FrameInfo;
 
+class DescriptorBindState;
+class VulkanBindlessTable;
 class VulkanBuffer;
 class VulkanCommandAndSync;
 class VulkanComputePipeline;
 class VulkanGpu;
+class VulkanGpuProfiler;
+template < typename T >
+class VulkanGpuVector;
 class VulkanGraphicsPipeline;
+class VulkanGrowableBuffer;
 class VulkanImage;
+class VulkanParallelRecorder;
+class VulkanPipelineCompiler;
 class VulkanPresentation;
+class VulkanReadback;
+class VulkanShaderReloader;
+class VulkanSubmitBatch;
+class VulkanUniformArena;
+class VulkanUploader;
+class VulkanWorkgroupTuner;
 
 } // namespace ltb::vlk::objs
@@ -0,0 +1,107 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/descriptor_pool.hpp"
+#include "ltb/vlk/descriptor_set_layout.hpp"
+#include "ltb/vlk/objs/fwd.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+
+namespace ltb::vlk::objs
+{
+
+/// \brief Shaders declare the table's arrays at these bindings of its set.
+constexpr auto bindless_storage_buffer_binding = 0U;
+constexpr auto bindless_storage_image_binding  = 1U;
+
+/// \brief The index of a descriptor in one of the table's arrays.
+using BindlessHandle = uint32;
+
+struct VulkanBindlessTableSettings
+{
+    /// \brief The length of each array. Devices that support the `bindless_features`
+    ///        allow at least 500000 of each.
+    uint32 max_storage_buffers = 1U << 16U;
+    uint32 max_storage_images  = 1U << 14U;
+
+    vk::ShaderStageFlags stages
+        = vk::ShaderStageFlagBits::eAllGraphics | vk::ShaderStageFlagBits::eCompute;
+};
+
+/// \brief One descriptor set holding a large update-after-bind array of storage buffers
+///        and one of storage images. Resources are added once and referenced by handle,
+///        so draws only pass integers instead of binding sets or vertex buffers. Needs a
+///        device with `PhysicalDevice::has_bindless`.
+class VulkanBindlessTable
+{
+public:
+    explicit( false ) VulkanBindlessTable( VulkanGpu& gpu );
+
+    auto initialize( VulkanBindlessTableSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Writes `info` to a free slot of the storage buffer array. Free slots are not
+    ///        read by any command, so they can be written while command buffers that bound
+    ///        the table are still recording or executing.
+    auto add_storage_buffer( vk::DescriptorBufferInfo const& info )
+        -> utils::Result< BindlessHandle >;
+
+    auto add_storage_image( vk::DescriptorImageInfo const& info )
+        -> utils::Result< BindlessHandle >;
+
+    /// \brief Lets a later `add_storage_buffer` reuse `handle`. The GPU must be done with
+    ///        every command that reads it. Fails for handles that are not in use.
+    auto remove_storage_buffer( BindlessHandle handle ) -> utils::Result< void >;
+    auto remove_storage_image( BindlessHandle handle ) -> utils::Result< void >;
+
+    /// \brief Binds the table at `set`, which must follow any sets bound from set 0 in
+    ///        the same pipeline layout (see `VulkanGraphicsPipelineSettings`).
+    auto bind(
+        FrameInfo const&      frame,
+        vk::PipelineBindPoint bind_point,
+        vk::PipelineLayout    pipeline_layout,
+        uint32                set
+    ) const -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto layout( ) const -> vk::DescriptorSetLayout;
+
+    /// \brief The bindings of `layout`, which shaders declaring the table must match.
+    [[nodiscard( "Const getter" )]]
+    auto bindings( ) const -> std::vector< vk::DescriptorSetLayoutBinding > const&;
+
+    [[nodiscard( "Const getter" )]]
+    auto descriptor_set( ) const -> vk::DescriptorSet;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> VulkanBindlessTableSettings const&;
+
+private:
+    struct Slots
+    {
+        uint32                        next = 0U;
+        std::vector< BindlessHandle > free = { };
+    };
+
+    VulkanGpu& gpu_;
+
+    VulkanBindlessTableSettings settings_ = { };
+
+    DescriptorSetLayout layout_         = { gpu_.device( ) };
+    DescriptorPool      pool_           = { gpu_.device( ) };
+    vk::DescriptorSet   descriptor_set_ = nullptr;
+
+    Slots storage_buffers_ = { };
+    Slots storage_images_  = { };
+
+    bool initialized_ = false;
+
+    auto acquire( Slots& slots, uint32 capacity ) -> utils::Result< BindlessHandle >;
+    auto release( Slots& slots, BindlessHandle handle ) -> utils::Result< void >;
+};
+
+} // namespace ltb::vlk::objs
@@ -6,6 +6,7 @@
 // project
 #include "ltb/vlk/buffer.hpp"
 #include "ltb/vlk/device_memory.hpp"
+#include "ltb/vlk/device_memory_allocator.hpp"
 #include "ltb/vlk/objs/vulkan_gpu.hpp"
 
 namespace ltb::vlk::objs
@@ -22,12 +23,16 @@ struct VulkanBufferSettings
     vk::MemoryPropertyFlags memory_properties = { };
 
     bool store_mapped_value = false;
+
+    /// \brief Groups this buffer's memory in the allocator's usage telemetry.
+    std::string tag = { };
 };
 
 class VulkanBuffer
 {
 public:
     explicit( false ) VulkanBuffer( VulkanGpu& gpu );
+    ~VulkanBuffer( );
 
     auto initialize( VulkanBufferSettings settings ) -> utils::Result< void >;
 
@@ -45,8 +50,7 @@ public:
     auto buffer( ) -> Buffer&;
 
     [[nodiscard( "Const getter" )]]
-    auto memory( ) const -> DeviceMemory const&;
-    auto memory( ) -> DeviceMemory&;
+    auto allocation( ) const -> DeviceAllocation const&;
 
     [[nodiscard( "Const getter" )]]
     auto mapped_data( ) const -> uint8*;
@@ -54,10 +58,10 @@ public:
 private:
     VulkanGpu& gpu_;
 
-    MemoryLayout layout_      = { };
-    Buffer       buffer_      = { gpu_.device( ) };
-    DeviceMemory memory_      = { gpu_.device( ) };
-    uint8*       mapped_data_ = nullptr;
+    MemoryLayout     layout_      = { };
+    Buffer           buffer_      = { gpu_.device( ) };
+    DeviceAllocation allocation_  = { };
+    uint8*           mapped_data_ = nullptr;
 
     bool initialized_ = false;
 };
@@ -6,6 +6,7 @@
 // project
 #include "ltb/vlk/buffer.hpp"
 #include "ltb/vlk/device_memory.hpp"
+#include "ltb/vlk/device_memory_allocator.hpp"
 #include "ltb/vlk/objs/vulkan_gpu.hpp"
 
 namespace ltb::vlk::objs
@@ -15,12 +16,16 @@ struct VulkanBuffersSettings
 {
     std::vector< BufferSettings > buffers           = { };
     vk::MemoryPropertyFlags       memory_properties = { };
+
+    /// \brief Groups the buffers' memory in the allocator's usage telemetry.
+    std::string tag = { };
 };
 
 class VulkanBuffers
 {
 public:
     explicit( false ) VulkanBuffers( VulkanGpu& gpu );
+    ~VulkanBuffers( );
 
     auto initialize( VulkanBuffersSettings const& settings ) -> utils::Result< void >;
 
@@ -37,15 +42,14 @@ public:
     auto buffers( ) const -> std::vector< Buffer > const&;
 
     [[nodiscard( "Const getter" )]]
-    auto memory( ) const -> DeviceMemory const&;
-    auto memory( ) -> DeviceMemory&;
+    auto allocation( ) const -> DeviceAllocation const&;
 
 private:
     VulkanGpu& gpu_;
 
-    std::vector< Buffer > buffers_ = { };
-    MemoryLayout          layout_  = { };
-    DeviceMemory          memory_  = { gpu_.device( ) };
+    std::vector< Buffer > buffers_    = { };
+    MemoryLayout          layout_     = { };
+    DeviceAllocation      allocation_ = { };
 
     bool initialized_ = false;
 };
@@ -6,21 +6,46 @@
 // project
 #include "ltb/vlk/command_buffer.hpp"
 #include "ltb/vlk/command_pool.hpp"
+#include "ltb/vlk/descriptor_allocator.hpp"
+#include "ltb/vlk/descriptor_writer.hpp"
 #include "ltb/vlk/fence.hpp"
 #include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/objs/descriptor_bind_state.hpp"
 #include "ltb/vlk/objs/frame_info.hpp"
 #include "ltb/vlk/objs/vulkan_gpu.hpp"
+#include "ltb/vlk/objs/vulkan_gpu_profiler.hpp"
+#include "ltb/vlk/objs/vulkan_submit_batch.hpp"
 #include "ltb/vlk/semaphore.hpp"
 
 namespace ltb::vlk::objs
 {
 
+enum class FrameSync
+{
+    /// \brief Every frame has a binary fence that is waited on and reset before reuse.
+    Fences,
+    /// \brief Every submission signals the next value of one timeline semaphore.
+    TimelineSemaphore,
+};
+
 struct VulkanCommandAndSyncSettings
 {
     uint32 frame_count = 0U;
     uint32 image_count = 0U;
 
     CommandPoolSettings command_pool = { };
+
+    FrameSync frame_sync = FrameSync::Fences;
+
+    /// \brief Enables a GPU timestamp profiler with room for this many scopes per frame.
+    ///        Every `FrameInfo` then points to it.
+    uint32 profiler_scopes_per_frame = 0U;
+
+    /// \brief The pipeline statistics the profiler's scopes can collect.
+    vk::QueryPipelineStatisticFlags profiler_statistics = { };
+
+    /// \brief Sizes the pools of each frame's `FrameInfo::descriptor_allocator`.
+    DescriptorAllocatorSettings frame_descriptors = { };
 };
 
 enum class ResetCommandBuffer
@@ -40,6 +65,9 @@ struct SemaphoreAndStage
 {
     vk::Semaphore          semaphore = nullptr;
     vk::PipelineStageFlags stage     = vk::PipelineStageFlagBits::eNone;
+
+    /// \brief The value to wait for when `semaphore` is a timeline semaphore.
+    uint64 value = 0U;
 };
 
 class VulkanCommandAndSync
@@ -67,6 +95,14 @@ public:
     auto end_frame( FrameInfo const& frame, vk::Queue const& submit_queue )
         -> utils::Result< void >;
 
+    /// \brief Same as above but the submission also waits on `additional_waits`,
+    ///        e.g. the upload semaphores returned by `VulkanUploader::acquire`.
+    auto end_frame(
+        FrameInfo const&                        frame,
+        std::vector< SemaphoreAndStage > const& additional_waits,
+        vk::Queue const&                        submit_queue
+    ) -> utils::Result< void >;
+
     auto end_frame(
         FrameInfo const&                        frame,
         std::vector< SemaphoreAndStage > const& wait_until_signaled,
@@ -74,6 +110,16 @@ public:
         vk::Queue const&                        submit_queue
     ) -> utils::Result< void >;
 
+    /// \brief Queues the frame's submission on `batch` instead of submitting it. Waiting
+    ///        for a frame that is still queued flushes `batch` first, so it must outlive
+    ///        this object's use of it.
+    auto end_frame(
+        FrameInfo const&                        frame,
+        std::vector< SemaphoreAndStage > const& wait_until_signaled,
+        std::vector< vk::Semaphore > const&     signal_when_finished,
+        VulkanSubmitBatch&                      batch
+    ) -> utils::Result< void >;
+
     auto present_frame(
         FrameInfo const& frame,
         Swapchain const& swapchain,
@@ -82,11 +128,42 @@ public:
 
     auto increment_frame( ) -> void;
 
+    /// \brief Limits how many frames may be in flight, from one up to `frame_count`.
+    ///        Starting a frame then also waits for the frame submitted `frames_in_flight`
+    ///        frames earlier. Takes effect on the next `start_frame`.
+    auto set_frames_in_flight( uint32 frames_in_flight ) -> void;
+
+    [[nodiscard( "Const getter" )]]
+    auto frames_in_flight( ) const -> uint32;
+
+    [[nodiscard( "Const getter" )]]
+    auto frame_sync( ) const -> FrameSync;
+
+    /// \brief The semaphore every submission signals in `FrameSync::TimelineSemaphore` mode.
+    [[nodiscard( "Const getter" )]]
+    auto timeline_semaphore( ) const -> vk::Semaphore;
+
+    /// \brief The timeline value signaled by the most recent submission (0 before any).
+    [[nodiscard( "Const getter" )]]
+    auto last_submitted_value( ) const -> uint64;
+
+    /// \brief The timeline value of the most recent submission that has completed.
+    [[nodiscard( "Const computation" )]]
+    auto completed_value( ) const -> utils::Result< uint64 >;
+
+    /// \brief Blocks until the submission that signals `value` has completed.
+    auto wait_for_value( uint64 value ) const -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]] auto frame_index( ) const -> uint32;
     [[nodiscard( "Const getter" )]] auto previous_frame( ) const -> uint32;
     [[nodiscard( "Const getter" )]] auto compute_previous_frame( uint32 index ) const -> uint32;
     [[nodiscard( "Const getter" )]] auto compute_next_frame( uint32 index ) const -> uint32;
 
+    /// \brief Only initialized when `profiler_scopes_per_frame` is set.
+    [[nodiscard( "Const getter" )]]
+    auto profiler( ) const -> VulkanGpuProfiler const&;
+    auto profiler( ) -> VulkanGpuProfiler&;
+
     [[nodiscard( "Const getter" )]]
     auto command_pool( ) const -> CommandPool const&;
     auto command_pool( ) -> CommandPool&;
@@ -116,11 +193,43 @@ private:
     std::vector< Fence >         frame_fences_     = { };
     std::vector< Semaphore >     frame_semaphores_ = { };
 
-    uint32 frame_index_ = 0U;
+    uint32 frame_index_      = 0U;
+    uint32 frames_in_flight_ = 0U;
 
     std::vector< Semaphore > image_semaphores_ = { };
 
+    // Timeline mode. `frame_values_` holds the value each frame last signaled.
+    FrameSync             frame_sync_           = FrameSync::Fences;
+    Semaphore             timeline_             = { gpu_.device( ) };
+    std::vector< uint64 > frame_values_         = { };
+    uint64                last_submitted_value_ = 0U;
+
+    // The batch the latest submission was queued on, if any.
+    VulkanSubmitBatch* batch_ = nullptr;
+
+    VulkanGpuProfiler profiler_ = { gpu_ };
+
+    // The descriptor sets bound to each frame's command buffer while it is recorded.
+    std::vector< DescriptorBindState > descriptor_bind_states_ = { };
+
+    // The transient descriptor sets of each frame.
+    std::vector< DescriptorAllocator > frame_descriptors_ = { };
+
+    // The descriptor writes each frame queues until its first bind.
+    std::vector< DescriptorWriter > descriptor_writers_ = { };
+
     bool initialized_ = false;
+
+    auto wait_for_frame( ) -> utils::Result< void >;
+    auto begin_frame( ResetCommandBuffer reset_command_buffer ) -> utils::Result< void >;
+    auto next_timeline_value( ) const -> uint64;
+    auto frame_profiler( ) -> VulkanGpuProfiler*;
+    auto make_submit(
+        FrameInfo const&                        frame,
+        std::vector< SemaphoreAndStage > const& wait_until_signaled,
+        std::vector< vk::Semaphore > const&     signal_when_finished
+    ) const -> utils::Result< PendingSubmit >;
+    auto record_submitted( FrameInfo const& frame ) -> void;
 };
 
 } // namespace ltb::vlk::objs
@@ -12,18 +12,37 @@
 #include "ltb/vlk/objs/vulkan_gpu.hpp"
 #include "ltb/vlk/pipeline_layout.hpp"
 #include "ltb/vlk/shader_module.hpp"
+#include "ltb/vlk/shader_reflection.hpp"
+
+// external
+#include <glm/vec3.hpp>
 
 namespace ltb::vlk::objs
 {
 
+/// \brief The specialization constant ids a shader declares its workgroup size with:
+///        `layout (local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;`
+constexpr auto workgroup_size_constant_ids = glm::uvec3{ 0U, 1U, 2U };
+
 struct VulkanComputePipelineSettings
 {
+    /// \brief Its specialization constants must not use `workgroup_size_constant_ids`.
     ShaderModuleSettings shader_module = { };
 
+    /// \brief Specialized into the shader. Shaders that hard-code their size ignore it, so
+    ///        `dispatch` is only correct for shaders that declare the constant ids.
+    glm::uvec3 workgroup_size = { 64U, 1U, 1U };
+
     uint32 descriptor_set_count = 0U;
 
-    std::vector< vk::DescriptorSetLayoutBinding > uniform_bindings       = { };
-    std::vector< vk::PushConstantRange >          uniform_push_constants = { };
+    /// \brief Reflected from the shader when empty. Only set 0 is supported.
+    std::vector< vk::DescriptorSetLayoutBinding > uniform_bindings = { };
+
+    /// \brief Reflected from the shader when empty.
+    std::vector< vk::PushConstantRange > uniform_push_constants = { };
+
+    /// \brief Reflected uniform and storage buffers at these slots are made dynamic.
+    std::vector< DescriptorSlot > dynamic_buffers = { };
 };
 
 class VulkanComputePipeline
@@ -33,13 +52,50 @@ public:
 
     auto initialize( VulkanComputePipelineSettings settings ) -> utils::Result< void >;
 
+    /// \brief The first half of `initialize`. Creates everything but the pipeline.
+    auto initialize_layouts( VulkanComputePipelineSettings settings ) -> utils::Result< void >;
+
+    /// \brief The second half of `initialize`. Different pipelines can compile on
+    ///        different threads at the same time.
+    auto compile( ) -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
+    /// \brief Reloads the SPIR-V files and rebuilds the pipeline with the same layout. The
+    ///        old pipeline is returned so it can be destroyed once the GPU is done with it.
+    auto reload_shaders( ) -> utils::Result< vk::UniquePipeline >;
+
+    /// \brief Rebuilds the pipeline with a new workgroup size. The old pipeline is returned
+    ///        so it can be destroyed once the GPU is done with it.
+    auto set_workgroup_size( glm::uvec3 workgroup_size ) -> utils::Result< vk::UniquePipeline >;
+
+    /// \brief Replaces the descriptor sets with `descriptor_set_count` new sets of the same
+    ///        layout. The old sets stay allocated until the GPU's descriptor allocator is
+    ///        reset, and the GPU must be done with them.
+    auto reallocate_descriptor_sets( uint32 descriptor_set_count ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto workgroup_size( ) const -> glm::uvec3;
+
+    /// \brief Dispatches enough workgroups to cover `invocation_count`. The shader has to
+    ///        skip the invocations beyond it in the last workgroup of each dimension.
+    auto dispatch( vk::CommandBuffer const& command_buffer, glm::uvec3 invocation_count ) const
+        -> void;
+
     auto bind( vk::CommandBuffer const& command_buffer ) -> void;
 
     auto bind_descriptor_sets( FrameInfo const& frame ) -> utils::Result< void >;
 
+    /// \brief `dynamic_offsets` are applied in binding order to every dynamic
+    ///        uniform or storage buffer in the bound descriptor sets.
+    ///        Skipped if another pipeline with the same layout already bound the same
+    ///        sets and offsets to the frame's command buffer.
+    auto bind_descriptor_sets(
+        FrameInfo const&             frame,
+        std::vector< uint32 > const& dynamic_offsets
+    ) -> utils::Result< void >;
+
     [[nodiscard( "Cosnt getter" )]]
     auto shader_module( ) const -> ShaderModule const&;
     auto shader_module( ) -> ShaderModule&;
@@ -66,17 +122,30 @@ private:
     ShaderModule shader_module_ = { gpu_.device( ) };
 
     DescriptorSetLayout descriptor_set_layout_ = { gpu_.device( ) };
-    DescriptorSets      descriptor_sets_       = { gpu_.device( ), gpu_.descriptor_pool( ) };
+    DescriptorSets      descriptor_sets_       = { gpu_.device( ), gpu_.descriptor_allocator( ) };
 
     PipelineLayout pipeline_layout_ = { gpu_.device( ) };
 
     ComputePipeline pipeline_ = {
         gpu_.device( ),
+        gpu_.pipeline_cache( ),
         shader_module_,
         pipeline_layout_,
     };
 
+    glm::uvec3 workgroup_size_ = { };
+
     bool initialized_ = false;
+
+    auto specialize( std::vector< SpecializationConstant > constants, glm::uvec3 workgroup_size )
+        -> utils::Result< void >;
+
+    /// \brief Fills the bindings and push constants left empty from the shader's reflection.
+    auto reflect_layout( VulkanComputePipelineSettings& settings ) const -> utils::Result< void >;
 };
 
+/// \brief The number of workgroups of `workgroup_size` needed to cover `invocation_count`.
+[[nodiscard( "Const computation" )]]
+auto workgroup_count( glm::uvec3 invocation_count, glm::uvec3 workgroup_size ) -> glm::uvec3;
+
 } // namespace ltb::vlk::objs
@@ -5,10 +5,13 @@
 
 // project
 #include "ltb/vlk/command_buffer.hpp"
-#include "ltb/vlk/descriptor_pool.hpp"
+#include "ltb/vlk/descriptor_allocator.hpp"
 #include "ltb/vlk/device.hpp"
+#include "ltb/vlk/device_memory_allocator.hpp"
 #include "ltb/vlk/instance.hpp"
+#include "ltb/vlk/object_cache.hpp"
 #include "ltb/vlk/physical_device.hpp"
+#include "ltb/vlk/pipeline_cache.hpp"
 #include "ltb/vlk/surface.hpp"
 #include "ltb/window/fwd.hpp"
 
@@ -17,9 +20,11 @@ namespace ltb::vlk::objs
 
 struct VulkanGpuSettings
 {
-    InstanceSettings       instance        = { };
-    DeviceSettings         device          = { };
-    DescriptorPoolSettings descriptor_pool = { };
+    InstanceSettings              instance             = { };
+    DeviceSettings                device               = { };
+    DeviceMemoryAllocatorSettings memory_allocator     = { };
+    DescriptorAllocatorSettings   descriptor_allocator = { };
+    PipelineCacheSettings         pipeline_cache       = { };
 };
 
 class VulkanGpu
@@ -49,8 +54,32 @@ public:
     auto device( ) -> Device&;
 
     [[nodiscard( "Const getter" )]]
-    auto descriptor_pool( ) const -> DescriptorPool const&;
-    auto descriptor_pool( ) -> DescriptorPool&;
+    auto memory_allocator( ) const -> DeviceMemoryAllocator const&;
+    auto memory_allocator( ) -> DeviceMemoryAllocator&;
+
+    /// \brief Live usage and budget of every device memory heap.
+    [[nodiscard( "Const computation" )]]
+    auto memory_heap_usage( ) const -> std::vector< MemoryHeapUsage >;
+
+    /// \brief Device memory used by each `VulkanBuffer`/`VulkanImage` tag.
+    [[nodiscard( "Const getter" )]]
+    auto memory_tag_usage( ) const -> std::vector< MemoryTagUsage > const&;
+
+    /// \brief For sets that live as long as the objects using them. Sets that are only used
+    ///        by one frame come from `FrameInfo::descriptor_allocator` instead.
+    [[nodiscard( "Const getter" )]]
+    auto descriptor_allocator( ) const -> DescriptorAllocator const&;
+    auto descriptor_allocator( ) -> DescriptorAllocator&;
+
+    /// \brief Shared by every pipeline. Apps save it when they clean up.
+    [[nodiscard( "Const getter" )]]
+    auto pipeline_cache( ) const -> PipelineCache const&;
+    auto pipeline_cache( ) -> PipelineCache&;
+
+    /// \brief Shares layouts and samplers between everything created with equal settings.
+    [[nodiscard( "Const getter" )]]
+    auto object_cache( ) const -> ObjectCache const&;
+    auto object_cache( ) -> ObjectCache&;
 
 private:
     window::GlfwContext& glfw_context_;
@@ -61,7 +90,11 @@ private:
     PhysicalDevice physical_device_ = { instance_ };
     Device         device_          = { physical_device_ };
 
-    DescriptorPool descriptor_pool_ = { device_ };
+    DeviceMemoryAllocator memory_allocator_ = { device_ };
+
+    DescriptorAllocator descriptor_allocator_ = { device_ };
+    PipelineCache       pipeline_cache_       = { device_ };
+    ObjectCache         object_cache_         = { device_ };
 
     bool initialized_ = false;
 };
@@ -0,0 +1,197 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/objs/frame_info.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+#include "ltb/vlk/query_pool.hpp"
+#include "ltb/vlk/queue_types.hpp"
+
+// standard
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanGpuProfilerSettings
+{
+    /// \brief The number of frames that can be in flight. Each frame gets its own queries.
+    uint32 frame_count = 0U;
+
+    /// \brief The number of scopes each frame can record.
+    uint32 max_scopes_per_frame = 32U;
+
+    /// \brief The statistics of a scope cover this many of its most recent samples.
+    std::size_t history_size = 256UZ;
+
+    /// \brief The queue the frames are submitted to. Its family must support timestamps
+    ///        for anything to be timed.
+    QueueType queue_type = QueueType::Graphics;
+
+    /// \brief The counters collected by scopes begun with `ScopeStatistics::Yes`. Graphics
+    ///        counters need a graphics queue. Ignored when the device does not support
+    ///        `pipelineStatisticsQuery`.
+    vk::QueryPipelineStatisticFlags pipeline_statistics = { };
+};
+
+enum class ScopeStatistics
+{
+    No,
+    /// \brief Also collect the profiler's pipeline statistics. Such scopes cannot be
+    ///        nested in each other and must begin and end in the same subpass.
+    Yes,
+};
+
+/// \brief One pipeline statistics counter of a scope.
+struct PipelineStatistic
+{
+    vk::QueryPipelineStatisticFlagBits counter = { };
+    uint64                             value   = 0U;
+};
+
+/// \brief The GPU time taken by one named scope, in milliseconds.
+struct GpuScopeStats
+{
+    std::string name         = { };
+    std::size_t sample_count = 0UZ;
+    float64     last_ms      = 0.0;
+    float64     min_ms       = 0.0;
+    float64     avg_ms       = 0.0;
+    float64     p99_ms       = 0.0;
+
+    /// \brief The counters of the most recent frame that collected them.
+    std::vector< PipelineStatistic > statistics = { };
+};
+
+/// \brief Measures named scopes of recorded commands with timestamp queries. Results are
+///        read once a frame's resources are reused, when the GPU is known to be done with
+///        them, so reading never stalls.
+class VulkanGpuProfiler
+{
+public:
+    explicit( false ) VulkanGpuProfiler( VulkanGpu& gpu );
+
+    auto initialize( VulkanGpuProfilerSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief False when the queue family cannot write timestamps. Scopes are then untimed.
+    [[nodiscard( "Const getter" )]]
+    auto is_supported( ) const -> bool;
+
+    /// \brief True when scopes can collect `pipeline_statistics`.
+    [[nodiscard( "Const getter" )]]
+    auto collects_statistics( ) const -> bool;
+
+    /// \brief Collects the timestamps written the last time `frame_index` was recorded and
+    ///        resets its queries. The GPU must be done with that frame.
+    auto start_frame( uint32 frame_index ) -> utils::Result< void >;
+
+    /// \brief Writes the scope's start timestamp once all previous commands reach `stage`.
+    ///        Scopes can be nested and must be ended in the reverse order they began.
+    auto begin_scope(
+        FrameInfo const&          frame,
+        std::string_view          name,
+        ScopeStatistics           statistics = ScopeStatistics::No,
+        vk::PipelineStageFlagBits stage      = vk::PipelineStageFlagBits::eTopOfPipe
+    ) -> utils::Result< void >;
+
+    /// \brief Writes the end timestamp of the most recently begun scope.
+    auto end_scope(
+        FrameInfo const&          frame,
+        vk::PipelineStageFlagBits stage = vk::PipelineStageFlagBits::eBottomOfPipe
+    ) -> utils::Result< void >;
+
+    /// \brief One entry per scope name, in the order the names were first seen.
+    [[nodiscard( "Const computation" )]]
+    auto stats( ) const -> std::vector< GpuScopeStats >;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> VulkanGpuProfilerSettings const&;
+
+private:
+    struct Scope
+    {
+        std::size_t             name_index       = 0UZ;
+        uint32                  begin_query      = 0U;
+        uint32                  end_query        = 0U;
+        std::optional< uint32 > statistics_query = std::nullopt;
+        bool                    ended            = false;
+    };
+
+    struct FrameScopes
+    {
+        std::vector< Scope >       scopes                  = { };
+        std::vector< std::size_t > open_scopes             = { };
+        uint32                     used_queries            = 0U;
+        uint32                     used_statistics_queries = 0U;
+        bool                       statistics_active       = false;
+    };
+
+    struct ScopeHistory
+    {
+        std::string                      name       = { };
+        std::deque< float64 >            samples_ms = { };
+        std::vector< PipelineStatistic > statistics = { };
+    };
+
+    VulkanGpu& gpu_;
+
+    VulkanGpuProfilerSettings settings_              = { };
+    QueryPool                 query_pool_            = { gpu_.device( ) };
+    QueryPool                 statistics_query_pool_ = { gpu_.device( ) };
+
+    // The counters in the order their values are written by a statistics query.
+    std::vector< vk::QueryPipelineStatisticFlagBits > statistic_counters_ = { };
+
+    // Converts the valid bits of a timestamp difference to milliseconds.
+    uint64  timestamp_mask_ = 0U;
+    float64 ms_per_tick_    = 0.0;
+
+    std::vector< FrameScopes >                         frames_       = { };
+    std::vector< ScopeHistory >                        histories_    = { };
+    std::map< std::string, std::size_t, std::less<> > name_indices_ = { };
+
+    bool initialized_ = false;
+
+    auto queries_per_frame( ) const -> uint32;
+    auto name_index( std::string_view name ) -> std::size_t;
+    auto collect_timestamps( uint32 frame_index ) -> utils::Result< void >;
+    auto collect_statistics( uint32 frame_index ) -> utils::Result< void >;
+};
+
+/// \brief `frame.profiler->begin_scope(...)` when the frame has a profiler.
+auto begin_gpu_scope(
+    FrameInfo const&          frame,
+    std::string_view          name,
+    ScopeStatistics           statistics = ScopeStatistics::No,
+    vk::PipelineStageFlagBits stage      = vk::PipelineStageFlagBits::eTopOfPipe
+) -> utils::Result< void >;
+
+/// \brief `frame.profiler->end_scope(...)` when the frame has a profiler.
+auto end_gpu_scope(
+    FrameInfo const&          frame,
+    vk::PipelineStageFlagBits stage = vk::PipelineStageFlagBits::eBottomOfPipe
+) -> utils::Result< void >;
+
+/// \brief Writes one row per scope, with a header row, for regression tracking.
+auto write_gpu_stats_csv(
+    std::filesystem::path const&        file_path,
+    std::vector< GpuScopeStats > const& stats
+) -> utils::Result< void >;
+
+/// \brief Writes an array with one object per scope.
+auto write_gpu_stats_json(
+    std::filesystem::path const&        file_path,
+    std::vector< GpuScopeStats > const& stats
+) -> utils::Result< void >;
+
+} // namespace ltb::vlk::objs
@@ -0,0 +1,175 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/objs/vulkan_growable_buffer.hpp"
+
+// standard
+#include <algorithm>
+#include <span>
+#include <type_traits>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanGpuVectorSettings
+{
+    /// \brief Transfer source and destination usage is always added.
+    vk::BufferUsageFlags buffer_usage = vk::BufferUsageFlagBits::eStorageBuffer;
+
+    /// \brief The number of elements allocated up front.
+    std::size_t initial_capacity = 1024UZ;
+
+    /// \brief Groups the buffer's memory in the allocator's usage telemetry.
+    std::string tag = { };
+};
+
+/// \brief A `std::vector`-like array of `T` that lives in device local memory.
+///        See `VulkanGrowableBuffer` for how growth and old buffers are handled.
+template < typename T >
+class VulkanGpuVector
+{
+public:
+    static_assert( std::is_trivially_copyable_v< T > );
+
+    VulkanGpuVector( VulkanGpu& gpu, VulkanUploader& uploader );
+
+    auto initialize( VulkanGpuVectorSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    auto reset( ) -> void;
+
+    auto reserve( std::size_t capacity ) -> utils::Result< void >;
+
+    auto push_back( T const& value ) -> utils::Result< void >;
+    auto push_back_range( std::span< T const > values ) -> utils::Result< void >;
+
+    /// \brief Overwrites the elements starting at `first`, which must already exist.
+    auto update( std::size_t first, std::span< T const > values ) -> utils::Result< void >;
+
+    auto clear( ) -> void;
+
+    /// \brief Destroys the old buffers whose replacement copies have completed.
+    auto release_retired( ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto size( ) const -> std::size_t;
+
+    [[nodiscard( "Const getter" )]]
+    auto capacity( ) const -> std::size_t;
+
+    [[nodiscard( "Const getter" )]]
+    auto empty( ) const -> bool;
+
+    [[nodiscard( "Const getter" )]]
+    auto generation( ) const -> uint64;
+
+    [[nodiscard( "Const getter" )]]
+    auto buffer( ) const -> VulkanBuffer const&;
+
+private:
+    VulkanGrowableBuffer storage_;
+};
+
+template < typename T >
+VulkanGpuVector< T >::VulkanGpuVector( VulkanGpu& gpu, VulkanUploader& uploader )
+    : storage_( gpu, uploader )
+{
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::initialize( VulkanGpuVectorSettings settings )
+    -> utils::Result< void >
+{
+    return storage_.initialize( {
+        .buffer_usage     = settings.buffer_usage,
+        .initial_capacity = std::max( settings.initial_capacity, 1UZ ) * sizeof( T ),
+        .tag              = std::move( settings.tag ),
+    } );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::is_initialized( ) const -> bool
+{
+    return storage_.is_initialized( );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::reset( ) -> void
+{
+    storage_.reset( );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::reserve( std::size_t const capacity ) -> utils::Result< void >
+{
+    return storage_.reserve( capacity * sizeof( T ) );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::push_back( T const& value ) -> utils::Result< void >
+{
+    return storage_.push_back( &value, sizeof( T ) );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::push_back_range( std::span< T const > const values )
+    -> utils::Result< void >
+{
+    return storage_.push_back( values.data( ), values.size_bytes( ) );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::update( std::size_t const first, std::span< T const > const values )
+    -> utils::Result< void >
+{
+    return storage_.update( values.data( ), values.size_bytes( ), first * sizeof( T ) );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::clear( ) -> void
+{
+    storage_.clear( );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::release_retired( ) -> utils::Result< void >
+{
+    return storage_.release_retired( );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::size( ) const -> std::size_t
+{
+    return storage_.size( ) / sizeof( T );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::capacity( ) const -> std::size_t
+{
+    return storage_.capacity( ) / sizeof( T );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::empty( ) const -> bool
+{
+    return 0U == storage_.size( );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::generation( ) const -> uint64
+{
+    return storage_.generation( );
+}
+
+template < typename T >
+auto VulkanGpuVector< T >::buffer( ) const -> VulkanBuffer const&
+{
+    return storage_.buffer( );
+}
+
+} // namespace ltb::vlk::objs
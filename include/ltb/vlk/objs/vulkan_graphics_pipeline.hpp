@@ -13,20 +13,43 @@
 #include "ltb/vlk/objs/vulkan_presentation.hpp"
 #include "ltb/vlk/pipeline_layout.hpp"
 #include "ltb/vlk/shader_module.hpp"
+#include "ltb/vlk/shader_reflection.hpp"
 
 namespace ltb::vlk::objs
 {
 
+/// \brief A set whose layout and descriptors are owned elsewhere, like a
+///        `VulkanBindlessTable`.
+struct ExternalDescriptorSet
+{
+    uint32                  set    = 0U;
+    vk::DescriptorSetLayout layout = nullptr;
+
+    /// \brief The bindings of `layout`. The shaders' declarations of `set` must match them.
+    std::vector< vk::DescriptorSetLayoutBinding > bindings = { };
+};
+
 struct VulkanGraphicsPipelineSettings
 {
     std::vector< ShaderModuleSettings > shader_modules = { };
 
     uint32 descriptor_set_count = 0U;
 
+    /// \brief Indexed by set. Reflected from the shaders when empty.
     std::vector< std::vector< vk::DescriptorSetLayoutBinding > > uniform_binding_sets = { };
 
+    /// \brief Reflected from the shaders when empty.
     std::vector< vk::PushConstantRange > uniform_push_constants = { };
 
+    /// \brief Reflected uniform and storage buffers at these slots are made dynamic.
+    std::vector< DescriptorSlot > dynamic_buffers = { };
+
+    /// \brief Consecutive sets that follow the pipeline's own sets, so the first one's
+    ///        `set` is the number of sets the pipeline owns. Only the pipeline's own sets
+    ///        are bound by `bind_descriptor_sets`. The owners of these bind the rest.
+    std::vector< ExternalDescriptorSet > external_sets = { };
+
+    /// \brief The vertex attributes must feed every input of the vertex shader.
     GraphicsPipelineSettings pipeline = { };
 };
 
@@ -37,13 +60,35 @@ public:
 
     auto initialize( VulkanGraphicsPipelineSettings settings ) -> utils::Result< void >;
 
+    /// \brief The first half of `initialize`. Creates everything but the pipeline and
+    ///        returns the settings `compile` needs to finish.
+    auto initialize_layouts( VulkanGraphicsPipelineSettings settings )
+        -> utils::Result< GraphicsPipelineSettings >;
+
+    /// \brief The second half of `initialize`. Different pipelines can compile on
+    ///        different threads at the same time.
+    auto compile( GraphicsPipelineSettings settings ) -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
+    /// \brief Reloads the SPIR-V files and rebuilds the pipeline with the same layout. The
+    ///        old pipeline is returned so it can be destroyed once the GPU is done with it.
+    auto reload_shaders( ) -> utils::Result< vk::UniquePipeline >;
+
     auto bind( vk::CommandBuffer const& command_buffer ) -> void;
 
     auto bind_descriptor_sets( FrameInfo const& frame ) -> utils::Result< void >;
 
+    /// \brief `dynamic_offsets` are applied in binding order to every dynamic
+    ///        uniform or storage buffer in the bound descriptor sets.
+    ///        Skipped if another pipeline with the same layout already bound the same
+    ///        sets and offsets to the frame's command buffer.
+    auto bind_descriptor_sets(
+        FrameInfo const&             frame,
+        std::vector< uint32 > const& dynamic_offsets
+    ) -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto shader_modules( ) const -> std::vector< ShaderModule > const&;
     auto shader_modules( ) -> std::vector< ShaderModule >&;
@@ -77,12 +122,18 @@ private:
 
     GraphicsPipeline pipeline_ = {
         gpu_.device( ),
+        gpu_.pipeline_cache( ),
         presentation_.render_pass( ),
         shader_modules_,
         pipeline_layout_,
     };
 
     bool initialized_ = false;
+
+    /// \brief Fills the binding sets and push constants left empty from the shaders'
+    ///        reflections.
+    auto reflect_layout( VulkanGraphicsPipelineSettings& settings ) const
+        -> utils::Result< void >;
 };
 
 auto default_initialization(
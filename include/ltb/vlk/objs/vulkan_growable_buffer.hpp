@@ -0,0 +1,99 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/objs/vulkan_buffer.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+#include "ltb/vlk/objs/vulkan_uploader.hpp"
+
+// standard
+#include <memory>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanGrowableBufferSettings
+{
+    /// \brief Transfer source and destination usage is always added.
+    vk::BufferUsageFlags buffer_usage = vk::BufferUsageFlagBits::eStorageBuffer;
+
+    /// \brief The number of bytes allocated up front.
+    vk::DeviceSize initial_capacity = 64UZ * 1024UZ;
+
+    /// \brief Groups the buffer's memory in the allocator's usage telemetry.
+    std::string tag = { };
+};
+
+/// \brief A device local buffer whose contents are written through a `VulkanUploader`.
+///        When appending exceeds the capacity a buffer twice the size is allocated and
+///        the old contents are copied over on the GPU. The old buffer is destroyed once
+///        the uploader batch holding that copy has completed.
+/// \note  The uploader must submit to the queue that uses the buffer. Work recorded after
+///        a reallocation has to use the new buffer (see `generation`).
+class VulkanGrowableBuffer
+{
+public:
+    VulkanGrowableBuffer( VulkanGpu& gpu, VulkanUploader& uploader );
+
+    auto initialize( VulkanGrowableBufferSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Destroys every buffer immediately. The GPU must be done with them.
+    auto reset( ) -> void;
+
+    /// \brief Makes sure at least `capacity` bytes are allocated, reallocating if needed.
+    auto reserve( vk::DeviceSize capacity ) -> utils::Result< void >;
+
+    /// \brief Appends `size` bytes of `data`, growing the buffer geometrically.
+    auto push_back( void const* data, vk::DeviceSize size ) -> utils::Result< void >;
+
+    /// \brief Overwrites `size` bytes at `offset`. The range must already be in use.
+    auto update( void const* data, vk::DeviceSize size, vk::DeviceSize offset )
+        -> utils::Result< void >;
+
+    /// \brief Drops the contents without releasing any memory.
+    auto clear( ) -> void;
+
+    /// \brief Destroys the old buffers whose replacement copies have completed.
+    auto release_retired( ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto size( ) const -> vk::DeviceSize;
+
+    [[nodiscard( "Const getter" )]]
+    auto capacity( ) const -> vk::DeviceSize;
+
+    /// \brief Incremented every time the buffer is reallocated so descriptors
+    ///        and recorded commands know when to refer to the new one.
+    [[nodiscard( "Const getter" )]]
+    auto generation( ) const -> uint64;
+
+    [[nodiscard( "Const getter" )]]
+    auto buffer( ) const -> VulkanBuffer const&;
+
+private:
+    struct RetiredBuffer
+    {
+        std::unique_ptr< VulkanBuffer > buffer     = nullptr;
+        uint64                          submission = 0U;
+    };
+
+    VulkanGpu&      gpu_;
+    VulkanUploader& uploader_;
+
+    VulkanGrowableBufferSettings    settings_   = { };
+    std::unique_ptr< VulkanBuffer > buffer_     = nullptr;
+    vk::DeviceSize                  size_       = 0U;
+    vk::DeviceSize                  capacity_   = 0U;
+    uint64                          generation_ = 0U;
+
+    std::vector< RetiredBuffer > retired_ = { };
+
+    auto reallocate( vk::DeviceSize capacity ) -> utils::Result< void >;
+};
+
+} // namespace ltb::vlk::objs
@@ -4,7 +4,7 @@
 #pragma once
 
 // project
-#include "ltb/vlk/device_memory.hpp"
+#include "ltb/vlk/device_memory_allocator.hpp"
 #include "ltb/vlk/image.hpp"
 #include "ltb/vlk/objs/vulkan_gpu.hpp"
 
@@ -15,12 +15,16 @@ struct VulkanImageSettings
 {
     ImageSettings           image             = { };
     vk::MemoryPropertyFlags memory_properties = vk::MemoryPropertyFlagBits::eDeviceLocal;
+
+    /// \brief Groups this image's memory in the allocator's usage telemetry.
+    std::string tag = { };
 };
 
 class VulkanImage
 {
 public:
     explicit( false ) VulkanImage( VulkanGpu& gpu );
+    ~VulkanImage( );
 
     auto initialize( VulkanImageSettings settings ) -> utils::Result< void >;
 
@@ -34,14 +38,13 @@ public:
     auto image( ) -> Image&;
 
     [[nodiscard( "Const getter" )]]
-    auto memory( ) const -> DeviceMemory const&;
-    auto memory( ) -> DeviceMemory&;
+    auto allocation( ) const -> DeviceAllocation const&;
 
 private:
     VulkanGpu& gpu_;
 
-    Image        image_  = { gpu_.device( ) };
-    DeviceMemory memory_ = { gpu_.device( ) };
+    Image            image_      = { gpu_.device( ) };
+    DeviceAllocation allocation_ = { };
 
     bool initialized_ = false;
 };
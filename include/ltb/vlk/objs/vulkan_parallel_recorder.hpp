@@ -0,0 +1,112 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/command_buffer.hpp"
+#include "ltb/vlk/command_pool.hpp"
+#include "ltb/vlk/objs/frame_info.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+
+// standard
+#include <deque>
+#include <functional>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanParallelRecorderSettings
+{
+    /// \brief The number of frames that can be in flight. Each frame gets its own pools.
+    uint32 frame_count = 0U;
+
+    /// \brief The maximum number of secondary command buffers recorded in parallel by
+    ///        one `record` call. Zero uses the hardware concurrency.
+    uint32 worker_count = 0U;
+
+    /// \brief Work is not split any finer than this many items per worker.
+    std::size_t min_items_per_worker = 64UZ;
+
+    /// \brief The queue the primary command buffers are submitted to.
+    QueueType queue_type = QueueType::Graphics;
+};
+
+/// \brief Records the items [first, last) into `command_buffer`. It is called from
+///        several threads at once, each with its own command buffer and range.
+using RecordRange = std::function< utils::Result< void >(
+    vk::CommandBuffer const& command_buffer,
+    std::size_t              first,
+    std::size_t              last
+) >;
+
+/// \brief Splits recording across worker threads. Every worker records a secondary command
+///        buffer from a command pool that only it uses during the frame, and the secondary
+///        buffers are executed in order from the frame's primary command buffer.
+class VulkanParallelRecorder
+{
+public:
+    explicit( false ) VulkanParallelRecorder( VulkanGpu& gpu );
+
+    auto initialize( VulkanParallelRecorderSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Resets the command pools of `frame.frame_index`. The GPU must be done with
+    ///        that frame (i.e. `VulkanCommandAndSync::start_frame` has returned it).
+    auto start_frame( FrameInfo const& frame ) -> utils::Result< void >;
+
+    /// \brief Records `item_count` items in parallel with `record_range` and executes the
+    ///        results in `frame.command_buffer`. When `inheritance.renderPass` is set the
+    ///        secondary buffers continue that pass, which the primary buffer must have begun
+    ///        with `vk::SubpassContents::eSecondaryCommandBuffers`.
+    auto record(
+        FrameInfo const&                        frame,
+        vk::CommandBufferInheritanceInfo const& inheritance,
+        std::size_t                             item_count,
+        RecordRange const&                      record_range
+    ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto worker_count( ) const -> uint32;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> VulkanParallelRecorderSettings const&;
+
+private:
+    struct WorkerPool
+    {
+        CommandPool command_pool;
+
+        // A deque keeps the buffers in place as more are allocated.
+        std::deque< CommandBuffer > command_buffers = { };
+        std::size_t                 used            = 0UZ;
+    };
+
+    struct Chunk
+    {
+        std::size_t                        first          = 0UZ;
+        std::size_t                        last           = 0UZ;
+        WorkerPool*                        pool           = nullptr;
+        utils::Result< vk::CommandBuffer > command_buffer = { };
+    };
+
+    VulkanGpu& gpu_;
+
+    VulkanParallelRecorderSettings settings_     = { };
+    uint32                         worker_count_ = 0U;
+
+    // Indexed by `frame_index * worker_count_ + worker_index`.
+    std::deque< WorkerPool > pools_ = { };
+
+    bool initialized_ = false;
+
+    auto record_chunk(
+        Chunk const&                            chunk,
+        vk::CommandBufferInheritanceInfo const& inheritance,
+        RecordRange const&                      record_range
+    ) -> utils::Result< vk::CommandBuffer >;
+};
+
+} // namespace ltb::vlk::objs
@@ -0,0 +1,103 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/objs/vulkan_compute_pipeline.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+#include "ltb/vlk/objs/vulkan_graphics_pipeline.hpp"
+
+// standard
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanPipelineCompilerSettings
+{
+    /// \brief The number of threads compiling pipelines. Zero uses the hardware concurrency.
+    uint32 worker_count = 0U;
+};
+
+/// \brief Resolves once a submitted pipeline has compiled.
+class PipelineHandle
+{
+public:
+    PipelineHandle( ) = default;
+    explicit PipelineHandle( std::shared_future< utils::Result< void > > result );
+
+    [[nodiscard( "Const getter" )]]
+    auto is_valid( ) const -> bool;
+
+    /// \brief True once `wait` would return without blocking.
+    [[nodiscard( "Const computation" )]]
+    auto is_ready( ) const -> bool;
+
+    /// \brief Blocks until the pipeline has compiled and returns any compilation error.
+    auto wait( ) const -> utils::Result< void >;
+
+private:
+    std::shared_future< utils::Result< void > > result_ = { };
+};
+
+/// \brief Compiles pipelines on a pool of worker threads. Submitting a pipeline creates its
+///        layouts and descriptor sets on the calling thread, since those allocate from
+///        shared pools, and only the compilation itself runs on a worker. A submitted
+///        pipeline must not be used or destroyed until its handle resolves. Pipelines still
+///        queued when the compiler is destroyed are not compiled and their handles resolve
+///        with an error.
+class VulkanPipelineCompiler
+{
+public:
+    explicit( false ) VulkanPipelineCompiler( VulkanGpu& gpu );
+    ~VulkanPipelineCompiler( );
+
+    VulkanPipelineCompiler( VulkanPipelineCompiler const& )                    = delete;
+    VulkanPipelineCompiler( VulkanPipelineCompiler&& )                         = delete;
+    auto operator=( VulkanPipelineCompiler const& ) -> VulkanPipelineCompiler& = delete;
+    auto operator=( VulkanPipelineCompiler&& ) -> VulkanPipelineCompiler&      = delete;
+
+    auto initialize( VulkanPipelineCompilerSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    auto submit( VulkanGraphicsPipeline& pipeline, VulkanGraphicsPipelineSettings settings )
+        -> utils::Result< PipelineHandle >;
+
+    auto submit( VulkanComputePipeline& pipeline, VulkanComputePipelineSettings settings )
+        -> utils::Result< PipelineHandle >;
+
+    /// \brief Waits for every pipeline submitted so far and returns the first error.
+    auto wait_all( ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto worker_count( ) const -> uint32;
+
+private:
+    using CompileFunction = std::move_only_function< utils::Result< void >( ) >;
+
+    /// \brief Compiles unless `abandoned`, which resolves the handle with an error instead.
+    using CompileTask = std::packaged_task< utils::Result< void >( bool abandoned ) >;
+
+    VulkanGpu& gpu_;
+
+    std::mutex                    mutex_      = { };
+    std::condition_variable_any   task_added_ = { };
+    std::deque< CompileTask >     tasks_      = { };
+    std::vector< PipelineHandle > submitted_  = { };
+
+    // Joined by the destructor, before the members the workers use are destroyed.
+    std::vector< std::jthread > workers_ = { };
+
+    auto enqueue( CompileFunction compile ) -> PipelineHandle;
+    auto run_worker( std::stop_token const& stop_token ) -> void;
+};
+
+} // namespace ltb::vlk::objs
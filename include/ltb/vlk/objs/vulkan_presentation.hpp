@@ -4,7 +4,7 @@
 #pragma once
 
 // project
-#include "ltb/vlk/device_memory.hpp"
+#include "ltb/vlk/device_memory_allocator.hpp"
 #include "ltb/vlk/framebuffer.hpp"
 #include "ltb/vlk/image.hpp"
 #include "ltb/vlk/image_view.hpp"
@@ -52,6 +52,10 @@ struct BeginRenderPassSettings
     std::optional< vk::Rect2D >   render_area = std::nullopt;
     std::optional< vk::Viewport > viewport    = std::nullopt;
     std::optional< vk::Rect2D >   scissor     = std::nullopt;
+
+    /// \brief Use `eSecondaryCommandBuffers` when the pass is recorded into secondary
+    ///        command buffers that inherit `inheritance_info( image_index )`.
+    vk::SubpassContents subpass_contents = vk::SubpassContents::eInline;
 };
 
 class VulkanPresentation
@@ -67,6 +71,21 @@ public:
 
     auto begin_render_pass( BeginRenderPassSettings const& settings ) -> utils::Result< void >;
 
+    /// \brief Sets the viewport and scissor, defaulting to the full swapchain extent.
+    ///        Secondary command buffers do not inherit dynamic state so each one that
+    ///        draws has to set it again.
+    auto set_viewport_and_scissor(
+        vk::CommandBuffer const&      command_buffer,
+        std::optional< vk::Viewport > viewport = std::nullopt,
+        std::optional< vk::Rect2D >   scissor  = std::nullopt
+    ) const -> void;
+
+    /// \brief What a secondary command buffer needs to continue the render pass begun
+    ///        for `image_index`.
+    [[nodiscard( "Const computation" )]]
+    auto inheritance_info( uint32 image_index ) const
+        -> utils::Result< vk::CommandBufferInheritanceInfo >;
+
     [[nodiscard( "Const getter" )]]
     auto swapchain( ) const -> Swapchain const&;
     auto swapchain( ) -> Swapchain&;
@@ -80,8 +99,7 @@ public:
     auto depth_image( ) -> Image&;
 
     [[nodiscard( "Const getter" )]]
-    auto depth_memory( ) const -> DeviceMemory const&;
-    auto depth_memory( ) -> DeviceMemory&;
+    auto depth_allocation( ) const -> DeviceAllocation const&;
 
     [[nodiscard( "Const getter" )]]
     auto depth_image_view( ) const -> ImageView const&;
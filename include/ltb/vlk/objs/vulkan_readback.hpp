@@ -0,0 +1,124 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/buffer.hpp"
+#include "ltb/vlk/objs/frame_info.hpp"
+#include "ltb/vlk/objs/vulkan_buffer.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+
+// standard
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanReadbackSettings
+{
+    /// \brief The number of frames that can be in flight. Each frame gets its own region.
+    uint32 frame_count = 0U;
+
+    /// \brief The number of bytes each frame can read back.
+    vk::DeviceSize frame_size = 1UZ * 1024UZ * 1024UZ;
+};
+
+/// \brief Refers to data copied by `VulkanReadback::read`. It resolves once the fence
+///        (or timeline value) of the frame the copy was recorded in has signaled.
+struct ReadbackHandle
+{
+    uint32         frame_index = 0U;
+    uint64         frame_epoch = 0U;
+    vk::DeviceSize offset      = 0U;
+    vk::DeviceSize size        = 0U;
+};
+
+/// \brief Copies device buffer ranges into a persistently mapped, host cached staging
+///        buffer without stalling. Every frame in flight owns a region of the staging
+///        buffer so results from earlier frames can be read while later frames copy.
+class VulkanReadback
+{
+public:
+    explicit( false ) VulkanReadback( VulkanGpu& gpu );
+
+    auto initialize( VulkanReadbackSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Reuses the region of `frame.frame_index`. Handles from the previous use of
+    ///        the region expire, so their data must be read before this is called.
+    auto start_frame( FrameInfo const& frame ) -> utils::Result< void >;
+
+    /// \brief Records a copy of `size` bytes at `src_offset` of `src_buffer` into
+    ///        `frame.command_buffer`, ordered after all earlier writes on the queue.
+    auto read(
+        FrameInfo const& frame,
+        Buffer const&    src_buffer,
+        vk::DeviceSize   src_offset,
+        vk::DeviceSize   size
+    ) -> utils::Result< ReadbackHandle >;
+
+    /// \brief True once the frame the copy was recorded in has completed.
+    [[nodiscard( "Const computation" )]]
+    auto is_ready( ReadbackHandle const& handle ) const -> utils::Result< bool >;
+
+    /// \brief Blocks until the frame the copy was recorded in has completed.
+    auto wait( ReadbackHandle const& handle ) const -> utils::Result< void >;
+
+    /// \brief The copied bytes. Fails if the handle is not ready or has expired.
+    [[nodiscard( "Const computation" )]]
+    auto data( ReadbackHandle const& handle ) const -> utils::Result< std::span< uint8 const > >;
+
+    /// \brief Copies the start of the read back bytes into a `T`.
+    template < typename T >
+    auto get( ReadbackHandle const& handle ) const -> utils::Result< T >;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> VulkanReadbackSettings const&;
+
+    [[nodiscard( "Const getter" )]]
+    auto buffer( ) const -> VulkanBuffer const&;
+
+private:
+    struct FrameRegion
+    {
+        vk::Fence      fence          = nullptr;
+        vk::Semaphore  timeline       = nullptr;
+        uint64         timeline_value = 0U;
+        uint64         epoch          = 0U;
+        vk::DeviceSize used           = 0U;
+    };
+
+    VulkanGpu& gpu_;
+
+    VulkanReadbackSettings     settings_ = { };
+    VulkanBuffer               staging_  = { gpu_ };
+    std::vector< FrameRegion > frames_   = { };
+
+    vk::DeviceSize frame_stride_ = 0U;
+    bool           coherent_     = false;
+
+    bool initialized_ = false;
+
+    auto find_frame( ReadbackHandle const& handle ) const -> utils::Result< FrameRegion const* >;
+};
+
+template < typename T >
+auto VulkanReadback::get( ReadbackHandle const& handle ) const -> utils::Result< T >
+{
+    static_assert( std::is_trivially_copyable_v< T > );
+
+    LTB_CHECK( auto const bytes, this->data( handle ) );
+    LTB_CHECK_VALID( sizeof( T ) <= bytes.size( ) );
+
+    auto value = T{ };
+    std::memcpy( &value, bytes.data( ), sizeof( T ) );
+
+    return value;
+}
+
+} // namespace ltb::vlk::objs
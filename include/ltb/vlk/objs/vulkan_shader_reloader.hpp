@@ -0,0 +1,114 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/duration.hpp"
+#include "ltb/vlk/fence.hpp"
+#include "ltb/vlk/objs/vulkan_compute_pipeline.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+#include "ltb/vlk/objs/vulkan_graphics_pipeline.hpp"
+#include "ltb/vlk/queue_types.hpp"
+
+// standard
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanShaderReloaderSettings
+{
+    /// \brief Every shader source below this directory is watched. Each is compiled to
+    ///        the `.spv` file next to it, the same file the build produces.
+    std::filesystem::path shader_dir = { };
+
+    /// \brief Empty uses the compiler found when the project was configured.
+    std::filesystem::path glslc = { };
+
+    /// \brief How often the watcher checks the sources for changes.
+    utils::Duration poll_interval = utils::duration_millis( 250 );
+};
+
+/// \brief A development tool that recompiles shaders as they are edited and rebuilds the
+///        pipelines that use them. Sources are watched and compiled on a background thread.
+///        The rebuilt pipelines are swapped in by `swap_pipelines`, and the old ones are
+///        destroyed once their queue has finished every submission made before the swap,
+///        so the device never has to go idle. The GPU must be idle when this is destroyed.
+/// \note  Only the shaders change. A shader whose descriptors, push constants or vertex
+///        inputs change is rejected, since the pipeline keeps its layouts.
+class VulkanShaderReloader
+{
+public:
+    explicit( false ) VulkanShaderReloader( VulkanGpu& gpu );
+
+    auto initialize( VulkanShaderReloaderSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Rebuilds `pipeline` whenever one of its SPIR-V files is recompiled. The
+    ///        pipeline must be used on `queue_type` and outlive this object.
+    auto watch( VulkanComputePipeline& pipeline, QueueType queue_type ) -> utils::Result< void >;
+    auto watch( VulkanGraphicsPipeline& pipeline, QueueType queue_type ) -> utils::Result< void >;
+
+    /// \brief Rebuilds every watched pipeline whose shaders were recompiled since the last
+    ///        call. Call it between frames, after every command buffer recorded with the
+    ///        current pipelines has been submitted. A pipeline that fails to rebuild keeps
+    ///        its current shaders. Returns the number of pipelines swapped.
+    auto swap_pipelines( ) -> utils::Result< uint32 >;
+
+    /// \brief The number of shaders whose most recent compilation failed.
+    [[nodiscard( "Const computation" )]]
+    auto failed_shader_count( ) const -> std::size_t;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> VulkanShaderReloaderSettings const&;
+
+private:
+    struct WatchedPipeline
+    {
+        std::vector< std::filesystem::path >                    spirv_files    = { };
+        std::function< utils::Result< vk::UniquePipeline >( ) > reload_shaders = { };
+        QueueType                                               queue_type     = { };
+    };
+
+    struct RetiredPipeline
+    {
+        vk::UniquePipeline       pipeline = { };
+        std::unique_ptr< Fence > fence    = nullptr;
+    };
+
+    VulkanGpu& gpu_;
+
+    VulkanShaderReloaderSettings   settings_ = { };
+    std::vector< WatchedPipeline > watched_  = { };
+    std::vector< RetiredPipeline > retired_  = { };
+
+    // Written by the watcher, read by `swap_pipelines`.
+    mutable std::mutex                mutex_          = { };
+    std::condition_variable_any       wake_watcher_   = { };
+    std::set< std::filesystem::path > compiled_spirv_ = { };
+    std::set< std::filesystem::path > failed_shaders_ = { };
+
+    // Only used by the watcher.
+    std::map< std::filesystem::path, std::filesystem::file_time_type > write_times_ = { };
+
+    // Declared last so it is stopped and joined before the members it uses are destroyed.
+    std::jthread watcher_ = { };
+
+    auto run_watcher( std::stop_token const& stop_token ) -> void;
+    auto poll_sources( ) -> void;
+    auto compile( std::filesystem::path const& source ) -> bool;
+    auto retire( vk::UniquePipeline pipeline, QueueType queue_type ) -> utils::Result< void >;
+    auto release_retired( ) -> utils::Result< void >;
+};
+
+} // namespace ltb::vlk::objs
@@ -0,0 +1,72 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+#include "ltb/vlk/queue_types.hpp"
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanSubmitBatchSettings
+{
+    QueueType queue_type = QueueType::Graphics;
+};
+
+/// \brief One submission waiting in a `VulkanSubmitBatch`.
+struct PendingSubmit
+{
+    std::vector< vk::SemaphoreSubmitInfo >     waits           = { };
+    std::vector< vk::CommandBufferSubmitInfo > command_buffers = { };
+    std::vector< vk::SemaphoreSubmitInfo >     signals         = { };
+};
+
+/// \brief Accumulates submissions for one queue and sends them all with a single
+///        `vkQueueSubmit2` when flushed. Submissions keep their order, so one may wait on
+///        a timeline value signaled by an earlier submission in the same batch.
+class VulkanSubmitBatch
+{
+public:
+    explicit( false ) VulkanSubmitBatch( VulkanGpu& gpu );
+
+    auto initialize( VulkanSubmitBatchSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Queues `submit`. A batch signals at most one fence, when its last
+    ///        submission completes.
+    auto add( PendingSubmit submit, vk::Fence fence ) -> utils::Result< void >;
+
+    /// \brief Submits everything queued since the last flush. Does nothing when empty.
+    auto flush( ) -> utils::Result< void >;
+
+    /// \brief True when a queued submission signals `value` (or later) on `semaphore`.
+    ///        Waiting for that value on the host before flushing would never return.
+    [[nodiscard( "Const computation" )]]
+    auto is_pending( vk::Semaphore semaphore, uint64 value ) const -> bool;
+
+    /// \brief True when the batch will signal `fence` once it is flushed.
+    [[nodiscard( "Const computation" )]]
+    auto is_pending( vk::Fence fence ) const -> bool;
+
+    [[nodiscard( "Const getter" )]]
+    auto empty( ) const -> bool;
+
+    [[nodiscard( "Const getter" )]]
+    auto queue( ) const -> vk::Queue const&;
+
+private:
+    VulkanGpu& gpu_;
+
+    VulkanSubmitBatchSettings    settings_ = { };
+    vk::Queue                    queue_    = nullptr;
+    std::vector< PendingSubmit > pending_  = { };
+    vk::Fence                    fence_    = nullptr;
+
+    bool initialized_ = false;
+};
+
+} // namespace ltb::vlk::objs
@@ -0,0 +1,93 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/objs/vulkan_buffer.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+
+// standard
+#include <cstring>
+#include <type_traits>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanUniformArenaSettings
+{
+    /// \brief The number of frames that can be in flight. Each frame gets its own region.
+    uint32 frame_count = 0U;
+
+    /// \brief The number of bytes each frame can allocate before `start_frame` is called again.
+    vk::DeviceSize frame_size = 64UZ * 1024UZ;
+};
+
+/// \brief A slice of the arena that stays valid until its frame is started again.
+struct UniformSlice
+{
+    uint8*         mapped_data    = nullptr;
+    uint32         dynamic_offset = 0U;
+    vk::DeviceSize size           = 0U;
+};
+
+/// \brief A linear allocator over one persistently mapped uniform buffer. Every frame in
+///        flight owns a region that is reset by `start_frame` and handed out in aligned
+///        slices. Slices are bound through a single `eUniformBufferDynamic` descriptor
+///        using their dynamic offset so no per-frame descriptor sets are needed.
+class VulkanUniformArena
+{
+public:
+    explicit( false ) VulkanUniformArena( VulkanGpu& gpu );
+
+    auto initialize( VulkanUniformArenaSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Releases every slice allocated the last time `frame_index` was started.
+    ///        The GPU must be done with that frame (i.e. its fence has been waited on).
+    auto start_frame( uint32 frame_index ) -> utils::Result< void >;
+
+    auto allocate( vk::DeviceSize size ) -> utils::Result< UniformSlice >;
+
+    /// \brief Copies `value` into a new slice and returns its dynamic offset.
+    template < typename T >
+    auto push( T const& value ) -> utils::Result< uint32 >;
+
+    /// \brief The buffer info for a dynamic uniform binding that reads `range` bytes.
+    [[nodiscard( "Const getter" )]]
+    auto descriptor_info( vk::DeviceSize range ) const -> vk::DescriptorBufferInfo;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> VulkanUniformArenaSettings const&;
+
+    [[nodiscard( "Const getter" )]]
+    auto buffer( ) const -> VulkanBuffer const&;
+
+private:
+    VulkanGpu& gpu_;
+
+    VulkanUniformArenaSettings settings_ = { };
+    VulkanBuffer               buffer_   = { gpu_ };
+
+    vk::DeviceSize alignment_    = 1U;
+    vk::DeviceSize frame_stride_ = 0U;
+    vk::DeviceSize frame_begin_  = 0U;
+    vk::DeviceSize frame_used_   = 0U;
+
+    bool initialized_ = false;
+};
+
+template < typename T >
+auto VulkanUniformArena::push( T const& value ) -> utils::Result< uint32 >
+{
+    static_assert( std::is_trivially_copyable_v< T > );
+
+    LTB_CHECK( auto const slice, this->allocate( sizeof( T ) ) );
+    std::memcpy( slice.mapped_data, &value, sizeof( T ) );
+
+    return slice.dynamic_offset;
+}
+
+} // namespace ltb::vlk::objs
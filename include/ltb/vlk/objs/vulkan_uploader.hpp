@@ -0,0 +1,199 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/buffer.hpp"
+#include "ltb/vlk/command_buffer.hpp"
+#include "ltb/vlk/command_pool.hpp"
+#include "ltb/vlk/fence.hpp"
+#include "ltb/vlk/image.hpp"
+#include "ltb/vlk/objs/vulkan_buffer.hpp"
+#include "ltb/vlk/objs/vulkan_command_and_sync.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+#include "ltb/vlk/semaphore.hpp"
+
+// standard
+#include <deque>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanUploaderSettings
+{
+    /// \brief Size of the persistently mapped staging ring.
+    vk::DeviceSize staging_size = 32UZ * 1024UZ * 1024UZ;
+
+    /// \brief How many submitted batches may be in flight before a flush has to wait.
+    uint32 max_batches_in_flight = 4U;
+
+    /// \brief The queue the copies are submitted to. A dedicated transfer
+    ///        family lets large uploads overlap with rendering.
+    QueueType queue_type = QueueType::Transfer;
+
+    /// \brief The queue that uses the uploaded resources. When it belongs to a different
+    ///        family than `queue_type` the resources are released after the copies and
+    ///        must be acquired on this queue with `acquire()` (or `wait()`).
+    QueueType dst_queue_type = QueueType::Graphics;
+};
+
+/// \brief Streams host data into device local buffers and images through a persistently
+///        mapped staging ring. Uploads are batched until `flush()` submits them with a
+///        single `vkQueueSubmit`. Ring regions are reclaimed once their batch's fence
+///        signals.
+class VulkanUploader
+{
+public:
+    explicit( false ) VulkanUploader( VulkanGpu& gpu );
+
+    auto initialize( VulkanUploaderSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Copies `size` bytes of `data` into the staging ring and queues a copy into
+    ///        `dst_buffer` at `dst_offset`. Nothing is submitted until `flush()`.
+    auto upload(
+        void const*    data,
+        vk::DeviceSize size,
+        Buffer const&  dst_buffer,
+        vk::DeviceSize dst_offset
+    ) -> utils::Result< void >;
+
+    /// \brief Queues a copy of tightly packed texel `data` into mip level 0 of every array
+    ///        layer of `dst_image`. The image is left in `final_layout`.
+    auto upload(
+        void const*     data,
+        vk::DeviceSize  size,
+        Image const&    dst_image,
+        vk::ImageLayout final_layout
+    ) -> utils::Result< void >;
+
+    /// \brief Queues a device side copy between two buffers, ordered after every upload
+    ///        queued before it and after all work previously submitted to the queue. This
+    ///        is only available when the uploader submits to the destination queue since
+    ///        `src_buffer` may be in use there. A zero `size` only records that ordering.
+    auto copy(
+        Buffer const&  src_buffer,
+        vk::DeviceSize src_offset,
+        Buffer const&  dst_buffer,
+        vk::DeviceSize dst_offset,
+        vk::DeviceSize size
+    ) -> utils::Result< void >;
+
+    /// \brief Submits all pending copies as one batch without waiting for them.
+    auto flush( ) -> utils::Result< void >;
+
+    /// \brief Records the ownership acquire barriers of every batch that has finished on
+    ///        the transfer queue into `command_buffer`, which must be submitted to the
+    ///        destination queue along with a wait on each returned semaphore. Batches
+    ///        still copying are left for a later call so rendering never stalls on them.
+    auto acquire( vk::CommandBuffer const& command_buffer )
+        -> utils::Result< std::vector< SemaphoreAndStage > >;
+
+    /// \brief Flushes, acquires everything on the destination queue and blocks until
+    ///        every submitted batch has completed.
+    auto wait( ) -> utils::Result< void >;
+
+    /// \brief True when the copies run on a different queue family than the destination.
+    [[nodiscard( "Const getter" )]]
+    auto transfers_ownership( ) const -> bool;
+
+    /// \brief The id the currently pending copies will be submitted with. Every flush
+    ///        that submits a batch increments it by one.
+    [[nodiscard( "Const getter" )]]
+    auto pending_submission( ) const -> uint64;
+
+    /// \brief True once the batch submitted with id `submission` has completed.
+    auto is_complete( uint64 submission ) -> utils::Result< bool >;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> VulkanUploaderSettings const&;
+
+    [[nodiscard( "Const getter" )]]
+    auto queue( ) const -> vk::Queue const&;
+
+    [[nodiscard( "Const getter" )]]
+    auto dst_queue( ) const -> vk::Queue const&;
+
+    [[nodiscard( "Const getter" )]]
+    auto staging( ) const -> VulkanBuffer const&;
+
+private:
+    struct PendingCopy
+    {
+        /// \brief The staging ring is used when this is null.
+        vk::Buffer     src_buffer = nullptr;
+        vk::Buffer     dst_buffer = nullptr;
+        vk::BufferCopy region     = { };
+    };
+
+    struct PendingImageCopy
+    {
+        vk::Image                 dst_image    = nullptr;
+        vk::BufferImageCopy       region       = { };
+        vk::ImageSubresourceRange range        = { };
+        vk::ImageLayout           final_layout = vk::ImageLayout::eUndefined;
+    };
+
+    struct InFlightBatch
+    {
+        uint32 batch_index  = 0U;
+        uint64 submission   = 0U;
+        uint64 ring_release = 0U;
+    };
+
+    struct UnacquiredBatch
+    {
+        uint32                                 batch_index     = 0U;
+        std::vector< vk::BufferMemoryBarrier > buffer_barriers = { };
+        std::vector< vk::ImageMemoryBarrier >  image_barriers  = { };
+    };
+
+    VulkanGpu& gpu_;
+
+    VulkanUploaderSettings settings_            = { };
+    vk::Queue              queue_               = nullptr;
+    vk::Queue              dst_queue_           = nullptr;
+    QueueIndex             queue_family_        = 0U;
+    QueueIndex             dst_queue_family_    = 0U;
+    bool                   transfers_ownership_ = false;
+
+    CommandPool  command_pool_ = { gpu_.device( ), gpu_.physical_device( ) };
+    VulkanBuffer staging_      = { gpu_ };
+
+    // Per batch objects.
+    std::vector< CommandBuffer > command_buffers_ = { };
+    std::vector< Fence >         fences_          = { };
+    std::vector< Semaphore >     semaphores_      = { };
+
+    // Used to acquire ownership on the destination queue when the caller does not.
+    CommandPool   dst_command_pool_   = { gpu_.device( ), gpu_.physical_device( ) };
+    CommandBuffer dst_command_buffer_ = { gpu_.device( ), dst_command_pool_ };
+    Fence         dst_fence_          = { gpu_.device( ) };
+
+    std::vector< PendingCopy >      pending_copies_       = { };
+    std::vector< PendingImageCopy > pending_image_copies_ = { };
+    std::deque< InFlightBatch >     in_flight_batches_    = { };
+    std::deque< UnacquiredBatch >   unacquired_batches_   = { };
+    uint32                          next_batch_           = 0U;
+    uint64                          submitted_            = 0U;
+    uint64                          completed_            = 0U;
+
+    // Monotonic positions into the staging ring. The physical
+    // offset of a position is `position % settings_.staging_size`.
+    uint64         ring_write_     = 0U;
+    uint64         ring_free_      = 0U;
+    vk::DeviceSize copy_alignment_ = 1U;
+
+    bool initialized_ = false;
+
+    auto reserve_staging( vk::DeviceSize size, vk::DeviceSize alignment )
+        -> utils::Result< vk::DeviceSize >;
+    auto retire_completed_batches( ) -> utils::Result< void >;
+    auto retire_oldest_batch( ) -> utils::Result< void >;
+    auto acquire_on_dst_queue( ) -> utils::Result< void >;
+};
+
+} // namespace ltb::vlk::objs
@@ -0,0 +1,97 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/vlk/command_buffer.hpp"
+#include "ltb/vlk/command_pool.hpp"
+#include "ltb/vlk/fence.hpp"
+#include "ltb/vlk/objs/vulkan_compute_pipeline.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+#include "ltb/vlk/query_pool.hpp"
+#include "ltb/vlk/queue_types.hpp"
+
+// standard
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace ltb::vlk::objs
+{
+
+struct VulkanWorkgroupTunerSettings
+{
+    /// \brief The fastest size of each kernel is stored here for every device and driver
+    ///        it has been tuned on, one tab separated "device, kernel, x y z" line each.
+    std::filesystem::path cache_file = "workgroup_sizes.txt";
+
+    /// \brief The queue the timed dispatches are submitted to.
+    QueueType queue_type = QueueType::Compute;
+
+    /// \brief Each candidate is timed this many times, after one warm up run, and its
+    ///        fastest run is kept.
+    uint32 iterations = 5U;
+};
+
+/// \brief Records the commands being timed, e.g. binding the pipeline and its descriptor
+///        sets and calling `VulkanComputePipeline::dispatch`.
+using RecordTuningDispatch
+    = std::function< utils::Result< void >( vk::CommandBuffer const&, VulkanComputePipeline& ) >;
+
+/// \brief Picks the fastest workgroup size of a compute pipeline on the current device by
+///        timing each candidate, and remembers the choice so later runs skip the timing.
+///        Timing waits for the GPU, so it belongs at startup.
+class VulkanWorkgroupTuner
+{
+public:
+    explicit( false ) VulkanWorkgroupTuner( VulkanGpu& gpu );
+
+    /// \brief Loads the sizes cached by earlier runs.
+    auto initialize( VulkanWorkgroupTunerSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Sets `pipeline` to the fastest of `candidates` and returns it. A size cached
+    ///        for `kernel_name` on this device is used without timing if it is still a
+    ///        candidate. Candidates the device does not support are skipped. The GPU must
+    ///        not be using `pipeline`, and `record` must leave its buffers in a state that
+    ///        can be recorded again.
+    auto tune(
+        std::string const&               kernel_name,
+        VulkanComputePipeline&           pipeline,
+        std::vector< glm::uvec3 > const& candidates,
+        RecordTuningDispatch const&      record
+    ) -> utils::Result< glm::uvec3 >;
+
+    /// \brief Writes the sizes of every device to `cache_file`.
+    auto save( ) const -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> VulkanWorkgroupTunerSettings const&;
+
+private:
+    VulkanGpu& gpu_;
+
+    VulkanWorkgroupTunerSettings settings_ = { };
+
+    // { device key: { kernel name: size } }
+    std::map< std::string, std::map< std::string, glm::uvec3 > > cache_      = { };
+    std::string                                                  device_key_ = { };
+
+    CommandPool   command_pool_   = { gpu_.device( ), gpu_.physical_device( ) };
+    CommandBuffer command_buffer_ = { gpu_.device( ), command_pool_ };
+    QueryPool     query_pool_     = { gpu_.device( ) };
+    Fence         fence_          = { gpu_.device( ) };
+
+    // Converts the valid bits of a timestamp difference to milliseconds.
+    uint64  timestamp_mask_ = 0U;
+    float64 ms_per_tick_    = 0.0;
+
+    auto time_dispatch( VulkanComputePipeline& pipeline, RecordTuningDispatch const& record )
+        -> utils::Result< float64 >;
+};
+
+} // namespace ltb::vlk::objs
@@ -11,7 +11,9 @@
 #include "ltb/vlk/vulkan.hpp"
 
 // standard
+#include <array>
 #include <set>
+#include <string_view>
 
 namespace ltb::vlk
 {
@@ -19,14 +21,35 @@ namespace ltb::vlk
 using PhysicalDeviceFeature            = vk::Bool32            vk::PhysicalDeviceFeatures::*;
 using PhysicalDeviceFeature2           = vk::Bool32           vk::PhysicalDeviceFeatures2::*;
 using PhysicalDeviceRobustness2Feature = vk::Bool32 vk::PhysicalDeviceRobustness2FeaturesEXT::*;
+using PhysicalDeviceVulkan12Feature    = vk::Bool32 vk::PhysicalDeviceVulkan12Features::*;
+
+/// \brief Descriptor indexing and buffer device address features needed to index one
+///        large update-after-bind descriptor array by integer handles, and to add to it
+///        while frames that use it are in flight.
+constexpr auto bindless_features = std::array< PhysicalDeviceVulkan12Feature, 8UZ >{
+    &vk::PhysicalDeviceVulkan12Features::runtimeDescriptorArray,
+    &vk::PhysicalDeviceVulkan12Features::descriptorBindingPartiallyBound,
+    &vk::PhysicalDeviceVulkan12Features::descriptorBindingStorageBufferUpdateAfterBind,
+    &vk::PhysicalDeviceVulkan12Features::descriptorBindingStorageImageUpdateAfterBind,
+    &vk::PhysicalDeviceVulkan12Features::descriptorBindingUpdateUnusedWhilePending,
+    &vk::PhysicalDeviceVulkan12Features::shaderStorageBufferArrayNonUniformIndexing,
+    &vk::PhysicalDeviceVulkan12Features::shaderStorageImageArrayNonUniformIndexing,
+    &vk::PhysicalDeviceVulkan12Features::bufferDeviceAddress,
+};
 
 struct DeviceSettings
 {
     std::vector< vk::QueueFlagBits > queue_flags = {
         vk::QueueFlagBits::eGraphics,
         vk::QueueFlagBits::eCompute,
+        vk::QueueFlagBits::eTransfer,
     };
 
+    /// \brief Use a compute family without graphics support when the device has one.
+    ///        Work on such a queue runs alongside rendering, but resources shared with
+    ///        graphics need queue family ownership transfers.
+    bool prefer_async_compute = false;
+
     std::vector< char const* > extensions = {
         VK_KHR_SWAPCHAIN_EXTENSION_NAME,
 #if defined( __APPLE__ )
@@ -36,6 +59,7 @@ struct DeviceSettings
 
     std::vector< char const* > optional_extensions = {
         VK_KHR_PRESENT_MODE_FIFO_LATEST_READY_EXTENSION_NAME,
+        VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
     };
 
     std::vector< PhysicalDeviceFeature > device_features = {
@@ -43,6 +67,14 @@ struct DeviceSettings
         &vk::PhysicalDeviceFeatures::fillModeNonSolid,
     };
 
+    /// \brief Enabled when the selected device supports them.
+    std::vector< PhysicalDeviceFeature > optional_device_features = {
+        &vk::PhysicalDeviceFeatures::pipelineStatisticsQuery,
+    };
+
+    /// \brief Enables the `bindless_features` when the selected device supports them all.
+    bool bindless = false;
+
     std::vector< vk::Format > preferred_depth_formats = {
         vk::Format::eD32Sfloat,
         vk::Format::eD32SfloatS8Uint,
@@ -72,6 +104,22 @@ public:
     [[nodiscard( "Const getter" )]]
     auto extensions( ) const -> std::vector< char const* > const&;
 
+    /// \brief True if `extension` was enabled when the device was selected.
+    [[nodiscard( "Const computation" )]]
+    auto has_extension( std::string_view extension ) const -> bool;
+
+    /// \brief The required features followed by the supported optional features.
+    [[nodiscard( "Const getter" )]]
+    auto device_features( ) const -> std::vector< PhysicalDeviceFeature > const&;
+
+    /// \brief True if `feature` was enabled when the device was selected.
+    [[nodiscard( "Const computation" )]]
+    auto has_feature( PhysicalDeviceFeature feature ) const -> bool;
+
+    /// \brief True if the `bindless_features` were requested and are supported.
+    [[nodiscard( "Const getter" )]]
+    auto has_bindless( ) const -> bool;
+
     [[nodiscard( "Const getter" )]]
     auto properties( ) const -> vk::PhysicalDeviceProperties const&;
 
@@ -93,13 +141,15 @@ public:
 private:
     Instance& instance_;
 
-    DeviceSettings               settings_              = { };
-    vk::PhysicalDevice           physical_device_       = { };
-    std::vector< char const* >   extensions_            = { };
-    vk::PhysicalDeviceProperties properties_            = { };
-    QueueFamilyMap               queue_families_        = { };
-    std::set< QueueIndex >       unique_queue_families_ = { };
-    vk::Format                   depth_image_format_    = vk::Format::eUndefined;
+    DeviceSettings                       settings_              = { };
+    vk::PhysicalDevice                   physical_device_       = { };
+    std::vector< char const* >           extensions_            = { };
+    std::vector< PhysicalDeviceFeature > device_features_       = { };
+    vk::PhysicalDeviceProperties         properties_            = { };
+    QueueFamilyMap                       queue_families_        = { };
+    std::set< QueueIndex >               unique_queue_families_ = { };
+    vk::Format                           depth_image_format_    = vk::Format::eUndefined;
+    bool                                 has_bindless_          = false;
 };
 
 } // namespace ltb::vlk
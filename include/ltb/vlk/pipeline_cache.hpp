@@ -0,0 +1,56 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/vulkan.hpp"
+
+// standard
+#include <filesystem>
+
+namespace ltb::vlk
+{
+
+struct PipelineCacheSettings
+{
+    /// \brief Where the cache is loaded from and saved to. An empty path keeps the cache in
+    ///        memory only.
+    std::filesystem::path file_path = "pipeline_cache.bin";
+};
+
+/// \brief A `vk::PipelineCache` that persists compiled pipelines between runs. Saved data is
+///        only reused by the same device and driver version, anything else starts empty.
+class PipelineCache
+{
+public:
+    explicit( false ) PipelineCache( Device& device );
+
+    auto initialize( PipelineCacheSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    /// \brief Writes the cache, including every pipeline created with it, to `file_path`.
+    auto save( ) const -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto get( ) const -> vk::PipelineCache const&;
+    auto get( ) -> vk::PipelineCache&;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> PipelineCacheSettings const&;
+
+private:
+    Device& device_;
+
+    PipelineCacheSettings   settings_       = { };
+    vk::UniquePipelineCache pipeline_cache_ = { };
+
+    auto load_initial_data( ) const -> std::vector< uint8 >;
+};
+
+} // namespace ltb::vlk
@@ -15,6 +15,8 @@ struct PipelineLayoutSettings
 {
     std::vector< vk::DescriptorSetLayout > descriptor_set_layouts = { };
     std::vector< vk::PushConstantRange >   push_constant_ranges   = { };
+
+    auto operator==( PipelineLayoutSettings const& ) const -> bool = default;
 };
 
 class PipelineLayout
@@ -24,6 +26,10 @@ public:
 
     auto initialize( PipelineLayoutSettings settings ) -> utils::Result< void >;
 
+    /// \brief Shares the layout `cache` holds for equal settings instead of owning one.
+    auto initialize( PipelineLayoutSettings settings, ObjectCache& cache )
+        -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
@@ -34,8 +40,11 @@ public:
 private:
     Device& device_;
 
-    PipelineLayoutSettings   settings_        = { };
-    vk::UniquePipelineLayout pipeline_layout_ = { };
+    PipelineLayoutSettings settings_        = { };
+    vk::PipelineLayout     pipeline_layout_ = { };
+
+    // Empty when the layout is shared from an `ObjectCache`.
+    vk::UniquePipelineLayout owned_layout_ = { };
 };
 
 template < typename PushConstantType >
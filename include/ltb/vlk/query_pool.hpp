@@ -0,0 +1,48 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/vulkan.hpp"
+
+namespace ltb::vlk
+{
+
+struct QueryPoolSettings
+{
+    vk::QueryType query_type  = vk::QueryType::eTimestamp;
+    uint32        query_count = 0U;
+
+    /// \brief The counters recorded by `vk::QueryType::ePipelineStatistics` queries.
+    vk::QueryPipelineStatisticFlags pipeline_statistics = { };
+};
+
+class QueryPool
+{
+public:
+    explicit( false ) QueryPool( Device& device );
+
+    auto initialize( QueryPoolSettings settings ) -> utils::Result< void >;
+
+    [[nodiscard( "Const getter" )]]
+    auto is_initialized( ) const -> bool;
+
+    [[nodiscard( "Const getter" )]]
+    auto settings( ) const -> QueryPoolSettings const&;
+
+    [[nodiscard( "Const getter" )]]
+    auto get( ) const -> vk::QueryPool const&;
+    auto get( ) -> vk::QueryPool&;
+
+private:
+    Device& device_;
+
+    QueryPoolSettings   settings_   = { };
+    vk::UniqueQueryPool query_pool_ = { };
+};
+
+} // namespace ltb::vlk
@@ -29,21 +29,25 @@ using QueueIndex     = uint32;
 using QueueFamilyMap = std::unordered_map< QueueType, QueueIndex >;
 using QueueMap       = std::unordered_map< QueueType, vk::Queue >;
 
+/// \brief When `prefer_async_compute` is set the compute family is one without graphics
+///        support if the device has one, so compute work can overlap with rendering.
 auto build_queue_family_map(
     vk::PhysicalDevice const&               physical_device,
     std::vector< vk::QueueFlagBits > const& types,
-    vk::SurfaceKHR const&                   surface
+    vk::SurfaceKHR const&                   surface,
+    bool                                    prefer_async_compute
 ) -> utils::Result< QueueFamilyMap >;
 
 struct BuildQueueFamilyMap
 {
     std::vector< vk::QueueFlagBits > const& types;
     vk::SurfaceKHR const&                   surface;
+    bool                                    prefer_async_compute = false;
 
     auto operator( )( vk::PhysicalDevice const& physical_device ) const
         -> utils::Result< QueueFamilyMap >
     {
-        return build_queue_family_map( physical_device, types, surface );
+        return build_queue_family_map( physical_device, types, surface, prefer_async_compute );
     }
 };
 
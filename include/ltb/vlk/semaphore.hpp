@@ -5,6 +5,7 @@
 
 // project
 #include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
 #include "ltb/vlk/fwd.hpp"
 #include "ltb/vlk/vulkan.hpp"
 
@@ -14,6 +15,10 @@ namespace ltb::vlk
 struct SemaphoreSettings
 {
     vk::SemaphoreCreateFlags flags = { };
+
+    /// \brief Timeline semaphores hold a 64-bit counter that only ever increases.
+    vk::SemaphoreType type          = vk::SemaphoreType::eBinary;
+    uint64            initial_value = 0U;
 };
 
 class Semaphore
@@ -5,20 +5,39 @@
 
 // project
 #include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
 #include "ltb/vlk/fwd.hpp"
+#include "ltb/vlk/shader_reflection.hpp"
 #include "ltb/vlk/vulkan.hpp"
 
 // standard
 #include <filesystem>
+#include <span>
+#include <vector>
 
 namespace ltb::vlk
 {
 
+/// \brief Sets the 32-bit specialization constant declared with `constant_id`.
+struct SpecializationConstant
+{
+    uint32 constant_id = 0U;
+    uint32 value       = 0U;
+};
+
 struct ShaderModuleSettings
 {
-    std::filesystem::path   spirv_file = { };
-    vk::ShaderStageFlagBits stage      = { };
-    char const*             name       = "main";
+    std::filesystem::path spirv_file = { };
+
+    /// \brief Used instead of reading `spirv_file` when not empty. Must outlive the
+    ///        call to `initialize`.
+    std::span< uint32 const > spirv_code = { };
+
+    vk::ShaderStageFlagBits stage = { };
+    char const*             name  = "main";
+
+    /// \brief Applied to every pipeline created from the module.
+    std::vector< SpecializationConstant > specialization_constants = { };
 };
 
 class ShaderModule
@@ -28,6 +47,11 @@ public:
 
     auto initialize( ShaderModuleSettings settings ) -> utils::Result< void >;
 
+    /// \brief Recreates the module from `spirv_file`, ignoring any embedded code. Pipelines
+    ///        created from the old module stay valid. Fails, keeping the old module, if the
+    ///        new code would need different layouts.
+    auto reload( ) -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
@@ -38,6 +62,15 @@ public:
     [[nodiscard( "Const getter" )]]
     auto settings( ) const -> ShaderModuleSettings const&;
 
+    /// \brief The interface declared by the module's SPIR-V.
+    [[nodiscard( "Const getter" )]]
+    auto reflection( ) const -> ShaderReflection const&;
+
+    /// \brief Replaces the specialization constants. Only pipelines created afterwards use
+    ///        the new values.
+    auto set_specialization_constants( std::vector< SpecializationConstant > constants )
+        -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto get_shader_stage_create_info( ) const -> vk::PipelineShaderStageCreateInfo;
 
@@ -45,7 +78,13 @@ private:
     Device& device_;
 
     ShaderModuleSettings   settings_      = { };
+    ShaderReflection       reflection_    = { };
     vk::UniqueShaderModule shader_module_ = { };
+
+    // The constants laid out for `vk::SpecializationInfo`, which points into these vectors.
+    std::vector< vk::SpecializationMapEntry > specialization_entries_ = { };
+    std::vector< uint32 >                     specialization_data_    = { };
+    vk::SpecializationInfo                    specialization_info_    = { };
 };
 
 struct GetShaderStageCreateInfo
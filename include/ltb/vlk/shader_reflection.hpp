@@ -0,0 +1,100 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// project
+#include "ltb/utils/result.hpp"
+#include "ltb/utils/types.hpp"
+#include "ltb/vlk/vulkan.hpp"
+
+// standard
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace ltb::vlk
+{
+
+/// \brief Identifies a binding in the descriptor set layouts of a pipeline.
+struct DescriptorSlot
+{
+    uint32 set     = 0U;
+    uint32 binding = 0U;
+
+    auto operator==( DescriptorSlot const& ) const -> bool = default;
+};
+
+struct ReflectedDescriptor
+{
+    DescriptorSlot     slot = { };
+    vk::DescriptorType type = { };
+
+    /// \brief Zero for runtime sized arrays.
+    uint32 count = 1U;
+
+    auto operator==( ReflectedDescriptor const& ) const -> bool = default;
+};
+
+struct ReflectedVertexInput
+{
+    uint32 location = 0U;
+
+    /// \brief `vk::Format::eUndefined` for types that have no matching vertex format.
+    vk::Format format = vk::Format::eUndefined;
+
+    auto operator==( ReflectedVertexInput const& ) const -> bool = default;
+};
+
+/// \brief The interface a shader declares in its SPIR-V.
+struct ShaderReflection
+{
+    vk::ShaderStageFlagBits stage = { };
+
+    /// \brief Sorted by set, then binding.
+    std::vector< ReflectedDescriptor > descriptors = { };
+
+    /// \brief Covers the members of the push constant block, if there is one.
+    std::optional< vk::PushConstantRange > push_constants = std::nullopt;
+
+    /// \brief Only filled for vertex shaders. Sorted by location.
+    std::vector< ReflectedVertexInput > vertex_inputs = { };
+
+    /// \brief True when `other` needs the same descriptor set and pipeline layouts.
+    [[nodiscard( "Const computation" )]]
+    auto has_same_layout( ShaderReflection const& other ) const -> bool;
+};
+
+/// \brief Reads the descriptors, push constants and vertex inputs declared by `code`.
+auto reflect_spirv( std::span< uint32 const > code, vk::ShaderStageFlagBits stage )
+    -> utils::Result< ShaderReflection >;
+
+struct ReflectedPipelineLayout
+{
+    /// \brief Indexed by set. Sets the shaders skip are left empty. Runtime sized arrays
+    ///        have a count of zero (see `check_descriptor_counts`).
+    std::vector< std::vector< vk::DescriptorSetLayoutBinding > > binding_sets = { };
+
+    std::vector< vk::PushConstantRange > push_constant_ranges = { };
+};
+
+/// \brief Merges the interfaces of every stage of a pipeline. A binding used by several
+///        stages must be declared the same way in each. Uniform and storage buffers at
+///        `dynamic_buffers` are made dynamic, since their offsets are the application's
+///        choice and not visible in the SPIR-V.
+auto reflect_pipeline_layout(
+    std::span< ShaderReflection const > stages,
+    std::span< DescriptorSlot const >   dynamic_buffers
+) -> utils::Result< ReflectedPipelineLayout >;
+
+/// \brief Fails if `bindings` has a runtime sized array, which only the application can size.
+auto check_descriptor_counts( std::span< vk::DescriptorSetLayoutBinding const > bindings )
+    -> utils::Result< void >;
+
+/// \brief Fails if an input of `reflection` is not fed by one of `attributes`.
+auto check_vertex_inputs(
+    ShaderReflection const&                                reflection,
+    std::span< vk::VertexInputAttributeDescription const > attributes
+) -> utils::Result< void >;
+
+} // namespace ltb::vlk
@@ -27,9 +27,12 @@ auto run_update_loop(
     exec::UpdateLoopStatus status
 ) -> utils::Result< void >
 {
-    LTB_CHECK( glfw.initialize( ) );
-    LTB_CHECK( window.initialize( ) );
-    LTB_CHECK( status, app.initialize( ) );
+    {
+        LTB_PROFILE_ZONE( "initialize" );
+        LTB_CHECK( glfw.initialize( ) );
+        LTB_CHECK( window.initialize( ) );
+        LTB_CHECK( status, app.initialize( ) );
+    }
 
     auto internal_state = exec::InternalLoopState{ status.update_time_step };
 
@@ -0,0 +1,44 @@
+#version 460
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(buffer_reference, std430, buffer_reference_align = 8) readonly buffer Positions
+{
+    vec2 values[];
+};
+
+struct MeshRecord
+{
+    mat3      world_from_local;
+    vec4      color;
+    Positions positions;
+};
+
+layout(set = 0, binding = 0) uniform CameraUniforms
+{
+    mat4 clip_from_world;
+} camera;
+
+// Every storage buffer in the bindless table. Only the mesh records are read here.
+layout(set = 1, binding = 0, std430) readonly buffer MeshRecords
+{
+    MeshRecord records[];
+} storage_buffers[];
+
+layout(push_constant) uniform BindlessUniforms
+{
+    uint mesh_records;
+} bindless;
+
+layout(location = 0) flat out vec4 out_color;
+
+void main()
+{
+    // Each draw selects its mesh with the first instance.
+    MeshRecord mesh = storage_buffers[bindless.mesh_records].records[gl_InstanceIndex];
+
+    vec2 local_position = mesh.positions.values[gl_VertexIndex];
+    vec3 world_position = mesh.world_from_local * vec3(local_position, 1.0F);
+    gl_Position         = camera.clip_from_world * vec4(world_position, 1.0F);
+    out_color           = mesh.color;
+}
@@ -4,11 +4,10 @@
 #include "app.hpp"
 
 // project
-#include "ltb/exec/app_defaults.hpp"
 #include "ltb/vlk/buffer_utils.hpp"
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device_memory_utils.hpp"
-#include "ltb/vlk/ltb_vlk_config.hpp"
+#include "ltb/vlk/embedded_spirv.hpp"
 
 // external
 #include "ltb/window/glfw_context.hpp"
@@ -153,9 +152,14 @@ auto update_camera_uniforms( vk::Extent2D const& extent )
 
 } // namespace
 
-ApiApp::ApiApp( window::GlfwContext& glfw_context, window::GlfwWindow& glfw_window )
+ApiApp::ApiApp(
+    window::GlfwContext& glfw_context,
+    window::GlfwWindow&  glfw_window,
+    exec::AppSettings    app_settings
+)
     : glfw_context_( glfw_context )
     , glfw_window_( glfw_window )
+    , app_settings_( std::move( app_settings ) )
 {
 }
 
@@ -222,6 +226,7 @@ auto ApiApp::on_resize( glm::ivec2 const size ) -> utils::Result< void >
 auto ApiApp::clean_up( ) -> utils::Result< void >
 {
     VK_CHECK( gpu_.device.get( ).waitIdle( ) );
+    LTB_CHECK( gpu_.pipeline_cache.save( ) );
 
     return utils::success( );
 }
@@ -242,7 +247,8 @@ auto ApiApp::initialize_vulkan( ) -> utils::Result< ApiApp* >
     LTB_CHECK_VALID( gpu_.device.queues( ).contains( vlk::QueueType::Surface ) );
     gpu_.present_queue = gpu_.device.queues( ).at( vlk::QueueType::Surface );
 
-    LTB_CHECK( gpu_.descriptor_pool.initialize( { } ) );
+    LTB_CHECK( gpu_.descriptor_allocator.initialize( { } ) );
+    LTB_CHECK( gpu_.pipeline_cache.initialize( { } ) );
 
     return this;
 }
@@ -346,19 +352,19 @@ auto ApiApp::initialize_swapchain( ) -> utils::Result< ApiApp* >
 auto ApiApp::initialize_graphics( ) -> utils::Result< ApiApp* >
 {
     LTB_CHECK_VALID( gpu_.device.is_initialized( ) );
-    LTB_CHECK_VALID( gpu_.descriptor_pool.is_initialized( ) );
+    LTB_CHECK_VALID( gpu_.descriptor_allocator.is_initialized( ) );
     LTB_CHECK_VALID( present_.render_pass.is_initialized( ) );
 
     LTB_CHECK( graphics_.shader_modules.emplace_back( gpu_.device )
-                   .initialize( {
-                       .spirv_file = vlk::config::shader_dir_path( ) / "tutorial.vert.spv",
-                       .stage      = vk::ShaderStageFlagBits::eVertex,
-                   } ) );
+                   .initialize( vlk::shader_module_settings(
+                       "tutorial.vert.spv",
+                       vk::ShaderStageFlagBits::eVertex
+                   ) ) );
     LTB_CHECK( graphics_.shader_modules.emplace_back( gpu_.device )
-                   .initialize( {
-                       .spirv_file = vlk::config::shader_dir_path( ) / "tutorial.frag.spv",
-                       .stage      = vk::ShaderStageFlagBits::eFragment,
-                   } ) );
+                   .initialize( vlk::shader_module_settings(
+                       "tutorial.frag.spv",
+                       vk::ShaderStageFlagBits::eFragment
+                   ) ) );
 
     LTB_CHECK( graphics_.descriptor_set_layout.initialize( {
         .bindings = {
@@ -372,7 +378,7 @@ auto ApiApp::initialize_graphics( ) -> utils::Result< ApiApp* >
 
     LTB_CHECK( graphics_.descriptor_sets.initialize( {
         .layouts = {
-            exec::max_frames_in_flight,
+            app_settings_.frames_in_flight,
             graphics_.descriptor_set_layout.get( ),
         },
     } ) );
@@ -436,7 +442,7 @@ auto ApiApp::initialize_command_and_sync( ) -> utils::Result< ApiApp* >
         .queue_type = vlk::QueueType::Graphics,
     } ) );
 
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
+    for ( auto frame_index = 0U; frame_index < app_settings_.frames_in_flight; ++frame_index )
     {
         LTB_CHECK( cmd_and_sync_.command_buffers
                        .emplace_back( gpu_.device, cmd_and_sync_.command_pool )
@@ -460,8 +466,8 @@ auto ApiApp::initialize_command_and_sync( ) -> utils::Result< ApiApp* >
 
 auto ApiApp::initialize_camera_buffers( ) -> utils::Result< ApiApp* >
 {
-    camera_uniform_.layout.ranges.reserve( exec::max_frames_in_flight );
-    for ( auto i = 0U; i < exec::max_frames_in_flight; ++i )
+    camera_uniform_.layout.ranges.reserve( app_settings_.frames_in_flight );
+    for ( auto i = 0U; i < app_settings_.frames_in_flight; ++i )
     {
         camera_uniform_.layout.ranges.push_back( {
             .size   = sizeof( CameraBufferObject ),
@@ -503,7 +509,7 @@ auto ApiApp::initialize_camera_buffers( ) -> utils::Result< ApiApp* >
     );
 
     auto const& descriptor_sets = graphics_.descriptor_sets.get( );
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
+    for ( auto frame_index = 0U; frame_index < app_settings_.frames_in_flight; ++frame_index )
     {
         LTB_CHECK_VALID( frame_index < camera_uniform_.layout.ranges.size( ) );
         LTB_CHECK_VALID( frame_index < descriptor_sets.size( ) );
@@ -535,7 +541,7 @@ auto ApiApp::set_camera_buffers( ) -> utils::Result< ApiApp* >
 {
     auto const ubo = update_camera_uniforms( present_.swapchain.settings( ).extent );
 
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
+    for ( auto frame_index = 0U; frame_index < app_settings_.frames_in_flight; ++frame_index )
     {
         LTB_CHECK_VALID( frame_index < camera_uniform_.layout.ranges.size( ) );
         auto const& memory_range = camera_uniform_.layout.ranges[ frame_index ];
@@ -717,7 +723,7 @@ auto ApiApp::render( ) -> utils::Result< void >
     }
 
     cmd_and_sync_.current_frame_index
-        = ( cmd_and_sync_.current_frame_index + 1U ) % exec::max_frames_in_flight;
+        = ( cmd_and_sync_.current_frame_index + 1U ) % app_settings_.frames_in_flight;
 
     return utils::success( );
 }
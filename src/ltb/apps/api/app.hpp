@@ -4,12 +4,13 @@
 #pragma once
 
 // project
+#include "ltb/exec/app_settings.hpp"
 #include "ltb/exec/update_loop.hpp"
 #include "ltb/utils/timers.hpp"
 #include "ltb/vlk/buffer.hpp"
 #include "ltb/vlk/command_buffer.hpp"
 #include "ltb/vlk/command_pool.hpp"
-#include "ltb/vlk/descriptor_pool.hpp"
+#include "ltb/vlk/descriptor_allocator.hpp"
 #include "ltb/vlk/descriptor_set_layout.hpp"
 #include "ltb/vlk/descriptor_sets.hpp"
 #include "ltb/vlk/device.hpp"
@@ -21,6 +22,7 @@
 #include "ltb/vlk/image_view.hpp"
 #include "ltb/vlk/instance.hpp"
 #include "ltb/vlk/physical_device.hpp"
+#include "ltb/vlk/pipeline_cache.hpp"
 #include "ltb/vlk/pipeline_layout.hpp"
 #include "ltb/vlk/render_pass.hpp"
 #include "ltb/vlk/semaphore.hpp"
@@ -36,7 +38,11 @@ class ApiApp
 
 {
 public:
-    explicit ApiApp( window::GlfwContext& glfw_context, window::GlfwWindow& glfw_window );
+    explicit ApiApp(
+        window::GlfwContext& glfw_context,
+        window::GlfwWindow&  glfw_window,
+        exec::AppSettings    app_settings
+    );
 
     auto initialize( ) -> utils::Result< exec::UpdateLoopStatus >;
 
@@ -52,6 +58,7 @@ public:
 private:
     window::GlfwContext& glfw_context_;
     window::GlfwWindow&  glfw_window_;
+    exec::AppSettings    app_settings_;
 
     struct VulkanSurfaceGpu
     {
@@ -65,7 +72,8 @@ private:
         vk::Queue graphics_queue = nullptr;
         vk::Queue present_queue  = nullptr;
 
-        vlk::DescriptorPool descriptor_pool = { device };
+        vlk::DescriptorAllocator descriptor_allocator = { device };
+        vlk::PipelineCache       pipeline_cache       = { device };
 
     } gpu_ = { *this };
 
@@ -100,12 +108,13 @@ private:
         vlk::DescriptorSetLayout descriptor_set_layout = { self.gpu_.device };
         vlk::DescriptorSets      descriptor_sets       = {
             self.gpu_.device,
-            self.gpu_.descriptor_pool,
+            self.gpu_.descriptor_allocator,
         };
 
         vlk::PipelineLayout   pipeline_layout = { self.gpu_.device };
         vlk::GraphicsPipeline pipeline        = {
             self.gpu_.device,
+            self.gpu_.pipeline_cache,
             self.present_.render_pass,
             shader_modules,
             pipeline_layout,
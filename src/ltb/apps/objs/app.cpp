@@ -4,7 +4,6 @@
 #include "app.hpp"
 
 // project
-#include "ltb/exec/app_defaults.hpp"
 #include "ltb/vlk/ltb_vlk_config.hpp"
 #include "ltb/vlk/buffer_utils.hpp"
 #include "ltb/vlk/check.hpp"
@@ -62,9 +61,14 @@ auto update_camera_uniforms( vk::Extent2D const& extent )
 
 } // namespace
 
-ObjsApp::ObjsApp( window::GlfwContext& glfw_context, window::GlfwWindow& glfw_window )
+ObjsApp::ObjsApp(
+    window::GlfwContext& glfw_context,
+    window::GlfwWindow&  glfw_window,
+    exec::AppSettings    app_settings
+)
     : glfw_context_( glfw_context )
     , glfw_window_( glfw_window )
+    , app_settings_( std::move( app_settings ) )
 {
 }
 
@@ -130,6 +134,7 @@ auto ObjsApp::on_resize( glm::ivec2 const size ) -> utils::Result< void >
 auto ObjsApp::clean_up( ) -> utils::Result< void >
 {
     VK_CHECK( gpu_.device( ).get( ).waitIdle( ) );
+    LTB_CHECK( gpu_.pipeline_cache( ).save( ) );
 
     return utils::success( );
 }
@@ -155,7 +160,7 @@ auto ObjsApp::initialize_camera_buffers( ) -> utils::Result< ObjsApp* >
     vlk::append_memory_size_n(
         camera_buffer_layout,
         sizeof( cam::CameraRenderParams ),
-        exec::max_frames_in_flight
+        app_settings_.frames_in_flight
     );
 
     LTB_CHECK( camera_ubo_.initialize( {
@@ -164,6 +169,7 @@ auto ObjsApp::initialize_camera_buffers( ) -> utils::Result< ObjsApp* >
         .memory_properties
         = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
         .store_mapped_value = true,
+        .tag                = "camera uniforms",
     } ) );
 
     return this;
@@ -172,7 +178,7 @@ auto ObjsApp::initialize_camera_buffers( ) -> utils::Result< ObjsApp* >
 auto ObjsApp::initialize_graphics( ) -> utils::Result< ObjsApp* >
 {
     LTB_CHECK( graphics_.initialize( {
-        .frame_count = exec::max_frames_in_flight,
+        .frame_count = app_settings_.frames_in_flight,
         .camera_ubo  = camera_ubo_,
     } ) );
 
@@ -182,13 +188,18 @@ auto ObjsApp::initialize_graphics( ) -> utils::Result< ObjsApp* >
 auto ObjsApp::initialize_command_and_sync( ) -> utils::Result< ObjsApp* >
 {
     LTB_CHECK( cmd_and_sync_.initialize( {
-        .frame_count  = exec::max_frames_in_flight,
+        .frame_count  = app_settings_.frames_in_flight,
         .image_count  = static_cast< uint32 >( presentation_.swapchain( ).images( ).size( ) ),
         .command_pool = {
             .queue_type = vlk::QueueType::Graphics,
         },
     } ) );
 
+    LTB_CHECK( recorder_.initialize( {
+        .frame_count = app_settings_.frames_in_flight,
+        .queue_type  = vlk::QueueType::Graphics,
+    } ) );
+
     return this;
 }
 
@@ -196,7 +207,7 @@ auto ObjsApp::set_camera_buffers( ) -> utils::Result< ObjsApp* >
 {
     auto const ubo = update_camera_uniforms( presentation_.swapchain( ).settings( ).extent );
 
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
+    for ( auto frame_index = 0U; frame_index < app_settings_.frames_in_flight; ++frame_index )
     {
         LTB_CHECK_VALID( frame_index < camera_ubo_.layout( ).ranges.size( ) );
         auto const& memory_range = camera_ubo_.layout( ).ranges[ frame_index ];
@@ -242,14 +253,16 @@ auto ObjsApp::initialize_vertex_buffer( ) -> utils::Result< ObjsApp* >
         .indices = { 0U, 1U, 2U, 2U, 3U, 0U },
     };
 
-    LTB_CHECK(
-        top_model_uniforms_,
-        graphics_.initialize_mesh( top_mesh, cmd_and_sync_.command_pool( ), graphics_queue_ )
-    );
-    LTB_CHECK(
-        bottom_model_uniforms_,
-        graphics_.initialize_mesh( bottom_mesh, cmd_and_sync_.command_pool( ), graphics_queue_ )
-    );
+    LTB_CHECK( uploader_.initialize( {
+        .queue_type     = vlk::QueueType::Transfer,
+        .dst_queue_type = vlk::QueueType::Graphics,
+    } ) );
+
+    LTB_CHECK( top_model_uniforms_, graphics_.initialize_mesh( top_mesh, uploader_ ) );
+    LTB_CHECK( bottom_model_uniforms_, graphics_.initialize_mesh( bottom_mesh, uploader_ ) );
+
+    // The meshes are drawn on the first frame so they have to be resident before then.
+    LTB_CHECK( uploader_.wait( ) );
 
     return this;
 }
@@ -262,8 +275,9 @@ auto ObjsApp::render( ) -> utils::Result< void >
     {
         auto const& frame = maybe_frame.value( );
 
+        LTB_CHECK( recorder_.start_frame( frame ) );
         LTB_CHECK( this->record_render_commands( frame ) );
-        LTB_CHECK( cmd_and_sync_.end_frame( frame, graphics_queue_ ) );
+        LTB_CHECK( cmd_and_sync_.end_frame( frame, upload_waits_, graphics_queue_ ) );
         LTB_CHECK(
             cmd_and_sync_.present_frame( frame, presentation_.swapchain( ), present_queue_ )
         );
@@ -275,17 +289,18 @@ auto ObjsApp::record_render_commands( vlk::objs::FrameInfo const& frame ) -> uti
 {
     VK_CHECK( frame.command_buffer.begin( vk::CommandBufferBeginInfo{ } ) );
 
+    // Take ownership of anything that finished uploading since the last frame.
+    LTB_CHECK( upload_waits_, uploader_.acquire( frame.command_buffer ) );
+
     LTB_CHECK( presentation_.begin_render_pass( {
         .command_buffer    = frame.command_buffer,
         .image_index       = frame.image_index,
         .color_clear_value = { 0.35F, 0.35F, 0.35F, 1.0F },
+        .subpass_contents  = vk::SubpassContents::eSecondaryCommandBuffers,
     } ) );
 
-    graphics_.pipeline( ).bind( frame.command_buffer );
-
-    LTB_CHECK( graphics_.pipeline( ).bind_descriptor_sets( frame ) );
-
-    LTB_CHECK( graphics_.draw_meshes( frame ) );
+    // The meshes are recorded into secondary command buffers on worker threads.
+    LTB_CHECK( graphics_.draw_meshes( frame, recorder_ ) );
 
     frame.command_buffer.endRenderPass( );
 
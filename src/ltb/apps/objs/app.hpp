@@ -5,9 +5,12 @@
 
 // project
 #include "app_pipeline.hpp"
+#include "ltb/exec/app_settings.hpp"
 #include "ltb/exec/update_loop.hpp"
 #include "ltb/vlk/objs/vulkan_buffer.hpp"
 #include "ltb/vlk/objs/vulkan_command_and_sync.hpp"
+#include "ltb/vlk/objs/vulkan_parallel_recorder.hpp"
+#include "ltb/vlk/objs/vulkan_uploader.hpp"
 #include "ltb/window/fwd.hpp"
 
 namespace ltb
@@ -17,7 +20,11 @@ class ObjsApp
 
 {
 public:
-    explicit ObjsApp( window::GlfwContext& glfw_context, window::GlfwWindow& glfw_window );
+    explicit ObjsApp(
+        window::GlfwContext& glfw_context,
+        window::GlfwWindow&  glfw_window,
+        exec::AppSettings    app_settings
+    );
 
     auto initialize( ) -> utils::Result< exec::UpdateLoopStatus >;
 
@@ -33,19 +40,24 @@ public:
 private:
     window::GlfwContext& glfw_context_;
     window::GlfwWindow&  glfw_window_;
+    exec::AppSettings    app_settings_;
 
     vlk::objs::VulkanGpu          gpu_            = { glfw_context_, glfw_window_ };
     vk::Queue                     graphics_queue_ = nullptr;
     vk::Queue                     present_queue_  = nullptr;
     vlk::objs::VulkanPresentation presentation_   = { gpu_ };
 
-    vlk::objs::VulkanBuffer         camera_ubo_   = { gpu_ };
-    ObjsAppPipeline                 graphics_     = { gpu_, presentation_ };
-    vlk::objs::VulkanCommandAndSync cmd_and_sync_ = { gpu_ };
+    vlk::objs::VulkanBuffer           camera_ubo_   = { gpu_ };
+    ObjsAppPipeline                   graphics_     = { gpu_, presentation_ };
+    vlk::objs::VulkanCommandAndSync   cmd_and_sync_ = { gpu_ };
+    vlk::objs::VulkanParallelRecorder recorder_     = { gpu_ };
+    vlk::objs::VulkanUploader         uploader_     = { gpu_ };
 
     ObjsAppPipeline::MeshPushConstants* top_model_uniforms_    = nullptr;
     ObjsAppPipeline::MeshPushConstants* bottom_model_uniforms_ = nullptr;
 
+    std::vector< vlk::objs::SemaphoreAndStage > upload_waits_ = { };
+
     bool initialized_ = false;
 
     auto initialize_gpu_presentation( ) -> utils::Result< ObjsApp* >;
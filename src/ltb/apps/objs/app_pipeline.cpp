@@ -4,16 +4,21 @@
 #include "app_pipeline.hpp"
 
 // project
-#include "ltb/vlk/ltb_vlk_config.hpp"
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device_memory_utils.hpp"
+#include "ltb/vlk/embedded_spirv.hpp"
 #include "ltb/vlk/objs/frame_info.hpp"
+#include "ltb/vlk/objs/vulkan_parallel_recorder.hpp"
+#include "ltb/vlk/objs/vulkan_presentation.hpp"
+#include "ltb/vlk/objs/vulkan_uploader.hpp"
 
 // external
-#include "ltb/vlk/command_pool.hpp"
 #include <range/v3/range/conversion.hpp>
 #include <spdlog/spdlog.h>
 
+// standard
+#include <array>
+
 namespace ltb
 {
 
@@ -33,29 +38,8 @@ auto ObjsAppPipeline::initialize( ObjsAppPipelineSettings settings ) -> utils::R
         return utils::success( );
     }
     auto shader_modules = std::vector< vlk::ShaderModuleSettings >{
-        {
-            .spirv_file = vlk::config::shader_dir_path( ) / "tutorial.vert.spv",
-            .stage      = vk::ShaderStageFlagBits::eVertex,
-        },
-        {
-            .spirv_file = vlk::config::shader_dir_path( ) / "tutorial.frag.spv",
-            .stage      = vk::ShaderStageFlagBits::eFragment,
-        },
-    };
-
-    auto uniform_bindings = std::vector{
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 0U )
-            .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eVertex ),
-    };
-
-    auto uniform_push_constants = std::vector{
-        vk::PushConstantRange{ }
-            .setStageFlags( vk::ShaderStageFlagBits::eVertex )
-            .setOffset( 0U )
-            .setSize( sizeof( MeshPushConstants ) ),
+        vlk::shader_module_settings( "tutorial.vert.spv", vk::ShaderStageFlagBits::eVertex ),
+        vlk::shader_module_settings( "tutorial.frag.spv", vk::ShaderStageFlagBits::eFragment ),
     };
 
     auto vertex_bindings = std::vector{
@@ -83,10 +67,8 @@ auto ObjsAppPipeline::initialize( ObjsAppPipelineSettings settings ) -> utils::R
     };
 
     LTB_CHECK( pipeline_.initialize( {
-        .shader_modules         = std::move( shader_modules ),
-        .descriptor_set_count   = settings.frame_count,
-        .uniform_binding_sets   = { std::move( uniform_bindings ) },
-        .uniform_push_constants = std::move( uniform_push_constants ),
+        .shader_modules       = std::move( shader_modules ),
+        .descriptor_set_count = settings.frame_count,
 
         .pipeline = {
             .vertex_bindings    = std::move( vertex_bindings ),
@@ -96,31 +78,23 @@ auto ObjsAppPipeline::initialize( ObjsAppPipelineSettings settings ) -> utils::R
     } ) );
     LTB_CHECK_VALID( 1UZ == pipeline_.descriptor_sets( ).size( ) );
 
-    auto const& descriptor_sets = pipeline_.descriptor_sets( ).front( ).get( );
-    auto const  frame_count     = settings.frame_count;
+    auto&      descriptor_sets = pipeline_.descriptor_sets( ).front( );
+    auto const frame_count     = settings.frame_count;
     for ( auto frame_index = 0U; frame_index < frame_count; ++frame_index )
     {
         LTB_CHECK_VALID( frame_index < settings.camera_ubo.layout( ).ranges.size( ) );
-        LTB_CHECK_VALID( frame_index < descriptor_sets.size( ) );
-
-        auto const& memory_range   = settings.camera_ubo.layout( ).ranges[ frame_index ];
-        auto const& descriptor_set = descriptor_sets[ frame_index ];
-
-        auto const descriptor_buffer_info = vk::DescriptorBufferInfo{ }
-                                                .setBuffer( settings.camera_ubo.buffer( ).get( ) )
-                                                .setOffset( memory_range.offset )
-                                                .setRange( memory_range.size );
-
-        auto const descriptor_writes = std::vector{
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 0U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-                .setBufferInfo( descriptor_buffer_info ),
-        };
 
-        gpu_.device( ).get( ).updateDescriptorSets( descriptor_writes, { } );
+        auto const& memory_range = settings.camera_ubo.layout( ).ranges[ frame_index ];
+
+        auto const descriptors = std::array{
+            vlk::DescriptorInfo{
+                .buffer = vk::DescriptorBufferInfo{ }
+                              .setBuffer( settings.camera_ubo.buffer( ).get( ) )
+                              .setOffset( memory_range.offset )
+                              .setRange( memory_range.size ),
+            },
+        };
+        LTB_CHECK( descriptor_sets.update( frame_index, descriptors ) );
     }
 
     initialized_ = true;
@@ -134,12 +108,11 @@ auto ObjsAppPipeline::is_initialized( ) const -> bool
 }
 
 auto ObjsAppPipeline::initialize_mesh(
-    TriangleMesh const& mesh,
-    vlk::CommandPool&   command_pool,
-    vk::Queue const&    queue
+    TriangleMesh const&        mesh,
+    vlk::objs::VulkanUploader& uploader
 ) -> utils::Result< MeshPushConstants* >
 {
-    LTB_CHECK_VALID( command_pool.is_initialized( ) );
+    LTB_CHECK_VALID( uploader.is_initialized( ) );
     LTB_CHECK_VALID( !mesh.positions.empty( ) );
     LTB_CHECK_VALID( mesh.positions.size( ) == mesh.colors.size( ) );
     LTB_CHECK_VALID( !mesh.indices.empty( ) );
@@ -158,16 +131,7 @@ auto ObjsAppPipeline::initialize_mesh(
                       | vk::BufferUsageFlagBits::eTransferDst,
         .memory_properties  = vk::MemoryPropertyFlagBits::eDeviceLocal,
         .store_mapped_value = false,
-    } ) );
-
-    auto staging_vbo = vlk::objs::VulkanBuffer{ gpu_ };
-
-    LTB_CHECK( staging_vbo.initialize( {
-        .layout       = mesh_data.vbo.layout( ),
-        .buffer_usage = vk::BufferUsageFlagBits::eTransferSrc,
-        .memory_properties
-        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-        .store_mapped_value = false,
+        .tag                = "meshes",
     } ) );
 
     auto const host_data = std::array< void const*, 3U >{
@@ -175,48 +139,19 @@ auto ObjsAppPipeline::initialize_mesh(
         mesh.colors.data( ),
         mesh.indices.data( ),
     };
-    LTB_CHECK_VALID( host_data.size( ) == staging_vbo.layout( ).ranges.size( ) );
+    LTB_CHECK_VALID( host_data.size( ) == mesh_data.vbo.layout( ).ranges.size( ) );
     constexpr auto copy_count = host_data.size( );
 
-    LTB_CHECK(
-        auto* const mapped_staging_data,
-        staging_vbo.memory( ).map( {
-            .size = staging_vbo.layout( ).total_size,
-        } )
-    );
-
     for ( auto i = 0UZ; i < copy_count; ++i )
     {
-        auto const* const src_data = host_data[ i ];
-        auto const&       range    = staging_vbo.layout( ).ranges[ i ];
-        auto* const       dst_data = mapped_staging_data + range.offset;
-
-        LTB_CHECK_VALID( std::memcpy( dst_data, src_data, range.size ) == dst_data );
+        auto const& range = mesh_data.vbo.layout( ).ranges[ i ];
+        LTB_CHECK(
+            uploader.upload( host_data[ i ], range.size, mesh_data.vbo.buffer( ), range.offset )
+        );
     }
-    staging_vbo.memory( ).unmap( );
-
-    auto tmp_command_buffer = vlk::CommandBuffer{ gpu_.device( ), command_pool };
-    LTB_CHECK( tmp_command_buffer.initialize( ) );
-    auto const& command_buffer = tmp_command_buffer.get( );
-
-    VK_CHECK( command_buffer.begin(
-        vk::CommandBufferBeginInfo{ }.setFlags( vk::CommandBufferUsageFlagBits::eOneTimeSubmit )
-    ) );
-
-    command_buffer.copyBuffer(
-        staging_vbo.buffer( ).get( ),
-        mesh_data.vbo.buffer( ).get( ),
-        { vk::BufferCopy{ }.setSize( staging_vbo.layout( ).total_size ) }
-    );
-
-    VK_CHECK( command_buffer.end( ) );
-
-    auto const submit_info = vk::SubmitInfo{ }.setCommandBuffers( command_buffer );
-
-    VK_CHECK( queue.submit( submit_info, nullptr ) );
-    VK_CHECK( queue.waitIdle( ) );
 
     mesh_data.index_count = static_cast< uint32 >( mesh.indices.size( ) );
+    draw_list_.push_back( &mesh_data );
 
     return &mesh_data.push_constants;
 }
@@ -230,6 +165,36 @@ auto ObjsAppPipeline::draw_meshes( vlk::objs::FrameInfo const& frame ) -> utils:
     return utils::success( );
 }
 
+auto ObjsAppPipeline::draw_meshes(
+    vlk::objs::FrameInfo const&        frame,
+    vlk::objs::VulkanParallelRecorder& recorder
+) -> utils::Result< void >
+{
+    LTB_CHECK( auto const inheritance, presentation_.inheritance_info( frame.image_index ) );
+
+    // Secondary command buffers start without any bound state.
+    auto const record_meshes = [ this, &frame ](
+                                   vk::CommandBuffer const& command_buffer,
+                                   std::size_t const        first,
+                                   std::size_t const        last
+                               ) -> utils::Result< void > {
+        auto worker_frame           = frame;
+        worker_frame.command_buffer = command_buffer;
+
+        pipeline_.bind( command_buffer );
+        LTB_CHECK( pipeline_.bind_descriptor_sets( worker_frame ) );
+        presentation_.set_viewport_and_scissor( command_buffer );
+
+        for ( auto mesh_index = first; mesh_index < last; ++mesh_index )
+        {
+            LTB_CHECK( draw_mesh( *draw_list_[ mesh_index ], worker_frame ) );
+        }
+        return utils::success( );
+    };
+
+    return recorder.record( frame, inheritance, draw_list_.size( ), record_meshes );
+}
+
 auto ObjsAppPipeline::pipeline( ) const -> vlk::objs::VulkanGraphicsPipeline const&
 {
     return pipeline_;
@@ -57,14 +57,18 @@ public:
     [[nodiscard( "Const getter" )]]
     auto is_initialized( ) const -> bool;
 
-    auto initialize_mesh(
-        TriangleMesh const& mesh,
-        vlk::CommandPool&   command_pool,
-        vk::Queue const&    queue
-    ) -> utils::Result< MeshPushConstants* >;
+    auto initialize_mesh( TriangleMesh const& mesh, vlk::objs::VulkanUploader& uploader )
+        -> utils::Result< MeshPushConstants* >;
 
     auto draw_meshes( vlk::objs::FrameInfo const& frame ) -> utils::Result< void >;
 
+    /// \brief Splits the meshes across `recorder`'s workers. The render pass must have been
+    ///        begun with `vk::SubpassContents::eSecondaryCommandBuffers`.
+    auto draw_meshes(
+        vlk::objs::FrameInfo const&        frame,
+        vlk::objs::VulkanParallelRecorder& recorder
+    ) -> utils::Result< void >;
+
     [[nodiscard( "Const getter" )]]
     auto pipeline( ) const -> vlk::objs::VulkanGraphicsPipeline const&;
     auto pipeline( ) -> vlk::objs::VulkanGraphicsPipeline&;
@@ -91,6 +95,9 @@ private:
 
     std::list< MeshAndUniforms > mesh_data_ = { };
 
+    // Random access to `mesh_data_` so ranges of meshes can be recorded in parallel.
+    std::vector< MeshAndUniforms const* > draw_list_ = { };
+
     auto draw_mesh( MeshAndUniforms const& mesh_data, vlk::objs::FrameInfo const& frame )
         -> utils::Result< void >;
 };
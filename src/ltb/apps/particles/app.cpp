@@ -4,18 +4,16 @@
 #include "app.hpp"
 
 // project
-#include "ltb/exec/app_defaults.hpp"
-#include "ltb/vlk/ltb_vlk_config.hpp"
-#include "ltb/vlk/buffer_utils.hpp"
+#include "ltb/gui/gpu_memory_window.hpp"
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device_memory_utils.hpp"
+#include "ltb/vlk/embedded_spirv.hpp"
 
 // external
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/transform.hpp>
 #include <spdlog/spdlog.h>
 
 // standard
+#include <array>
 #include <random>
 
 namespace ltb
@@ -31,19 +29,16 @@ struct CameraBufferObject
     glm::mat4 clip_from_world = glm::identity< glm::mat4 >( );
 };
 
-struct MakeCopyRegion
-{
-    auto operator( )( vlk::MemoryRange const& range ) const -> vk::BufferCopy
-    {
-        return vk::BufferCopy{ }.setDstOffset( range.offset ).setSize( range.size );
-    }
-};
-
 } // namespace
 
-ParticlesApp::ParticlesApp( window::GlfwContext& glfw_context, window::GlfwWindow& glfw_window )
+ParticlesApp::ParticlesApp(
+    window::GlfwContext& glfw_context,
+    window::GlfwWindow&  glfw_window,
+    exec::AppSettings    app_settings
+)
     : glfw_context_( glfw_context )
     , glfw_window_( glfw_window )
+    , app_settings_( std::move( app_settings ) )
 {
 }
 
@@ -81,7 +76,8 @@ auto ParticlesApp::frame_update( exec::UpdateLoopStatus const& status ) -> exec:
 {
     auto const delta_time = timer_.duration_since_start( );
     timer_.start( );
-    compute_ubo_.delta_time = utils::to_seconds< float32 >( delta_time );
+    compute_ubo_.delta_time     = utils::to_seconds< float32 >( delta_time );
+    compute_ubo_.particle_count = particle_count;
 
     if ( auto result = this->compute( ); !result )
     {
@@ -122,6 +118,8 @@ auto ParticlesApp::configure_gui( ) -> void
         ImGui::Text( "FPS: %.1f", ImGui::GetIO( ).Framerate );
     }
     ImGui::End( );
+
+    gui::configure_gpu_memory_window( gpu_ );
 }
 
 auto ParticlesApp::on_resize( glm::ivec2 const size ) -> utils::Result< void >
@@ -135,6 +133,7 @@ auto ParticlesApp::on_resize( glm::ivec2 const size ) -> utils::Result< void >
 auto ParticlesApp::clean_up( ) -> utils::Result< void >
 {
     VK_CHECK( gpu_.device( ).get( ).waitIdle( ) );
+    LTB_CHECK( gpu_.pipeline_cache( ).save( ) );
 
     return utils::success( );
 }
@@ -166,40 +165,20 @@ auto ParticlesApp::initialize_gpu_presentation( ) -> utils::Result< ParticlesApp
 
 auto ParticlesApp::initialize_compute_pipeline( ) -> utils::Result< ParticlesApp* >
 {
-    auto shader_module = vlk::ShaderModuleSettings{
-        .spirv_file = vlk::config::shader_dir_path( ) / "particles.comp.spv",
-        .stage      = vk::ShaderStageFlagBits::eCompute,
-    };
+    auto const frame_count = app_settings_.frames_in_flight;
 
-    auto uniform_bindings = std::vector{
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 0U )
-            .setDescriptorType( vk::DescriptorType::eStorageBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eCompute ),
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 1U )
-            .setDescriptorType( vk::DescriptorType::eStorageBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eCompute ),
-    };
-
-    auto uniform_push_constants = std::vector{
-        vk::PushConstantRange{ }
-            .setStageFlags( vk::ShaderStageFlagBits::eCompute )
-            .setOffset( 0U )
-            .setSize( sizeof( UniformBufferObject ) ),
-    };
+    auto shader_module
+        = vlk::shader_module_settings( "particles.comp.spv", vk::ShaderStageFlagBits::eCompute );
 
+    // The descriptor and push constant layouts are reflected from the shader.
     LTB_CHECK( compute_.initialize( {
-        .shader_module          = std::move( shader_module ),
-        .descriptor_set_count   = exec::max_frames_in_flight,
-        .uniform_bindings       = std::move( uniform_bindings ),
-        .uniform_push_constants = std::move( uniform_push_constants ),
+        .shader_module        = std::move( shader_module ),
+        .workgroup_size       = { 256U, 1U, 1U },
+        .descriptor_set_count = frame_count,
     } ) );
 
     LTB_CHECK( compute_cmd_and_sync_.initialize( {
-        .frame_count  = exec::max_frames_in_flight,
+        .frame_count  = frame_count,
         .image_count  = 0UZ,
         .command_pool = {
             .queue_type = vlk::QueueType::Compute,
@@ -211,6 +190,8 @@ auto ParticlesApp::initialize_compute_pipeline( ) -> utils::Result< ParticlesApp
 
 auto ParticlesApp::initialize_particles( ) -> utils::Result< ParticlesApp* >
 {
+    auto const frame_count = app_settings_.frames_in_flight;
+
     LTB_CHECK_VALID( compute_.is_initialized( ) );
 
     // Initialize particles
@@ -242,11 +223,7 @@ auto ParticlesApp::initialize_particles( ) -> utils::Result< ParticlesApp* >
     );
 
     auto gpu_particles_layout = vlk::MemoryLayout{ };
-    vlk::append_memory_size_n(
-        gpu_particles_layout,
-        particle_buffer_size,
-        exec::max_frames_in_flight
-    );
+    vlk::append_memory_size_n( gpu_particles_layout, particle_buffer_size, frame_count );
 
     LTB_CHECK( gpu_particles_.initialize( {
         .layout       = std::move( gpu_particles_layout ),
@@ -255,58 +232,36 @@ auto ParticlesApp::initialize_particles( ) -> utils::Result< ParticlesApp* >
                       | vk::BufferUsageFlagBits::eTransferDst,
         .memory_properties  = vk::MemoryPropertyFlagBits::eDeviceLocal,
         .store_mapped_value = false,
+        .tag                = "particles",
     } ) );
 
-    auto staging = vlk::objs::VulkanBuffer{ gpu_ };
-
-    LTB_CHECK( staging.initialize( {
-        .layout       = { .total_size = particle_buffer_size },
-        .buffer_usage = vk::BufferUsageFlagBits::eTransferSrc,
-        .memory_properties
-        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-        .store_mapped_value = false,
+    LTB_CHECK( uploader_.initialize( {
+        .queue_type     = vlk::QueueType::Transfer,
+        .dst_queue_type = vlk::QueueType::Graphics,
     } ) );
 
-    LTB_CHECK_VALID( particle_buffer_size <= gpu_particles_.memory( ).size( ) );
-    LTB_CHECK( auto* const device_data, staging.memory( ).map( ) );
-    LTB_CHECK_VALID(
-        std::memcpy( device_data, cpu_particles.data( ), particle_buffer_size ) == device_data
-    );
-    staging.memory( ).unmap( );
-
-    auto tmp_copy_command_buffer = vlk::CommandBuffer{
-        gpu_.device( ),
-        compute_cmd_and_sync_.command_pool( ),
-    };
-    LTB_CHECK( tmp_copy_command_buffer.initialize( ) );
-
-    auto const copy_ranges = gpu_particles_.layout( ).ranges
-                           | ranges::views::transform( MakeCopyRegion{ } )
-                           | ranges::to< std::vector >( );
-
-    LTB_CHECK(
-        vlk::copy_buffer(
-            tmp_copy_command_buffer.get( ),
-            graphics_and_compute_queue_,
-            staging.buffer( ),
+    LTB_CHECK_VALID( particle_buffer_size <= gpu_particles_.allocation( ).range.size );
+    for ( auto const& memory_range : gpu_particles_.layout( ).ranges )
+    {
+        LTB_CHECK( uploader_.upload(
+            cpu_particles.data( ),
+            particle_buffer_size,
             gpu_particles_.buffer( ),
-            copy_ranges
-        )
-    );
+            memory_range.offset
+        ) );
+    }
+    LTB_CHECK( uploader_.wait( ) );
 
-    auto const& compute_descriptor_sets = compute_.descriptor_sets( ).get( );
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
+    auto& compute_descriptor_sets = compute_.descriptor_sets( );
+    for ( auto frame_index = 0U; frame_index < frame_count; ++frame_index )
     {
-        auto const prev_frame_index
-            = ( ( frame_index + exec::max_frames_in_flight ) - 1U ) % exec::max_frames_in_flight;
+        auto const prev_frame_index = ( ( frame_index + frame_count ) - 1U ) % frame_count;
 
         LTB_CHECK_VALID( prev_frame_index < gpu_particles_.layout( ).ranges.size( ) );
         LTB_CHECK_VALID( frame_index < gpu_particles_.layout( ).ranges.size( ) );
-        LTB_CHECK_VALID( frame_index < compute_descriptor_sets.size( ) );
 
         auto const& prev_memory_range = gpu_particles_.layout( ).ranges[ prev_frame_index ];
         auto const& curr_memory_range = gpu_particles_.layout( ).ranges[ frame_index ];
-        auto const& descriptor_set    = compute_descriptor_sets[ frame_index ];
 
         auto const ssbo_prev_frame_info = vk::DescriptorBufferInfo{ }
                                               .setBuffer( gpu_particles_.buffer( ).get( ) )
@@ -318,22 +273,12 @@ auto ParticlesApp::initialize_particles( ) -> utils::Result< ParticlesApp* >
                                               .setOffset( curr_memory_range.offset )
                                               .setRange( curr_memory_range.size );
 
-        auto const descriptor_writes = std::vector{
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 0U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eStorageBuffer )
-                .setBufferInfo( ssbo_prev_frame_info ),
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 1U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eStorageBuffer )
-                .setBufferInfo( ssbo_curr_frame_info ),
+        // Bindings 0 and 1 are written with the compute set's update template.
+        auto const descriptors = std::array{
+            vlk::DescriptorInfo{ .buffer = ssbo_prev_frame_info },
+            vlk::DescriptorInfo{ .buffer = ssbo_curr_frame_info },
         };
-
-        gpu_.device( ).get( ).updateDescriptorSets( descriptor_writes, { } );
+        LTB_CHECK( compute_descriptor_sets.update( frame_index, descriptors ) );
     }
 
     return this;
@@ -341,23 +286,11 @@ auto ParticlesApp::initialize_particles( ) -> utils::Result< ParticlesApp* >
 
 auto ParticlesApp::initialize_display_pipeline( ) -> utils::Result< ParticlesApp* >
 {
-    auto shader_modules = std::vector{
-        vlk::ShaderModuleSettings{
-            .spirv_file = vlk::config::shader_dir_path( ) / "particles.vert.spv",
-            .stage      = vk::ShaderStageFlagBits::eVertex,
-        },
-        vlk::ShaderModuleSettings{
-            .spirv_file = vlk::config::shader_dir_path( ) / "particles.frag.spv",
-            .stage      = vk::ShaderStageFlagBits::eFragment,
-        },
-    };
+    auto const frame_count = app_settings_.frames_in_flight;
 
-    auto uniform_bindings = std::vector{
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 0U )
-            .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eVertex ),
+    auto shader_modules = std::vector{
+        vlk::shader_module_settings( "particles.vert.spv", vk::ShaderStageFlagBits::eVertex ),
+        vlk::shader_module_settings( "particles.frag.spv", vk::ShaderStageFlagBits::eFragment ),
     };
 
     auto vertex_bindings = std::vector{
@@ -382,8 +315,7 @@ auto ParticlesApp::initialize_display_pipeline( ) -> utils::Result< ParticlesApp
 
     LTB_CHECK( graphics_.initialize( {
         .shader_modules       = std::move( shader_modules ),
-        .descriptor_set_count = exec::max_frames_in_flight,
-        .uniform_binding_sets = { std::move( uniform_bindings ) },
+        .descriptor_set_count = frame_count,
 
         .pipeline = {
             .vertex_bindings    = std::move( vertex_bindings ),
@@ -394,7 +326,7 @@ auto ParticlesApp::initialize_display_pipeline( ) -> utils::Result< ParticlesApp
     } ) );
 
     LTB_CHECK( graphics_cmd_and_sync_.initialize( {
-        .frame_count  = exec::max_frames_in_flight,
+        .frame_count  = frame_count,
         .image_count  = static_cast< uint32 >( presentation_.swapchain( ).images( ).size( ) ),
         .command_pool = {
             .queue_type = vlk::QueueType::Graphics,
@@ -406,13 +338,11 @@ auto ParticlesApp::initialize_display_pipeline( ) -> utils::Result< ParticlesApp
 
 auto ParticlesApp::initialize_camera( ) -> utils::Result< ParticlesApp* >
 {
+    auto const frame_count = app_settings_.frames_in_flight;
+
     auto camera_buffer_layout = vlk::MemoryLayout{ };
 
-    append_memory_size_n(
-        camera_buffer_layout,
-        sizeof( CameraBufferObject ),
-        exec::max_frames_in_flight
-    );
+    append_memory_size_n( camera_buffer_layout, sizeof( CameraBufferObject ), frame_count );
 
     LTB_CHECK( camera_ubo_.initialize( {
         .layout       = std::move( camera_buffer_layout ),
@@ -420,35 +350,28 @@ auto ParticlesApp::initialize_camera( ) -> utils::Result< ParticlesApp* >
         .memory_properties
         = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
         .store_mapped_value = true,
+        .tag                = "camera uniforms",
     } ) );
 
     LTB_CHECK_VALID( graphics_.is_initialized( ) );
     LTB_CHECK_VALID( 1UZ == graphics_.descriptor_sets( ).size( ) );
 
-    auto const& graphics_descriptor_sets = graphics_.descriptor_sets( ).front( ).get( );
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
+    auto& graphics_descriptor_sets = graphics_.descriptor_sets( ).front( );
+    for ( auto frame_index = 0U; frame_index < frame_count; ++frame_index )
     {
         LTB_CHECK_VALID( frame_index < camera_ubo_.layout( ).ranges.size( ) );
-        LTB_CHECK_VALID( frame_index < graphics_descriptor_sets.size( ) );
-
-        auto const& memory_range   = camera_ubo_.layout( ).ranges[ frame_index ];
-        auto const& descriptor_set = graphics_descriptor_sets[ frame_index ];
-
-        auto const descriptor_buffer_info = vk::DescriptorBufferInfo{ }
-                                                .setBuffer( camera_ubo_.buffer( ).get( ) )
-                                                .setOffset( memory_range.offset )
-                                                .setRange( memory_range.size );
-
-        auto const descriptor_writes = std::vector{
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 0U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-                .setBufferInfo( descriptor_buffer_info ),
-        };
 
-        gpu_.device( ).get( ).updateDescriptorSets( descriptor_writes, { } );
+        auto const& memory_range = camera_ubo_.layout( ).ranges[ frame_index ];
+
+        auto const descriptors = std::array{
+            vlk::DescriptorInfo{
+                .buffer = vk::DescriptorBufferInfo{ }
+                              .setBuffer( camera_ubo_.buffer( ).get( ) )
+                              .setOffset( memory_range.offset )
+                              .setRange( memory_range.size ),
+            },
+        };
+        LTB_CHECK( graphics_descriptor_sets.update( frame_index, descriptors ) );
     }
 
     return this;
@@ -492,8 +415,7 @@ auto ParticlesApp::record_compute_commands( vlk::objs::FrameInfo const& frame )
         &compute_ubo_
     );
 
-    constexpr auto group_count = glm::uvec3{ ( particle_count / 256U ) + 1U, 1U, 1U };
-    frame.command_buffer.dispatch( group_count.x, group_count.y, group_count.z );
+    compute_.dispatch( frame.command_buffer, { particle_count, 1U, 1U } );
 
     VK_CHECK( frame.command_buffer.end( ) );
 
@@ -5,6 +5,7 @@
 
 // project
 #include "ltb/cam/camera_2d.hpp"
+#include "ltb/exec/app_settings.hpp"
 #include "ltb/exec/update_loop.hpp"
 #include "ltb/gui/imgui_glfw_vulkan_setup.hpp"
 #include "ltb/utils/timers.hpp"
@@ -14,6 +15,7 @@
 #include "ltb/vlk/objs/vulkan_compute_pipeline.hpp"
 #include "ltb/vlk/objs/vulkan_gpu.hpp"
 #include "ltb/vlk/objs/vulkan_graphics_pipeline.hpp"
+#include "ltb/vlk/objs/vulkan_uploader.hpp"
 
 // standard
 #include <unordered_set>
@@ -36,7 +38,11 @@ struct Particle
 class ParticlesApp
 {
 public:
-    explicit ParticlesApp( window::GlfwContext& glfw_context, window::GlfwWindow& glfw_window );
+    explicit ParticlesApp(
+        window::GlfwContext& glfw_context,
+        window::GlfwWindow&  glfw_window,
+        exec::AppSettings    app_settings
+    );
 
     auto initialize( ) -> utils::Result< exec::UpdateLoopStatus >;
 
@@ -54,6 +60,7 @@ public:
 private:
     window::GlfwContext& glfw_context_;
     window::GlfwWindow&  glfw_window_;
+    exec::AppSettings    app_settings_;
 
     vlk::objs::VulkanGpu gpu_                        = { glfw_context_, glfw_window_ };
     vk::Queue            graphics_and_compute_queue_ = nullptr;
@@ -65,6 +72,7 @@ private:
     vlk::objs::VulkanComputePipeline compute_              = { gpu_ };
     vlk::objs::VulkanCommandAndSync  compute_cmd_and_sync_ = { gpu_ };
     vlk::objs::VulkanBuffer          gpu_particles_        = { gpu_ };
+    vlk::objs::VulkanUploader        uploader_             = { gpu_ };
 
     vlk::objs::VulkanGraphicsPipeline graphics_              = { gpu_, presentation_ };
     vlk::objs::VulkanCommandAndSync   graphics_cmd_and_sync_ = { gpu_ };
@@ -75,7 +83,8 @@ private:
 
     struct UniformBufferObject
     {
-        float32 delta_time = 0.0F;
+        float32 delta_time     = 0.0F;
+        uint32  particle_count = 0U;
     };
 
     UniformBufferObject compute_ubo_ = { };
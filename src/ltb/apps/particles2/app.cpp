@@ -4,18 +4,24 @@
 #include "app.hpp"
 
 // project
-#include "ltb/exec/app_defaults.hpp"
-#include "ltb/vlk/buffer_utils.hpp"
+#include "ltb/gui/cpu_profiler_window.hpp"
+#include "ltb/gui/gpu_memory_window.hpp"
+#include "ltb/gui/gpu_profiler_window.hpp"
+#include "ltb/gui/imgui_utils.hpp"
+#include "ltb/utils/cpu_profiler.hpp"
+#include "ltb/utils/timers.hpp"
 #include "ltb/vlk/check.hpp"
+#include "ltb/vlk/descriptor_writer.hpp"
 #include "ltb/vlk/device_memory_utils.hpp"
-#include "ltb/vlk/ltb_vlk_config.hpp"
+#include "ltb/vlk/embedded_spirv.hpp"
 
 // external
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/transform.hpp>
 #include <spdlog/spdlog.h>
 
 // standard
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <random>
 
 namespace ltb
@@ -26,16 +32,43 @@ namespace
 constexpr auto particle_count       = 1'000'001U;
 constexpr auto particle_buffer_size = particle_count * sizeof( Particle );
 
+// The most frames the GUI can allocate. Each one holds a copy of the particles.
+constexpr auto max_selectable_frames_in_flight = 8U;
+
 struct ComputeUniforms
 {
-    float32 delta_time = 0.0F;
+    float32 delta_time     = 0.0F;
+    uint32  particle_count = 0U;
 };
 
+/// \brief Moves `range` of `buffer` from `src_family` to `dst_family`. The barrier is
+///        recorded on both queues: as a release with only the source access set and as
+///        an acquire with only the destination access set.
+auto ownership_barrier(
+    vk::Buffer const&       buffer,
+    vlk::MemoryRange const& range,
+    vlk::QueueIndex const   src_family,
+    vlk::QueueIndex const   dst_family
+) -> vk::BufferMemoryBarrier
+{
+    return vk::BufferMemoryBarrier{ }
+        .setSrcQueueFamilyIndex( src_family )
+        .setDstQueueFamilyIndex( dst_family )
+        .setBuffer( buffer )
+        .setOffset( range.offset )
+        .setSize( range.size );
+}
+
 } // namespace
 
-Particles2App::Particles2App( window::GlfwContext& glfw_context, window::GlfwWindow& glfw_window )
+Particles2App::Particles2App(
+    window::GlfwContext& glfw_context,
+    window::GlfwWindow&  glfw_window,
+    exec::AppSettings    app_settings
+)
     : glfw_context_( glfw_context )
     , glfw_window_( glfw_window )
+    , app_settings_( std::move( app_settings ) )
 {
 }
 
@@ -46,35 +79,17 @@ auto Particles2App::initialize( ) -> utils::Result< exec::UpdateLoopStatus >
         return exec::UpdateLoopStatus{ };
     }
 
+    // Both pipelines are submitted first so they compile while the rest is set up.
     LTB_CHECK( this->initialize_gpu_presentation( )
                    .and_then( &Particles2App::initialize_compute_pipeline )
-                   .and_then( &Particles2App::initialize_compute_uniforms )
-                   .and_then( &Particles2App::initialize_particles )
                    .and_then( &Particles2App::initialize_display_pipeline )
-                   .and_then( &Particles2App::initialize_camera ) );
+                   .and_then( &Particles2App::initialize_frames )
+                   .and_then( &Particles2App::wait_for_pipelines )
+                   .and_then( &Particles2App::tune_workgroup_size )
+                   .and_then( &Particles2App::initialize_shader_reloader ) );
 
     camera_.set_width( 10.0F );
 
-    // Pre-record compute command buffers instead of doing it on each frame.
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
-    {
-        LTB_CHECK(
-            auto const frame_objects,
-            compute_cmd_and_sync_.get_frame_objects( frame_index )
-        );
-
-        constexpr auto reset_flags = vk::CommandBufferResetFlags{ };
-        VK_CHECK( frame_objects.command_buffer.reset( reset_flags ) );
-
-        LTB_CHECK( this->record_compute_commands( {
-            .command_buffer  = frame_objects.command_buffer,
-            .frame_fence     = frame_objects.frame_fence,
-            .frame_index     = frame_index,
-            .image_semaphore = nullptr,
-            .image_index     = 0U,
-        } ) );
-    }
-
     initialized_ = true;
 
     return exec::UpdateLoopStatus{ };
@@ -88,11 +103,7 @@ auto Particles2App::is_initialized( ) const -> bool
 auto Particles2App::fixed_step_update( exec::UpdateLoopStatus const& status )
     -> exec::UpdateRequests
 {
-    if ( delta_time_ != status.update_time_step )
-    {
-        delta_time_ = status.update_time_step;
-        compute_frames_updated_.clear( );
-    }
+    delta_time_ = status.update_time_step;
 
     if ( auto result = this->compute( ); !result )
     {
@@ -108,9 +119,7 @@ auto Particles2App::fixed_step_update( exec::UpdateLoopStatus const& status )
 
 auto Particles2App::frame_update( exec::UpdateLoopStatus const& status ) -> exec::UpdateRequests
 {
-    imgui_.new_frame( );
-    this->configure_gui( );
-
+    // The GUI and camera inputs are handled by `render` once the frame has been paced.
     if ( auto result = this->render( ); !result )
     {
         spdlog::error(
@@ -125,10 +134,8 @@ auto Particles2App::frame_update( exec::UpdateLoopStatus const& status ) -> exec
 
 auto Particles2App::configure_gui( ) -> void
 {
-    if ( camera_.handle_inputs( ) )
-    {
-        camera_frames_updated_.clear( );
-    }
+    // The camera uniforms are streamed every frame so changes need no extra handling.
+    camera_.handle_inputs( );
 
     ImGui::DockSpaceOverViewport( 0, nullptr, ImGuiDockNodeFlags_PassthruCentralNode );
 
@@ -136,14 +143,104 @@ auto Particles2App::configure_gui( ) -> void
     {
         ImGui::Text( "Particles: %u", particle_count );
         ImGui::Text( "FPS: %.1f", ImGui::GetIO( ).Framerate );
+        ImGui::Text(
+            "Particle 0: (%.2f, %.2f, %.2f)",
+            sampled_particle_.position.x,
+            sampled_particle_.position.y,
+            sampled_particle_.position.z
+        );
+
+        // Invocations beyond the particle count come from rounding up to whole workgroups.
+        for ( auto const& scope : frames_->compute_cmd_and_sync.profiler( ).stats( ) )
+        {
+            if ( ( "Particles step" != scope.name ) || scope.statistics.empty( ) )
+            {
+                continue;
+            }
+            auto const invocations = scope.statistics.front( ).value;
+            gui::imgui_fmt< ImGui::Text >( "Compute invocations: {}", invocations );
+            gui::imgui_fmt< ImGui::Text >(
+                "Idle invocations: {}",
+                invocations - std::min( invocations, uint64{ particle_count } )
+            );
+        }
+
+        auto const workgroup_size = compute_.workgroup_size( );
+        gui::imgui_fmt< ImGui::Text >(
+            "Workgroup size: ({}, {}, {})",
+            workgroup_size.x,
+            workgroup_size.y,
+            workgroup_size.z
+        );
+
+        if ( shader_reloader_.is_initialized( ) )
+        {
+            gui::imgui_fmt< ImGui::Text >(
+                "Shaders failing to compile: {}",
+                shader_reloader_.failed_shader_count( )
+            );
+        }
+
+        ImGui::SeparatorText( "Frame pacing" );
+
+        auto mode = frame_pacer_.settings( ).mode;
+        if ( ImGui::RadioButton( "Low latency", exec::FramePacingMode::LowLatency == mode ) )
+        {
+            mode = exec::FramePacingMode::LowLatency;
+        }
+        ImGui::SameLine( );
+        if ( ImGui::RadioButton( "Throughput", exec::FramePacingMode::Throughput == mode ) )
+        {
+            mode = exec::FramePacingMode::Throughput;
+        }
+        if ( mode != frame_pacer_.settings( ).mode )
+        {
+            frame_pacer_.set_mode( mode );
+        }
+
+        // Every frame resource is rebuilt before the next frame when this changes.
+        constexpr auto frames_step = 1U;
+        if ( ImGui::InputScalar(
+                 "Frames allocated",
+                 ImGuiDataType_U32,
+                 &requested_frames_in_flight_,
+                 &frames_step,
+                 nullptr,
+                 nullptr,
+                 ImGuiInputTextFlags_EnterReturnsTrue
+             ) )
+        {
+            requested_frames_in_flight_
+                = std::clamp( requested_frames_in_flight_, 1U, max_selectable_frames_in_flight );
+        }
+
+        gui::imgui_fmt< ImGui::Text >(
+            "Frames in flight: {} of {}",
+            frame_pacer_.frames_in_flight( ),
+            frame_pacer_.settings( ).max_frames_in_flight
+        );
+        gui::imgui_fmt< ImGui::Text >(
+            "Latency: {:.2f} ms",
+            utils::to_millis< float64 >( frame_pacer_.latency( ) )
+        );
+        gui::imgui_fmt< ImGui::Text >(
+            "Delay: {:.2f} ms",
+            utils::to_millis< float64 >( frame_pacer_.delay( ) )
+        );
     }
     ImGui::End( );
+
+    gui::configure_gpu_memory_window( gpu_ );
+    gui::configure_cpu_profiler_window( );
+    gui::configure_gpu_profiler_window( {
+        &frames_->compute_cmd_and_sync.profiler( ),
+        &frames_->graphics_cmd_and_sync.profiler( ),
+    } );
 }
 
 auto Particles2App::on_resize( glm::ivec2 const size ) -> utils::Result< void >
 {
     camera_.resize( glm::vec2( size ) );
-    camera_frames_updated_.clear( );
 
     return presentation_.rebuild( {
         .swapchain = presentation_.swapchain( ).settings( ),
@@ -152,23 +249,46 @@ auto Particles2App::on_resize( glm::ivec2 const size ) -> utils::Result< void >
 
 auto Particles2App::clean_up( ) -> utils::Result< void >
 {
+    LTB_CHECK( compute_batch_.flush( ) );
+    LTB_CHECK( graphics_batch_.flush( ) );
     VK_CHECK( gpu_.device( ).get( ).waitIdle( ) );
+    LTB_CHECK( gpu_.pipeline_cache( ).save( ) );
 
     return utils::success( );
 }
 
 auto Particles2App::initialize_gpu_presentation( ) -> utils::Result< Particles2App* >
 {
-    LTB_CHECK( gpu_.initialize( { } ) );
+    LTB_PROFILE_ZONE( "Particles2App::initialize_gpu_presentation" );
+
+    LTB_CHECK( gpu_.initialize( {
+        .device = { .prefer_async_compute = true },
+    } ) );
+
+    auto const& queues         = gpu_.device( ).queues( );
+    auto const& queue_families = gpu_.physical_device( ).queue_families( );
 
-    LTB_CHECK_VALID( gpu_.device( ).queues( ).contains( vlk::QueueType::Graphics ) );
-    auto const& graphics_queue = gpu_.device( ).queues( ).at( vlk::QueueType::Graphics );
+    LTB_CHECK_VALID( queues.contains( vlk::QueueType::Graphics ) );
+    graphics_queue_  = queues.at( vlk::QueueType::Graphics );
+    graphics_family_ = queue_families.at( vlk::QueueType::Graphics );
 
-    LTB_CHECK_VALID( gpu_.device( ).queues( ).contains( vlk::QueueType::Compute ) );
-    auto const& compute_queue = gpu_.device( ).queues( ).at( vlk::QueueType::Compute );
+    LTB_CHECK_VALID( queues.contains( vlk::QueueType::Compute ) );
+    compute_queue_  = queues.at( vlk::QueueType::Compute );
+    compute_family_ = queue_families.at( vlk::QueueType::Compute );
 
-    LTB_CHECK_VALID( graphics_queue == compute_queue );
-    graphics_and_compute_queue_ = graphics_queue;
+    async_compute_ = ( graphics_family_ != compute_family_ );
+    spdlog::info(
+        "Particle simulation runs on {} queue family {}",
+        async_compute_ ? "the async compute" : "the graphics",
+        compute_family_
+    );
+
+    LTB_CHECK( graphics_batch_.initialize( {
+        .queue_type = vlk::QueueType::Graphics,
+    } ) );
+    LTB_CHECK( compute_batch_.initialize( {
+        .queue_type = vlk::QueueType::Compute,
+    } ) );
 
     LTB_CHECK_VALID( gpu_.device( ).queues( ).contains( vlk::QueueType::Surface ) );
     present_queue_ = gpu_.device( ).queues( ).at( vlk::QueueType::Surface );
@@ -191,47 +311,88 @@ auto Particles2App::initialize_gpu_presentation( ) -> utils::Result< Particles2A
     } ) );
 
     LTB_CHECK( imgui_.initialize( ) );
+    LTB_CHECK( pipeline_compiler_.initialize( { } ) );
 
     return this;
 }
 
 auto Particles2App::initialize_compute_pipeline( ) -> utils::Result< Particles2App* >
 {
-    auto shader_module = vlk::ShaderModuleSettings{
-        .spirv_file = vlk::config::shader_dir_path( ) / "particles2.comp.spv",
-        .stage      = vk::ShaderStageFlagBits::eCompute,
-    };
+    LTB_PROFILE_ZONE( "Particles2App::initialize_compute_pipeline" );
 
-    auto uniform_bindings = std::vector{
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 0U )
-            .setDescriptorType( vk::DescriptorType::eStorageBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eCompute ),
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 1U )
-            .setDescriptorType( vk::DescriptorType::eStorageBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eCompute ),
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 2U )
-            .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eCompute ),
-    };
+    // `rebuild_frames` reallocates the sets when the number of frames changes.
+    auto const frame_count = frame_pacer_.settings( ).max_frames_in_flight;
 
-    LTB_CHECK( compute_.initialize( {
+    auto shader_module
+        = vlk::shader_module_settings( "particles2.comp.spv", vk::ShaderStageFlagBits::eCompute );
+
+    // The layout is reflected from the shader. The uniforms are selected with a dynamic
+    // offset from the uniform arena.
+    LTB_CHECK( pipeline_compiler_.submit( compute_, {
         .shader_module        = std::move( shader_module ),
-        .descriptor_set_count = exec::max_frames_in_flight,
-        .uniform_bindings     = std::move( uniform_bindings ),
+        .descriptor_set_count = frame_count,
+        .dynamic_buffers      = { { .set = 0U, .binding = 2U } },
     } ) );
 
-    LTB_CHECK( compute_cmd_and_sync_.initialize( {
-        .frame_count  = exec::max_frames_in_flight,
+    return this;
+}
+
+auto Particles2App::initialize_frames( ) -> utils::Result< Particles2App* >
+{
+    LTB_PROFILE_ZONE( "Particles2App::initialize_frames" );
+
+    frames_ = std::make_unique< FrameResources >( gpu_ );
+
+    return this->initialize_command_and_sync( )
+        .and_then( &Particles2App::initialize_compute_uniforms )
+        .and_then( &Particles2App::initialize_particles )
+        .and_then( &Particles2App::initialize_camera );
+}
+
+auto Particles2App::initialize_command_and_sync( ) -> utils::Result< Particles2App* >
+{
+    LTB_PROFILE_ZONE( "Particles2App::initialize_command_and_sync" );
+
+    auto const frame_count = frame_pacer_.settings( ).max_frames_in_flight;
+
+    LTB_CHECK( frames_->compute_cmd_and_sync.initialize( {
+        .frame_count  = frame_count,
+        .image_count  = 0UZ,
+        .command_pool = {
+            .queue_type = vlk::QueueType::Compute,
+        },
+        .frame_sync                = vlk::objs::FrameSync::TimelineSemaphore,
+        .profiler_scopes_per_frame = 4U,
+        .profiler_statistics       = vk::QueryPipelineStatisticFlagBits::eComputeShaderInvocations,
+    } ) );
+
+    LTB_CHECK( frames_->handoff_cmd_and_sync.initialize( {
+        .frame_count  = frame_count,
         .image_count  = 0UZ,
         .command_pool = {
             .queue_type = vlk::QueueType::Compute,
         },
+        .frame_sync = vlk::objs::FrameSync::TimelineSemaphore,
+    } ) );
+
+    LTB_CHECK( frames_->readback.initialize( {
+        .frame_count = frame_count,
+        .frame_size  = sizeof( Particle ),
+    } ) );
+
+    LTB_CHECK( frames_->graphics_cmd_and_sync.initialize( {
+        .frame_count  = frame_count,
+        .image_count  = static_cast< uint32 >( presentation_.swapchain( ).images( ).size( ) ),
+        .command_pool = {
+            .queue_type = vlk::QueueType::Graphics,
+        },
+        .frame_sync                = vlk::objs::FrameSync::TimelineSemaphore,
+        .profiler_scopes_per_frame = 4U,
+        .profiler_statistics       = vk::QueryPipelineStatisticFlagBits::eInputAssemblyVertices
+                             | vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations
+                             | vk::QueryPipelineStatisticFlagBits::eClippingInvocations
+                             | vk::QueryPipelineStatisticFlagBits::eClippingPrimitives
+                             | vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations,
     } ) );
 
     return this;
@@ -239,58 +400,43 @@ auto Particles2App::initialize_compute_pipeline( ) -> utils::Result< Particles2A
 
 auto Particles2App::initialize_compute_uniforms( ) -> utils::Result< Particles2App* >
 {
-    auto const ubo_alignment
-        = gpu_.physical_device( ).properties( ).limits.minUniformBufferOffsetAlignment;
+    LTB_PROFILE_ZONE( "Particles2App::initialize_compute_uniforms" );
 
-    auto unform_buffer_layout = vlk::MemoryLayout{ };
-    append_memory_size_n(
-        unform_buffer_layout,
-        { sizeof( ComputeUniforms ), ubo_alignment },
-        exec::max_frames_in_flight
-    );
+    auto const frame_count = frame_pacer_.settings( ).max_frames_in_flight;
 
-    LTB_CHECK( compute_ubo_.initialize( {
-        .layout       = std::move( unform_buffer_layout ),
-        .buffer_usage = vk::BufferUsageFlagBits::eUniformBuffer,
-        .memory_properties
-        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-        .store_mapped_value = true,
+    LTB_CHECK( frames_->compute_uniforms.initialize( {
+        .frame_count = frame_count,
     } ) );
 
-    LTB_CHECK_VALID( compute_.is_initialized( ) );
-
-    auto const& compute_descriptor_sets = compute_.descriptor_sets( ).get( );
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
-    {
-        LTB_CHECK_VALID( frame_index < compute_ubo_.layout( ).ranges.size( ) );
-        LTB_CHECK_VALID( frame_index < compute_descriptor_sets.size( ) );
+    LTB_CHECK_VALID( compute_.descriptor_sets( ).is_initialized( ) );
 
-        auto const& memory_range   = compute_ubo_.layout( ).ranges[ frame_index ];
-        auto const& descriptor_set = compute_descriptor_sets[ frame_index ];
-
-        auto const descriptor_buffer_info = vk::DescriptorBufferInfo{ }
-                                                .setBuffer( compute_ubo_.buffer( ).get( ) )
-                                                .setOffset( memory_range.offset )
-                                                .setRange( memory_range.size );
-
-        auto const descriptor_writes = std::vector{
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 2U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-                .setBufferInfo( descriptor_buffer_info ),
-        };
+    auto const descriptor_buffer_info
+        = frames_->compute_uniforms.descriptor_info( sizeof( ComputeUniforms ) );
 
-        gpu_.device( ).get( ).updateDescriptorSets( descriptor_writes, { } );
+    // The particle buffers still differ per frame, but every set reads its
+    // uniforms from the arena at the offset supplied when it is bound.
+    auto descriptor_writer = vlk::DescriptorWriter{ gpu_.device( ) };
+    for ( auto const& descriptor_set : compute_.descriptor_sets( ).get( ) )
+    {
+        descriptor_writer.write_buffer(
+            descriptor_set,
+            2U,
+            vk::DescriptorType::eUniformBufferDynamic,
+            descriptor_buffer_info
+        );
     }
+    descriptor_writer.flush( );
 
     return this;
 }
 
 auto Particles2App::initialize_particles( ) -> utils::Result< Particles2App* >
 {
-    LTB_CHECK_VALID( compute_.is_initialized( ) );
+    LTB_PROFILE_ZONE( "Particles2App::initialize_particles" );
+
+    auto const frame_count = frame_pacer_.settings( ).max_frames_in_flight;
+
+    LTB_CHECK_VALID( compute_.descriptor_sets( ).is_initialized( ) );
 
     // Initialize particles
     auto const seed      = std::random_device{ }( );
@@ -321,119 +467,92 @@ auto Particles2App::initialize_particles( ) -> utils::Result< Particles2App* >
     vlk::append_memory_size_n(
         gpu_particles_layout,
         particle_buffer_size,
-        exec::max_frames_in_flight
+        frame_count
     );
 
-    LTB_CHECK( gpu_particles_.initialize( {
+    LTB_CHECK( frames_->gpu_particles.initialize( {
         .layout       = std::move( gpu_particles_layout ),
         .buffer_usage = vk::BufferUsageFlagBits::eStorageBuffer
                       | vk::BufferUsageFlagBits::eVertexBuffer
+                      | vk::BufferUsageFlagBits::eTransferSrc
                       | vk::BufferUsageFlagBits::eTransferDst,
         .memory_properties  = vk::MemoryPropertyFlagBits::eDeviceLocal,
         .store_mapped_value = false,
+        .tag                = "particles",
     } ) );
 
-    auto staging = vlk::objs::VulkanBuffer{ gpu_ };
-
-    LTB_CHECK( staging.initialize( {
-        .layout       = { .total_size = particle_buffer_size },
-        .buffer_usage = vk::BufferUsageFlagBits::eTransferSrc,
-        .memory_properties
-        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-        .store_mapped_value = false,
+    // The simulation owns the particles until a range is handed to graphics to be drawn.
+    LTB_CHECK( uploader_.initialize( {
+        .queue_type     = vlk::QueueType::Transfer,
+        .dst_queue_type = vlk::QueueType::Compute,
     } ) );
 
-    LTB_CHECK_VALID( particle_buffer_size <= gpu_particles_.memory( ).size( ) );
-    LTB_CHECK( auto* const device_data, staging.memory( ).map( ) );
-    LTB_CHECK_VALID(
-        std::memcpy( device_data, cpu_particles.data( ), particle_buffer_size ) == device_data
-    );
-    staging.memory( ).unmap( );
-
-    auto tmp_copy_command_buffer = vlk::CommandBuffer{
-        gpu_.device( ),
-        compute_cmd_and_sync_.command_pool( ),
-    };
-    LTB_CHECK( tmp_copy_command_buffer.initialize( ) );
+    LTB_CHECK_VALID( particle_buffer_size <= frames_->gpu_particles.allocation( ).range.size );
+    for ( auto const& memory_range : frames_->gpu_particles.layout( ).ranges )
+    {
+        LTB_CHECK( uploader_.upload(
+            cpu_particles.data( ),
+            particle_buffer_size,
+            frames_->gpu_particles.buffer( ),
+            memory_range.offset
+        ) );
+    }
+    LTB_CHECK( uploader_.wait( ) );
 
-    auto const copy_ranges = gpu_particles_.layout( ).ranges
-                           | ranges::views::transform( vlk::MakeCopyRegion{ } )
-                           | ranges::to< std::vector >( );
+    frames_->particle_ranges.assign( frame_count, ParticleRange{ } );
 
-    LTB_CHECK(
-        vlk::copy_buffer(
-            tmp_copy_command_buffer.get( ),
-            graphics_and_compute_queue_,
-            staging.buffer( ),
-            gpu_particles_.buffer( ),
-            copy_ranges
-        )
-    );
+    // The uniforms at binding 2 are written separately, so only the particle
+    // buffers are queued here and every frame's set is updated with one call.
+    auto descriptor_writer = vlk::DescriptorWriter{ gpu_.device( ) };
 
     auto const& compute_descriptor_sets = compute_.descriptor_sets( ).get( );
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
+    for ( auto frame_index = 0U; frame_index < frame_count; ++frame_index )
     {
-        auto const prev_frame_index
-            = ( ( frame_index + exec::max_frames_in_flight ) - 1U ) % exec::max_frames_in_flight;
+        auto const prev_frame_index = ( ( frame_index + frame_count ) - 1U ) % frame_count;
 
-        LTB_CHECK_VALID( prev_frame_index < gpu_particles_.layout( ).ranges.size( ) );
-        LTB_CHECK_VALID( frame_index < gpu_particles_.layout( ).ranges.size( ) );
+        LTB_CHECK_VALID( prev_frame_index < frames_->gpu_particles.layout( ).ranges.size( ) );
+        LTB_CHECK_VALID( frame_index < frames_->gpu_particles.layout( ).ranges.size( ) );
         LTB_CHECK_VALID( frame_index < compute_descriptor_sets.size( ) );
 
-        auto const& prev_memory_range = gpu_particles_.layout( ).ranges[ prev_frame_index ];
-        auto const& curr_memory_range = gpu_particles_.layout( ).ranges[ frame_index ];
+        auto const& prev_memory_range = frames_->gpu_particles.layout( ).ranges[ prev_frame_index ];
+        auto const& curr_memory_range = frames_->gpu_particles.layout( ).ranges[ frame_index ];
         auto const& descriptor_set    = compute_descriptor_sets[ frame_index ];
 
         auto const ssbo_prev_frame_info = vk::DescriptorBufferInfo{ }
-                                              .setBuffer( gpu_particles_.buffer( ).get( ) )
+                                              .setBuffer( frames_->gpu_particles.buffer( ).get( ) )
                                               .setOffset( prev_memory_range.offset )
                                               .setRange( prev_memory_range.size );
 
         auto const ssbo_curr_frame_info = vk::DescriptorBufferInfo{ }
-                                              .setBuffer( gpu_particles_.buffer( ).get( ) )
+                                              .setBuffer( frames_->gpu_particles.buffer( ).get( ) )
                                               .setOffset( curr_memory_range.offset )
                                               .setRange( curr_memory_range.size );
 
-        auto const descriptor_writes = std::vector{
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 0U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eStorageBuffer )
-                .setBufferInfo( ssbo_prev_frame_info ),
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 1U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eStorageBuffer )
-                .setBufferInfo( ssbo_curr_frame_info ),
-        };
-
-        gpu_.device( ).get( ).updateDescriptorSets( descriptor_writes, { } );
+        descriptor_writer.write_buffer(
+            descriptor_set,
+            0U,
+            vk::DescriptorType::eStorageBuffer,
+            ssbo_prev_frame_info
+        );
+        descriptor_writer.write_buffer(
+            descriptor_set,
+            1U,
+            vk::DescriptorType::eStorageBuffer,
+            ssbo_curr_frame_info
+        );
     }
+    descriptor_writer.flush( );
 
     return this;
 }
 
 auto Particles2App::initialize_display_pipeline( ) -> utils::Result< Particles2App* >
 {
-    auto shader_modules = std::vector{
-        vlk::ShaderModuleSettings{
-            .spirv_file = vlk::config::shader_dir_path( ) / "particles2.vert.spv",
-            .stage      = vk::ShaderStageFlagBits::eVertex,
-        },
-        vlk::ShaderModuleSettings{
-            .spirv_file = vlk::config::shader_dir_path( ) / "particles2.frag.spv",
-            .stage      = vk::ShaderStageFlagBits::eFragment,
-        },
-    };
+    LTB_PROFILE_ZONE( "Particles2App::initialize_display_pipeline" );
 
-    auto uniform_bindings = std::vector{
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 0U )
-            .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eVertex ),
+    auto shader_modules = std::vector{
+        vlk::shader_module_settings( "particles2.vert.spv", vk::ShaderStageFlagBits::eVertex ),
+        vlk::shader_module_settings( "particles2.frag.spv", vk::ShaderStageFlagBits::eFragment ),
     };
 
     auto vertex_bindings = std::vector{
@@ -456,10 +575,11 @@ auto Particles2App::initialize_display_pipeline( ) -> utils::Result< Particles2A
             .setOffset( offsetof( Particle, velocity ) ),
     };
 
-    LTB_CHECK( graphics_.initialize( {
+    // One set serves every frame. The camera uniforms are selected with a dynamic offset.
+    LTB_CHECK( pipeline_compiler_.submit( graphics_, {
         .shader_modules       = std::move( shader_modules ),
-        .descriptor_set_count = exec::max_frames_in_flight,
-        .uniform_binding_sets = { std::move( uniform_bindings ) },
+        .descriptor_set_count = 1U,
+        .dynamic_buffers      = { { .set = 0U, .binding = 0U } },
 
         .pipeline = {
             .vertex_bindings    = std::move( vertex_bindings ),
@@ -468,228 +588,518 @@ auto Particles2App::initialize_display_pipeline( ) -> utils::Result< Particles2A
         },
     } ) );
 
-    LTB_CHECK( graphics_cmd_and_sync_.initialize( {
-        .frame_count  = exec::max_frames_in_flight,
-        .image_count  = static_cast< uint32 >( presentation_.swapchain( ).images( ).size( ) ),
-        .command_pool = {
-            .queue_type = vlk::QueueType::Graphics,
-        },
-    } ) );
-
     return this;
 }
 
 auto Particles2App::initialize_camera( ) -> utils::Result< Particles2App* >
 {
-    auto camera_buffer_layout = vlk::MemoryLayout{ };
+    LTB_PROFILE_ZONE( "Particles2App::initialize_camera" );
 
-    append_memory_size_n(
-        camera_buffer_layout,
-        sizeof( cam::SimpleCameraRenderParams ),
-        exec::max_frames_in_flight
-    );
+    auto const frame_count = frame_pacer_.settings( ).max_frames_in_flight;
 
-    LTB_CHECK( camera_ubo_.initialize( {
-        .layout       = std::move( camera_buffer_layout ),
-        .buffer_usage = vk::BufferUsageFlagBits::eUniformBuffer,
-        .memory_properties
-        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-        .store_mapped_value = true,
+    LTB_CHECK( frames_->graphics_uniforms.initialize( {
+        .frame_count = frame_count,
     } ) );
 
-    LTB_CHECK_VALID( graphics_.is_initialized( ) );
     LTB_CHECK_VALID( 1UZ == graphics_.descriptor_sets( ).size( ) );
 
-    auto const& graphics_descriptor_sets = graphics_.descriptor_sets( ).front( ).get( );
-    for ( auto frame_index = 0U; frame_index < exec::max_frames_in_flight; ++frame_index )
+    auto& graphics_descriptor_sets = graphics_.descriptor_sets( ).front( );
+    LTB_CHECK_VALID( 1UZ == graphics_descriptor_sets.get( ).size( ) );
+
+    auto const descriptors = std::array{
+        vlk::DescriptorInfo{
+            .buffer
+            = frames_->graphics_uniforms.descriptor_info( sizeof( cam::SimpleCameraRenderParams ) ),
+        },
+    };
+    LTB_CHECK( graphics_descriptor_sets.update( 0U, descriptors ) );
+
+    return this;
+}
+
+auto Particles2App::wait_for_pipelines( ) -> utils::Result< Particles2App* >
+{
+    LTB_PROFILE_ZONE( "Particles2App::wait_for_pipelines" );
+
+    LTB_CHECK( pipeline_compiler_.wait_all( ) );
+
+    LTB_CHECK_VALID( compute_.is_initialized( ) );
+    LTB_CHECK_VALID( graphics_.is_initialized( ) );
+
+    return this;
+}
+
+auto Particles2App::tune_workgroup_size( ) -> utils::Result< Particles2App* >
+{
+    LTB_PROFILE_ZONE( "Particles2App::tune_workgroup_size" );
+
+    // Without timestamps the pipeline keeps its default size.
+    if ( auto const result = workgroup_tuner_.initialize( { } ); !result )
     {
-        LTB_CHECK_VALID( frame_index < camera_ubo_.layout( ).ranges.size( ) );
-        LTB_CHECK_VALID( frame_index < graphics_descriptor_sets.size( ) );
-
-        auto const& memory_range   = camera_ubo_.layout( ).ranges[ frame_index ];
-        auto const& descriptor_set = graphics_descriptor_sets[ frame_index ];
-
-        auto const descriptor_buffer_info = vk::DescriptorBufferInfo{ }
-                                                .setBuffer( camera_ubo_.buffer( ).get( ) )
-                                                .setOffset( memory_range.offset )
-                                                .setRange( memory_range.size );
-
-        auto const descriptor_writes = std::vector{
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 0U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-                .setBufferInfo( descriptor_buffer_info ),
+        spdlog::warn(
+            "Workgroup size not tuned:\n"
+            "{}",
+            result.error( ).debug_error_message( )
+        );
+        return this;
+    }
+
+    // A zero time step leaves the particles where they are, so the timed steps can run
+    // on the real buffers before the simulation starts.
+    auto const record_step = [ this ](
+                                 vk::CommandBuffer const&          command_buffer,
+                                 vlk::objs::VulkanComputePipeline& pipeline
+                             ) -> utils::Result< void > {
+        auto const frame = vlk::objs::FrameInfo{
+            .command_buffer = command_buffer,
+            .frame_index    = 0U,
         };
 
-        gpu_.device( ).get( ).updateDescriptorSets( descriptor_writes, { } );
+        LTB_CHECK( frames_->compute_uniforms.start_frame( frame.frame_index ) );
+        LTB_CHECK(
+            auto const uniforms_offset,
+            frames_->compute_uniforms.push( ComputeUniforms{
+                .delta_time     = 0.0F,
+                .particle_count = particle_count,
+            } )
+        );
+
+        pipeline.bind( command_buffer );
+        LTB_CHECK( pipeline.bind_descriptor_sets( frame, { uniforms_offset } ) );
+        pipeline.dispatch( command_buffer, { particle_count, 1U, 1U } );
+
+        return utils::success( );
+    };
+
+    auto const candidates = std::vector< glm::uvec3 >{
+        { 32U, 1U, 1U },
+        { 64U, 1U, 1U },
+        { 128U, 1U, 1U },
+        { 256U, 1U, 1U },
+        { 512U, 1U, 1U },
+        { 1024U, 1U, 1U },
+    };
+    LTB_CHECK( workgroup_tuner_.tune( "particles2.comp", compute_, candidates, record_step ) );
+    LTB_CHECK( workgroup_tuner_.save( ) );
+
+    return this;
+}
+
+auto Particles2App::initialize_shader_reloader( ) -> utils::Result< Particles2App* >
+{
+    // Setting LTB_SHADER_RELOAD recompiles the shaders in `res/shaders` as they are saved.
+    if ( nullptr == std::getenv( "LTB_SHADER_RELOAD" ) )
+    {
+        return this;
     }
 
+    LTB_CHECK( shader_reloader_.initialize( { } ) );
+    LTB_CHECK( shader_reloader_.watch( compute_, vlk::QueueType::Compute ) );
+    LTB_CHECK( shader_reloader_.watch( graphics_, vlk::QueueType::Graphics ) );
+
     return this;
 }
 
+auto Particles2App::rebuild_frames( uint32 const frame_count ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( frame_count > 0U );
+
+    LTB_CHECK( compute_batch_.flush( ) );
+    LTB_CHECK( graphics_batch_.flush( ) );
+    VK_CHECK( gpu_.device( ).get( ).waitIdle( ) );
+
+    spdlog::debug( "{}: {} frames in flight", __FUNCTION__, frame_count );
+
+    // Released before the new frames are created so the old particle ranges are never
+    // allocated alongside the new ones.
+    frames_ = nullptr;
+
+    // The new frames start their timelines over, so the pacer's history is dropped too.
+    auto pacer_settings                 = frame_pacer_.settings( );
+    pacer_settings.max_frames_in_flight = frame_count;
+    frame_pacer_                        = exec::FramePacer{ pacer_settings };
+
+    LTB_CHECK( compute_.reallocate_descriptor_sets( frame_count ) );
+    LTB_CHECK( this->initialize_frames( ) );
+
+    return utils::success( );
+}
+
 auto Particles2App::compute( ) -> utils::Result< void >
 {
-    LTB_CHECK(
-        auto const maybe_frame,
-        compute_cmd_and_sync_.start_frame( vlk::objs::ResetCommandBuffer::No )
-    );
+    // Flushes the batch first if the frame being reused is still queued on it.
+    LTB_CHECK( auto const maybe_frame, frames_->compute_cmd_and_sync.start_frame( ) );
 
     if ( maybe_frame.has_value( ) )
     {
         auto const& frame = maybe_frame.value( );
 
-        LTB_CHECK( this->update_compute_uniforms( frame ) );
+        LTB_CHECK( this->collect_readbacks( frame.frame_index ) );
+        LTB_CHECK( frames_->readback.start_frame( frame ) );
 
-        // Commands are pre-recorded.
-
-        auto wait_until_signaled = std::vector< vlk::objs::SemaphoreAndStage >{ };
+        // The dynamic offset is baked into the commands so they are recorded every frame.
+        LTB_CHECK( auto const uniforms_offset, this->update_compute_uniforms( frame ) );
+        LTB_CHECK(
+            auto const graphics_wait_value,
+            this->record_compute_commands( frame, uniforms_offset )
+        );
 
-        if ( compute_semaphore_.has_value( ) )
-        {
-            wait_until_signaled.push_back( {
-                .semaphore = compute_semaphore_.value( ),
+        // Each submission signals the next value of its own timeline, so waits are
+        // expressed as "after value N" and nothing has to be consumed or reset.
+        auto wait_until_signaled = std::vector< vlk::objs::SemaphoreAndStage >{
+            {
+                // The previous step produced the particles this step reads.
+                .semaphore = frames_->compute_cmd_and_sync.timeline_semaphore( ),
                 .stage     = vk::PipelineStageFlagBits::eComputeShader,
-            } );
-            compute_semaphore_ = std::nullopt;
-        }
-
-        auto const& compute_finished_semaphore
-            = compute_cmd_and_sync_.get_frame_objects( ).frame_semaphore;
+                .value     = frames_->compute_cmd_and_sync.last_submitted_value( ),
+            },
+            {
+                // The last draw of the range this step overwrites, and the release of
+                // any range it takes back from the graphics family.
+                .semaphore = frames_->graphics_cmd_and_sync.timeline_semaphore( ),
+                .stage     = vk::PipelineStageFlagBits::eComputeShader,
+                .value     = graphics_wait_value,
+            },
+        };
 
-        LTB_CHECK( compute_cmd_and_sync_.end_frame(
+        LTB_CHECK( frames_->compute_cmd_and_sync.end_frame(
             frame,
             std::move( wait_until_signaled ),
-            { compute_finished_semaphore },
-            graphics_and_compute_queue_
+            { },
+            this->compute_batch( )
         ) );
 
-        compute_semaphore_ = compute_finished_semaphore;
-        compute_cmd_and_sync_.increment_frame( );
+        frames_->compute_cmd_and_sync.increment_frame( );
     }
 
     return utils::success( );
 }
 
 auto Particles2App::update_compute_uniforms( vlk::objs::FrameInfo const& frame )
-    -> utils::Result< void >
+    -> utils::Result< uint32 >
 {
-    if ( compute_frames_updated_.contains( frame.frame_index ) )
-    {
-        return utils::success( );
-    }
+    LTB_CHECK( frames_->compute_uniforms.start_frame( frame.frame_index ) );
 
-    auto const compute_ubo = ComputeUniforms{
-        .delta_time = utils::to_seconds< float32 >( delta_time_ ),
-    };
+    return frames_->compute_uniforms.push( ComputeUniforms{
+        .delta_time     = utils::to_seconds< float32 >( delta_time_ ),
+        .particle_count = particle_count,
+    } );
+}
+
+auto Particles2App::record_compute_commands(
+    vlk::objs::FrameInfo const& frame,
+    uint32 const                uniforms_offset
+) -> utils::Result< uint64 >
+{
+    LTB_CHECK_VALID( frame.frame_index < frames_->particle_ranges.size( ) );
 
-    LTB_CHECK_VALID( frame.frame_index < compute_ubo_.layout( ).ranges.size( ) );
-    auto const& memory_range = compute_ubo_.layout( ).ranges[ frame.frame_index ];
+    VK_CHECK( frame.command_buffer.begin( vk::CommandBufferBeginInfo{ } ) );
 
-    auto* const dst_data = compute_ubo_.mapped_data( ) + memory_range.offset;
-    LTB_CHECK_VALID( memory_range.size >= sizeof( compute_ubo ) );
-    LTB_CHECK_VALID( std::memcpy( dst_data, &compute_ubo, sizeof( compute_ubo ) ) == dst_data );
+    // This step reads the previous step's range and overwrites its own.
+    auto const read_range
+        = frames_->compute_cmd_and_sync.compute_previous_frame( frame.frame_index );
+    auto graphics_wait_value
+        = this->acquire_particle_ranges( frame.command_buffer, { read_range, frame.frame_index } );
+    graphics_wait_value = std::max(
+        graphics_wait_value,
+        frames_->particle_ranges[ frame.frame_index ].last_draw_value
+    );
 
-    compute_frames_updated_.emplace( frame.frame_index );
+    compute_.bind( frame.command_buffer );
 
-    return utils::success( );
+    LTB_CHECK( compute_.bind_descriptor_sets( frame, { uniforms_offset } ) );
+
+    LTB_CHECK(
+        vlk::objs::begin_gpu_scope( frame, "Particles step", vlk::objs::ScopeStatistics::Yes )
+    );
+    compute_.dispatch( frame.command_buffer, { particle_count, 1U, 1U } );
+    LTB_CHECK( vlk::objs::end_gpu_scope( frame ) );
+
+    LTB_CHECK_VALID( frame.frame_index < frames_->gpu_particles.layout( ).ranges.size( ) );
+    auto const& particles_range = frames_->gpu_particles.layout( ).ranges[ frame.frame_index ];
+
+    LTB_CHECK(
+        auto const readback,
+        frames_->readback.read(
+            frame,
+            frames_->gpu_particles.buffer( ),
+            particles_range.offset,
+            sizeof( Particle )
+        )
+    );
+    frames_->pending_readbacks.push_back( readback );
+
+    VK_CHECK( frame.command_buffer.end( ) );
+
+    return graphics_wait_value;
 }
 
-auto Particles2App::record_compute_commands( vlk::objs::FrameInfo const& frame )
-    -> utils::Result< void >
+auto Particles2App::acquire_particle_ranges(
+    vk::CommandBuffer const&     command_buffer,
+    std::vector< uint32 > const& range_indices
+) -> uint64
 {
-    VK_CHECK( frame.command_buffer.begin( vk::CommandBufferBeginInfo{ } ) );
+    auto barriers            = std::vector< vk::BufferMemoryBarrier >{ };
+    auto graphics_wait_value = uint64{ 0U };
 
-    compute_.bind( frame.command_buffer );
+    for ( auto const range_index : range_indices )
+    {
+        auto& range = frames_->particle_ranges[ range_index ];
+        if ( !range.with_graphics )
+        {
+            continue;
+        }
+
+        auto barrier = ownership_barrier(
+            frames_->gpu_particles.buffer( ).get( ),
+            frames_->gpu_particles.layout( ).ranges[ range_index ],
+            graphics_family_,
+            compute_family_
+        );
+        barriers.push_back( barrier.setDstAccessMask(
+            vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite
+        ) );
+
+        // The release is the last thing the drawing frame records.
+        graphics_wait_value = std::max( graphics_wait_value, range.last_draw_value );
+        range.with_graphics = false;
+    }
+
+    if ( !barriers.empty( ) )
+    {
+        command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTopOfPipe,
+            vk::PipelineStageFlagBits::eComputeShader,
+            vk::DependencyFlags{ },
+            { },
+            barriers,
+            { }
+        );
+    }
+
+    return graphics_wait_value;
+}
+
+auto Particles2App::release_particles_to_graphics( uint32 const range_index )
+    -> utils::Result< vlk::objs::SemaphoreAndStage >
+{
+    LTB_CHECK_VALID( range_index < frames_->particle_ranges.size( ) );
 
-    LTB_CHECK( compute_.bind_descriptor_sets( frame ) );
+    LTB_CHECK( auto const maybe_frame, frames_->handoff_cmd_and_sync.start_frame( ) );
+    LTB_CHECK_VALID( maybe_frame.has_value( ) );
+    auto const& frame = maybe_frame.value( );
 
-    constexpr auto group_count = glm::uvec3{ ( particle_count / 256U ) + 1U, 1U, 1U };
-    frame.command_buffer.dispatch( group_count.x, group_count.y, group_count.z );
+    VK_CHECK( frame.command_buffer.begin( vk::CommandBufferBeginInfo{ } ) );
+
+    // A range that was drawn last frame and not simulated since is still with graphics.
+    auto const graphics_wait_value
+        = this->acquire_particle_ranges( frame.command_buffer, { range_index } );
+
+    // Compute commands submitted earlier to this queue are in the release's first scope.
+    frame.command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eComputeShader,
+        vk::PipelineStageFlagBits::eBottomOfPipe,
+        vk::DependencyFlags{ },
+        { },
+        ownership_barrier(
+            frames_->gpu_particles.buffer( ).get( ),
+            frames_->gpu_particles.layout( ).ranges[ range_index ],
+            compute_family_,
+            graphics_family_
+        )
+            .setSrcAccessMask( vk::AccessFlagBits::eShaderWrite ),
+        { }
+    );
 
     VK_CHECK( frame.command_buffer.end( ) );
 
+    auto waits = std::vector< vlk::objs::SemaphoreAndStage >{ };
+    if ( graphics_wait_value > 0U )
+    {
+        waits.push_back( {
+            .semaphore = frames_->graphics_cmd_and_sync.timeline_semaphore( ),
+            .stage     = vk::PipelineStageFlagBits::eComputeShader,
+            .value     = graphics_wait_value,
+        } );
+    }
+
+    LTB_CHECK( frames_->handoff_cmd_and_sync.end_frame( frame, waits, { }, compute_batch_ ) );
+    frames_->handoff_cmd_and_sync.increment_frame( );
+
+    frames_->particle_ranges[ range_index ].with_graphics = true;
+
+    return vlk::objs::SemaphoreAndStage{
+        .semaphore = frames_->handoff_cmd_and_sync.timeline_semaphore( ),
+        .stage     = vk::PipelineStageFlagBits::eVertexInput,
+        .value     = frame.timeline_value,
+    };
+}
+
+auto Particles2App::compute_batch( ) -> vlk::objs::VulkanSubmitBatch&
+{
+    return async_compute_ ? compute_batch_ : graphics_batch_;
+}
+
+auto Particles2App::collect_readbacks( uint32 const reused_frame_index ) -> utils::Result< void >
+{
+    while ( !frames_->pending_readbacks.empty( ) )
+    {
+        auto const& readback = frames_->pending_readbacks.front( );
+
+        if ( readback.frame_index == reused_frame_index )
+        {
+            // Starting this frame waits for the same submission so this costs nothing extra.
+            LTB_CHECK( frames_->readback.wait( readback ) );
+        }
+        else
+        {
+            LTB_CHECK( auto const ready, frames_->readback.is_ready( readback ) );
+            if ( !ready )
+            {
+                break;
+            }
+        }
+
+        LTB_CHECK( sampled_particle_, frames_->readback.get< Particle >( readback ) );
+        frames_->pending_readbacks.pop_front( );
+    }
+
     return utils::success( );
 }
 
 auto Particles2App::render( ) -> utils::Result< void >
 {
+    // Requested from the GUI last frame. Nothing is being recorded at this point.
+    if ( requested_frames_in_flight_ != frame_pacer_.settings( ).max_frames_in_flight )
+    {
+        LTB_CHECK( this->rebuild_frames( requested_frames_in_flight_ ) );
+    }
+
+    frames_->graphics_cmd_and_sync.set_frames_in_flight( frame_pacer_.frames_in_flight( ) );
+
+    auto blocked_timer = utils::Timer{ };
     LTB_CHECK(
         auto const maybe_frame,
-        graphics_cmd_and_sync_.start_frame( presentation_.swapchain( ) )
+        frames_->graphics_cmd_and_sync.start_frame( presentation_.swapchain( ) )
     );
 
     if ( maybe_frame.has_value( ) )
     {
         auto const frame = maybe_frame.value( );
 
-        LTB_CHECK( this->update_camera_uniforms( frame ) );
-        LTB_CHECK( this->record_render_commands( frame ) );
+        // Inputs are read after pacing so the measured latency covers them.
+        LTB_CHECK( auto const completed_value, frames_->graphics_cmd_and_sync.completed_value( ) );
+        frame_pacer_.frames_completed( completed_value );
+        frame_pacer_.begin_frame( frame.timeline_value, blocked_timer.duration_since_start( ) );
 
-        auto wait_until_signaled = std::vector< vlk::objs::SemaphoreAndStage >{ };
+        imgui_.new_frame( );
+        this->configure_gui( );
 
-        if ( compute_semaphore_ )
+        // The newest particles, drawn by `record_render_commands`.
+        auto const drawn_range = frames_->compute_cmd_and_sync.previous_frame( );
+        LTB_CHECK_VALID( drawn_range < frames_->particle_ranges.size( ) );
+
+        auto particles_ready = vlk::objs::SemaphoreAndStage{
+            .semaphore = frames_->compute_cmd_and_sync.timeline_semaphore( ),
+            .stage     = vk::PipelineStageFlagBits::eVertexInput,
+            .value     = frames_->compute_cmd_and_sync.last_submitted_value( ),
+        };
+        if ( async_compute_ )
         {
-            wait_until_signaled.push_back( {
-                .semaphore = compute_semaphore_.value( ),
-                .stage     = vk::PipelineStageFlagBits::eVertexInput,
-            } );
-            compute_semaphore_ = std::nullopt;
+            // The handoff is submitted after the latest step on the compute queue.
+            LTB_CHECK( particles_ready, this->release_particles_to_graphics( drawn_range ) );
         }
-        wait_until_signaled.push_back( {
-            .semaphore = frame.image_semaphore,
-            .stage     = vk::PipelineStageFlagBits::eColorAttachmentOutput,
-        } );
+
+        LTB_CHECK( auto const camera_offset, this->update_camera_uniforms( frame ) );
+        LTB_CHECK( this->record_render_commands( frame, camera_offset ) );
+
+        auto wait_until_signaled = std::vector< vlk::objs::SemaphoreAndStage >{
+            particles_ready,
+            {
+                .semaphore = frame.image_semaphore,
+                .stage     = vk::PipelineStageFlagBits::eColorAttachmentOutput,
+            },
+        };
 
         LTB_CHECK(
             auto const& render_finished_semaphore,
-            graphics_cmd_and_sync_.get_present_semaphore( frame )
+            frames_->graphics_cmd_and_sync.get_present_semaphore( frame )
         );
 
-        LTB_CHECK( graphics_cmd_and_sync_.end_frame(
+        LTB_CHECK( frames_->graphics_cmd_and_sync.end_frame(
             frame,
             std::move( wait_until_signaled ),
             { render_finished_semaphore },
-            graphics_and_compute_queue_
+            graphics_batch_
         ) );
 
-        LTB_CHECK( graphics_cmd_and_sync_
+        // Compute work is sent first since this frame waits on it.
+        LTB_CHECK( compute_batch_.flush( ) );
+        LTB_CHECK( graphics_batch_.flush( ) );
+
+        frames_->particle_ranges[ drawn_range ].last_draw_value = frame.timeline_value;
+
+        LTB_CHECK( frames_->graphics_cmd_and_sync
                        .present_frame( frame, presentation_.swapchain( ), present_queue_ ) );
 
-        graphics_cmd_and_sync_.increment_frame( );
+        frames_->graphics_cmd_and_sync.increment_frame( );
     }
 
-    return utils::success( );
-}
+    // Sends the compute steps even when no swapchain image was acquired.
+    LTB_CHECK( compute_batch_.flush( ) );
+    LTB_CHECK( graphics_batch_.flush( ) );
 
-auto Particles2App::update_camera_uniforms( vlk::objs::FrameInfo const& frame )
-    -> utils::Result< void >
-{
-    if ( camera_frames_updated_.contains( frame.frame_index ) )
+    // Every command using the current pipelines has been submitted, so reloaded shaders
+    // can be swapped in for the next frame.
+    if ( shader_reloader_.is_initialized( ) )
     {
-        return utils::success( );
+        LTB_CHECK( shader_reloader_.swap_pipelines( ) );
     }
 
-    auto const camera_ubo = camera_.simple_render_params( );
-
-    LTB_CHECK_VALID( frame.frame_index < camera_ubo_.layout( ).ranges.size( ) );
-    auto const& memory_range = camera_ubo_.layout( ).ranges[ frame.frame_index ];
-
-    auto* const dst_data = camera_ubo_.mapped_data( ) + memory_range.offset;
-    LTB_CHECK_VALID( memory_range.size >= sizeof( camera_ubo ) );
-    LTB_CHECK_VALID( std::memcpy( dst_data, &camera_ubo, sizeof( camera_ubo ) ) == dst_data );
+    return utils::success( );
+}
 
-    camera_frames_updated_.emplace( frame.frame_index );
+auto Particles2App::update_camera_uniforms( vlk::objs::FrameInfo const& frame )
+    -> utils::Result< uint32 >
+{
+    LTB_CHECK( frames_->graphics_uniforms.start_frame( frame.frame_index ) );
 
-    return utils::success( );
+    return frames_->graphics_uniforms.push( camera_.simple_render_params( ) );
 }
 
-auto Particles2App::record_render_commands( vlk::objs::FrameInfo const& frame )
-    -> utils::Result< void >
+auto Particles2App::record_render_commands(
+    vlk::objs::FrameInfo const& frame,
+    uint32 const                camera_offset
+) -> utils::Result< void >
 {
+    // The range written by the most recent compute submission.
+    auto const compute_frame_index = frames_->compute_cmd_and_sync.previous_frame( );
+    LTB_CHECK_VALID( compute_frame_index < frames_->gpu_particles.layout( ).ranges.size( ) );
+    auto const& particle_range = frames_->gpu_particles.layout( ).ranges[ compute_frame_index ];
+
     VK_CHECK( frame.command_buffer.begin( vk::CommandBufferBeginInfo{ } ) );
 
+    if ( async_compute_ )
+    {
+        // Acquire the range released by `release_particles_to_graphics`.
+        frame.command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTopOfPipe,
+            vk::PipelineStageFlagBits::eVertexInput,
+            vk::DependencyFlags{ },
+            { },
+            ownership_barrier(
+                frames_->gpu_particles.buffer( ).get( ),
+                particle_range,
+                compute_family_,
+                graphics_family_
+            )
+                .setDstAccessMask( vk::AccessFlagBits::eVertexAttributeRead ),
+            { }
+        );
+    }
+
+    LTB_CHECK( vlk::objs::begin_gpu_scope( frame, "Render pass" ) );
     LTB_CHECK( presentation_.begin_render_pass( {
         .command_buffer    = frame.command_buffer,
         .image_index       = frame.image_index,
@@ -698,25 +1108,44 @@ auto Particles2App::record_render_commands( vlk::objs::FrameInfo const& frame )
 
     graphics_.bind( frame.command_buffer );
 
-    LTB_CHECK( graphics_.bind_descriptor_sets( frame ) );
-
-    auto const compute_frame_index = compute_cmd_and_sync_.frame_index( );
-    LTB_CHECK_VALID( compute_frame_index < gpu_particles_.layout( ).ranges.size( ) );
-    auto const& vbo_offset = gpu_particles_.layout( ).ranges[ compute_frame_index ].offset;
+    LTB_CHECK( graphics_.bind_descriptor_sets( frame, { camera_offset } ) );
 
     constexpr auto first_binding  = 0U;
-    auto const     vertex_buffers = std::array{ gpu_particles_.buffer( ).get( ) };
-    auto const     vertex_offsets = std::array{ vbo_offset };
+    auto const     vertex_buffers = std::array{ frames_->gpu_particles.buffer( ).get( ) };
+    auto const     vertex_offsets = std::array{ particle_range.offset };
     frame.command_buffer.bindVertexBuffers( first_binding, vertex_buffers, vertex_offsets );
 
     constexpr auto instance_count = 1U;
     constexpr auto first_vertex   = 0U;
     constexpr auto first_instance = 0U;
+    LTB_CHECK(
+        vlk::objs::begin_gpu_scope( frame, "Particles draw", vlk::objs::ScopeStatistics::Yes )
+    );
     frame.command_buffer.draw( particle_count, instance_count, first_vertex, first_instance );
+    LTB_CHECK( vlk::objs::end_gpu_scope( frame ) );
 
     imgui_.render( frame.command_buffer );
 
     frame.command_buffer.endRenderPass( );
+    LTB_CHECK( vlk::objs::end_gpu_scope( frame ) );
+
+    if ( async_compute_ )
+    {
+        // Release the range back to compute, which acquires it before overwriting it.
+        frame.command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eVertexInput,
+            vk::PipelineStageFlagBits::eBottomOfPipe,
+            vk::DependencyFlags{ },
+            { },
+            ownership_barrier(
+                frames_->gpu_particles.buffer( ).get( ),
+                particle_range,
+                graphics_family_,
+                compute_family_
+            ),
+            { }
+        );
+    }
 
     VK_CHECK( frame.command_buffer.end( ) );
 
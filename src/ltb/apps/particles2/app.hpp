@@ -5,6 +5,8 @@
 
 // project
 #include "ltb/cam/camera_2d.hpp"
+#include "ltb/exec/app_settings.hpp"
+#include "ltb/exec/frame_pacer.hpp"
 #include "ltb/exec/update_loop.hpp"
 #include "ltb/gui/imgui_glfw_vulkan_setup.hpp"
 #include "ltb/vlk/objs/vulkan_buffer.hpp"
@@ -12,9 +14,17 @@
 #include "ltb/vlk/objs/vulkan_compute_pipeline.hpp"
 #include "ltb/vlk/objs/vulkan_gpu.hpp"
 #include "ltb/vlk/objs/vulkan_graphics_pipeline.hpp"
+#include "ltb/vlk/objs/vulkan_pipeline_compiler.hpp"
+#include "ltb/vlk/objs/vulkan_readback.hpp"
+#include "ltb/vlk/objs/vulkan_shader_reloader.hpp"
+#include "ltb/vlk/objs/vulkan_submit_batch.hpp"
+#include "ltb/vlk/objs/vulkan_uniform_arena.hpp"
+#include "ltb/vlk/objs/vulkan_uploader.hpp"
+#include "ltb/vlk/objs/vulkan_workgroup_tuner.hpp"
 
 // standard
-#include <unordered_set>
+#include <deque>
+#include <memory>
 
 namespace ltb
 {
@@ -33,7 +43,11 @@ struct Particle
 class Particles2App
 {
 public:
-    explicit Particles2App( window::GlfwContext& glfw_context, window::GlfwWindow& glfw_window );
+    explicit Particles2App(
+        window::GlfwContext& glfw_context,
+        window::GlfwWindow&  glfw_window,
+        exec::AppSettings    app_settings
+    );
 
     auto initialize( ) -> utils::Result< exec::UpdateLoopStatus >;
 
@@ -51,47 +65,122 @@ public:
 private:
     window::GlfwContext& glfw_context_;
     window::GlfwWindow&  glfw_window_;
+    exec::AppSettings    app_settings_;
 
-    vlk::objs::VulkanGpu gpu_                        = { glfw_context_, glfw_window_ };
-    vk::Queue            graphics_and_compute_queue_ = nullptr;
-    vk::Queue            present_queue_              = nullptr;
+    // Everything created per frame in flight is sized by `max_frames_in_flight`.
+    exec::FramePacer frame_pacer_ = { exec::FramePacerSettings{
+        .max_frames_in_flight = app_settings_.frames_in_flight,
+    } };
+
+    vlk::objs::VulkanGpu gpu_             = { glfw_context_, glfw_window_ };
+    vk::Queue            graphics_queue_  = nullptr;
+    vk::Queue            compute_queue_   = nullptr;
+    vk::Queue            present_queue_   = nullptr;
+    vlk::QueueIndex      graphics_family_ = 0U;
+    vlk::QueueIndex      compute_family_  = 0U;
+
+    // True when the simulation runs on its own queue family, overlapping with rendering.
+    // The particle ranges then move between the families with ownership transfers.
+    bool async_compute_ = false;
+
+    // The compute steps and the frame's draw are sent with one submit per queue per
+    // frame. Compute shares the graphics batch when both use the same queue.
+    vlk::objs::VulkanSubmitBatch graphics_batch_ = { gpu_ };
+    vlk::objs::VulkanSubmitBatch compute_batch_  = { gpu_ };
 
     vlk::objs::VulkanPresentation presentation_ = { gpu_ };
     gui::ImguiGlfwVulkanSetup     imgui_        = { glfw_window_, gpu_, presentation_ };
 
-    vlk::objs::VulkanComputePipeline compute_              = { gpu_ };
-    vlk::objs::VulkanCommandAndSync  compute_cmd_and_sync_ = { gpu_ };
-    vlk::objs::VulkanBuffer          gpu_particles_        = { gpu_ };
+    vlk::objs::VulkanComputePipeline  compute_  = { gpu_ };
+    vlk::objs::VulkanGraphicsPipeline graphics_ = { gpu_, presentation_ };
+    vlk::objs::VulkanUploader         uploader_ = { gpu_ };
+
+    utils::Duration delta_time_ = utils::Duration::zero( );
+    cam::Camera2d   camera_     = { };
+
+    struct ParticleRange
+    {
+        /// \brief The graphics timeline value of the last frame that drew the range.
+        ///        Compute waits on it before overwriting the range.
+        uint64 last_draw_value = 0U;
+
+        /// \brief Released by the graphics family and not yet acquired back by compute.
+        bool with_graphics = false;
+    };
+
+    // Everything sized by `max_frames_in_flight`. Replaced as a whole when it changes.
+    struct FrameResources
+    {
+        vlk::objs::VulkanGpu& gpu;
+
+        vlk::objs::VulkanCommandAndSync compute_cmd_and_sync = { gpu };
+        vlk::objs::VulkanBuffer         gpu_particles        = { gpu };
+        vlk::objs::VulkanUniformArena   compute_uniforms     = { gpu };
+        std::vector< ParticleRange >    particle_ranges      = { };
 
-    utils::Duration              delta_time_             = utils::Duration::zero( );
-    vlk::objs::VulkanBuffer      compute_ubo_            = { gpu_ };
-    std::unordered_set< uint32 > compute_frames_updated_ = { };
+        // Releases the newest particle range to the graphics family each frame (async only).
+        vlk::objs::VulkanCommandAndSync handoff_cmd_and_sync = { gpu };
 
-    std::optional< vk::Semaphore > compute_semaphore_ = std::nullopt;
+        // The first particle is read back every compute frame and shown in the GUI.
+        vlk::objs::VulkanReadback               readback          = { gpu };
+        std::deque< vlk::objs::ReadbackHandle > pending_readbacks = { };
 
-    vlk::objs::VulkanGraphicsPipeline graphics_              = { gpu_, presentation_ };
-    vlk::objs::VulkanCommandAndSync   graphics_cmd_and_sync_ = { gpu_ };
+        vlk::objs::VulkanCommandAndSync graphics_cmd_and_sync = { gpu };
+        vlk::objs::VulkanUniformArena   graphics_uniforms     = { gpu };
+    };
+    std::unique_ptr< FrameResources > frames_ = nullptr;
 
-    vlk::objs::VulkanBuffer      camera_ubo_            = { gpu_ };
-    cam::Camera2d                camera_                = { };
-    std::unordered_set< uint32 > camera_frames_updated_ = { };
+    // Set from the GUI. The frame resources are rebuilt before the next frame if it
+    // differs from the pacer's `max_frames_in_flight`.
+    uint32 requested_frames_in_flight_ = frame_pacer_.settings( ).max_frames_in_flight;
+
+    Particle sampled_particle_ = { };
+
+    // Declared after the pipelines so it stops compiling before they are destroyed.
+    vlk::objs::VulkanPipelineCompiler pipeline_compiler_ = { gpu_ };
+
+    // Only initialized when LTB_SHADER_RELOAD is set. Rebuilds the pipelines as their
+    // shaders are edited.
+    vlk::objs::VulkanShaderReloader shader_reloader_ = { gpu_ };
+
+    // Picks the compute workgroup size for this device at startup.
+    vlk::objs::VulkanWorkgroupTuner workgroup_tuner_ = { gpu_ };
 
     bool initialized_ = false;
 
     auto initialize_gpu_presentation( ) -> utils::Result< Particles2App* >;
     auto initialize_compute_pipeline( ) -> utils::Result< Particles2App* >;
+    auto initialize_display_pipeline( ) -> utils::Result< Particles2App* >;
+    auto initialize_frames( ) -> utils::Result< Particles2App* >;
+    auto initialize_command_and_sync( ) -> utils::Result< Particles2App* >;
     auto initialize_compute_uniforms( ) -> utils::Result< Particles2App* >;
     auto initialize_particles( ) -> utils::Result< Particles2App* >;
-    auto initialize_display_pipeline( ) -> utils::Result< Particles2App* >;
     auto initialize_camera( ) -> utils::Result< Particles2App* >;
+    auto wait_for_pipelines( ) -> utils::Result< Particles2App* >;
+    auto tune_workgroup_size( ) -> utils::Result< Particles2App* >;
+    auto initialize_shader_reloader( ) -> utils::Result< Particles2App* >;
+
+    /// \brief Waits for the GPU to go idle and recreates every frame resource for
+    ///        `frame_count` frames. The particles start over from new positions.
+    auto rebuild_frames( uint32 frame_count ) -> utils::Result< void >;
 
     auto compute( ) -> utils::Result< void >;
-    auto update_compute_uniforms( vlk::objs::FrameInfo const& frame ) -> utils::Result< void >;
-    auto record_compute_commands( vlk::objs::FrameInfo const& frame ) -> utils::Result< void >;
+    auto update_compute_uniforms( vlk::objs::FrameInfo const& frame ) -> utils::Result< uint32 >;
+    auto record_compute_commands( vlk::objs::FrameInfo const& frame, uint32 uniforms_offset )
+        -> utils::Result< uint64 >;
+    auto acquire_particle_ranges(
+        vk::CommandBuffer const&     command_buffer,
+        std::vector< uint32 > const& range_indices
+    ) -> uint64;
+    auto release_particles_to_graphics( uint32 range_index )
+        -> utils::Result< vlk::objs::SemaphoreAndStage >;
+    auto compute_batch( ) -> vlk::objs::VulkanSubmitBatch&;
+    auto collect_readbacks( uint32 reused_frame_index ) -> utils::Result< void >;
 
     auto render( ) -> utils::Result< void >;
-    auto update_camera_uniforms( vlk::objs::FrameInfo const& frame ) -> utils::Result< void >;
-    auto record_render_commands( vlk::objs::FrameInfo const& frame ) -> utils::Result< void >;
+    auto update_camera_uniforms( vlk::objs::FrameInfo const& frame ) -> utils::Result< uint32 >;
+    auto record_render_commands( vlk::objs::FrameInfo const& frame, uint32 camera_offset )
+        -> utils::Result< void >;
 };
 
 } // namespace ltb
@@ -0,0 +1,45 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/exec/app_settings.hpp"
+
+// external
+#include <cxxopts.hpp>
+
+// standard
+#include <string>
+
+namespace ltb::exec
+{
+
+auto parse_app_settings( int32 const argc, char const* const* const argv )
+    -> utils::Result< AppSettings >
+{
+    auto settings = AppSettings{ };
+
+    auto options = cxxopts::Options{ ( argc > 0 ) ? argv[ 0 ] : "app" };
+    options.add_options( )(
+        "frames-in-flight",
+        "Number of frames given their own GPU resources",
+        cxxopts::value< uint32 >( )->default_value( std::to_string( settings.frames_in_flight ) )
+    );
+
+    try
+    {
+        auto const result         = options.parse( argc, argv );
+        settings.frames_in_flight = result[ "frames-in-flight" ].as< uint32 >( );
+    }
+    catch ( cxxopts::OptionException const& exception )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "{}\n{}", exception.what( ), options.help( ) );
+    }
+
+    if ( 0U == settings.frames_in_flight )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "--frames-in-flight must be at least 1" );
+    }
+
+    return settings;
+}
+
+} // namespace ltb::exec
@@ -0,0 +1,142 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/exec/frame_pacer.hpp"
+
+// standard
+#include <algorithm>
+#include <thread>
+
+namespace ltb::exec
+{
+namespace
+{
+
+// Low latency mode never keeps more frames than this in flight.
+constexpr auto low_latency_frames_in_flight = 2U;
+
+// The weight of a new sample in the smoothed measurements.
+constexpr auto smoothing_divisor = 10;
+
+auto smooth( utils::Duration const average, utils::Duration const sample ) -> utils::Duration
+{
+    if ( utils::Duration::zero( ) == average )
+    {
+        return sample;
+    }
+    return average + ( ( sample - average ) / smoothing_divisor );
+}
+
+} // namespace
+
+FramePacer::FramePacer( FramePacerSettings settings )
+    : settings_( std::move( settings ) )
+{
+    settings_.max_frames_in_flight = std::max( settings_.max_frames_in_flight, 1U );
+}
+
+auto FramePacer::set_mode( FramePacingMode const mode ) -> void
+{
+    settings_.mode = mode;
+    delay_         = utils::Duration::zero( );
+}
+
+auto FramePacer::frames_in_flight( ) const -> uint32
+{
+    switch ( settings_.mode )
+    {
+        using enum FramePacingMode;
+        case LowLatency:
+            return std::min( settings_.max_frames_in_flight, low_latency_frames_in_flight );
+        case Throughput:
+            break;
+    }
+    return settings_.max_frames_in_flight;
+}
+
+auto FramePacer::frames_completed( uint64 const completed_id ) -> void
+{
+    auto const now = std::chrono::steady_clock::now( );
+
+    // Completion is only observed when this is called, so each sample is an upper bound.
+    while ( ( !started_frames_.empty( ) ) && ( started_frames_.front( ).frame_id <= completed_id ) )
+    {
+        latency_ = smooth( latency_, now - started_frames_.front( ).start_time );
+        started_frames_.pop_front( );
+    }
+}
+
+auto FramePacer::begin_frame( uint64 const frame_id, utils::Duration const blocked ) -> void
+{
+    this->update_delay( blocked );
+
+    if ( delay_ > utils::Duration::zero( ) )
+    {
+        std::this_thread::sleep_for( delay_ );
+    }
+
+    auto const now = std::chrono::steady_clock::now( );
+    if ( TimePoint{ } != last_start_ )
+    {
+        frame_interval_ = smooth( frame_interval_, now - last_start_ );
+    }
+    last_start_ = now;
+
+    started_frames_.push_back( { .frame_id = frame_id, .start_time = now } );
+
+    // Frames that are never reported complete must not accumulate.
+    while ( started_frames_.size( ) > settings_.max_frames_in_flight )
+    {
+        started_frames_.pop_front( );
+    }
+}
+
+auto FramePacer::latency( ) const -> utils::Duration
+{
+    return latency_;
+}
+
+auto FramePacer::frame_interval( ) const -> utils::Duration
+{
+    return frame_interval_;
+}
+
+auto FramePacer::delay( ) const -> utils::Duration
+{
+    return delay_;
+}
+
+auto FramePacer::settings( ) const -> FramePacerSettings const&
+{
+    return settings_;
+}
+
+auto FramePacer::update_delay( utils::Duration const blocked ) -> void
+{
+    if ( FramePacingMode::LowLatency != settings_.mode )
+    {
+        delay_ = utils::Duration::zero( );
+        return;
+    }
+
+    // Time spent blocked on the GPU is time the frame could have started later without
+    // slowing anything down, so the delay moves that wait to before the frame starts
+    // (leaving `wait_margin`). Barely blocking means the GPU may be starving, so the
+    // delay backs off quickly.
+    if ( blocked < ( settings_.wait_margin / 2 ) )
+    {
+        delay_ /= 2;
+    }
+    else
+    {
+        delay_ += ( blocked - settings_.wait_margin ) / 2;
+    }
+
+    // Never sleep longer than a frame, e.g. after a hitch.
+    auto const max_delay = ( utils::Duration::zero( ) == frame_interval_ )
+                             ? utils::Duration::zero( )
+                             : frame_interval_;
+    delay_ = std::clamp( delay_, utils::Duration::zero( ), max_delay );
+}
+
+} // namespace ltb::exec
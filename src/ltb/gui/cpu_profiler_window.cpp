@@ -0,0 +1,52 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/gui/cpu_profiler_window.hpp"
+
+// project
+#include "ltb/gui/imgui.hpp"
+#include "ltb/utils/cpu_profiler.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+namespace ltb::gui
+{
+namespace
+{
+
+constexpr auto trace_export_path = "cpu_trace.json";
+
+} // namespace
+
+auto configure_cpu_profiler_window( ) -> void
+{
+    if ( ImGui::Begin( "CPU Profiler" ) )
+    {
+        auto recording = utils::is_cpu_profiler_enabled( );
+        if ( ImGui::Checkbox( "Record", &recording ) )
+        {
+            utils::set_cpu_profiler_enabled( recording );
+        }
+        ImGui::SameLine( );
+        if ( ImGui::Button( "Clear" ) )
+        {
+            utils::clear_cpu_profile( );
+        }
+        ImGui::SameLine( );
+        if ( ImGui::Button( "Export trace" ) )
+        {
+            if ( auto const result = utils::write_cpu_trace_json( trace_export_path ) )
+            {
+                spdlog::info( "CPU trace written to '{}'", trace_export_path );
+            }
+            else
+            {
+                spdlog::error( result.error( ).debug_error_message( ) );
+            }
+        }
+    }
+    ImGui::End( );
+}
+
+} // namespace ltb::gui
@@ -0,0 +1,87 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/gui/gpu_memory_window.hpp"
+
+// project
+#include "ltb/gui/imgui.hpp"
+#include "ltb/gui/imgui_utils.hpp"
+#include "ltb/vlk/objs/vulkan_gpu.hpp"
+
+namespace ltb::gui
+{
+namespace
+{
+
+constexpr auto bytes_per_mib = 1024.0 * 1024.0;
+
+auto to_mib( vk::DeviceSize const bytes ) -> float64
+{
+    return static_cast< float64 >( bytes ) / bytes_per_mib;
+}
+
+} // namespace
+
+auto configure_gpu_memory_window( vlk::objs::VulkanGpu const& gpu ) -> void
+{
+    if ( ImGui::Begin( "GPU Memory" ) )
+    {
+        auto const heaps = gpu.memory_heap_usage( );
+
+        for ( auto i = 0U; i < heaps.size( ); ++i )
+        {
+            auto const& heap = heaps[ i ];
+            auto const  id   = ScopedId{ static_cast< int >( i ) };
+
+            auto const device_local = static_cast< bool >(
+                heap.flags & vk::MemoryHeapFlagBits::eDeviceLocal
+            );
+            imgui_fmt< ImGui::Text >(
+                "Heap {} ({}, {})",
+                i,
+                device_local ? "device local" : "host",
+                heap.from_driver ? "driver budget" : "estimated"
+            );
+
+            auto const fraction = ( heap.budget > 0U )
+                                    ? static_cast< float32 >( heap.usage )
+                                          / static_cast< float32 >( heap.budget )
+                                    : 0.0F;
+            auto const overlay
+                = fmt::format( "{:.1f} / {:.1f} MiB", to_mib( heap.usage ), to_mib( heap.budget ) );
+            ImGui::ProgressBar( fraction, ImVec2( -1.0F, 0.0F ), overlay.c_str( ) );
+
+            imgui_fmt< ImGui::Text >(
+                "Allocated: {:.1f} MiB, used: {:.1f} MiB",
+                to_mib( heap.allocated ),
+                to_mib( heap.used )
+            );
+        }
+
+        ImGui::Separator( );
+
+        constexpr auto table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+        if ( ImGui::BeginTable( "Tags", 3, table_flags ) )
+        {
+            ImGui::TableSetupColumn( "Tag" );
+            ImGui::TableSetupColumn( "MiB" );
+            ImGui::TableSetupColumn( "Allocations" );
+            ImGui::TableHeadersRow( );
+
+            for ( auto const& tag : gpu.memory_tag_usage( ) )
+            {
+                ImGui::TableNextRow( );
+                ImGui::TableNextColumn( );
+                ImGui::Text( "%s", tag.tag.c_str( ) );
+                ImGui::TableNextColumn( );
+                imgui_fmt< ImGui::Text >( "{:.2f}", to_mib( tag.used ) );
+                ImGui::TableNextColumn( );
+                imgui_fmt< ImGui::Text >( "{}", tag.allocation_count );
+            }
+            ImGui::EndTable( );
+        }
+    }
+    ImGui::End( );
+}
+
+} // namespace ltb::gui
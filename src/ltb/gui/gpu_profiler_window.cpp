@@ -0,0 +1,115 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/gui/gpu_profiler_window.hpp"
+
+// project
+#include "ltb/gui/imgui.hpp"
+#include "ltb/gui/imgui_utils.hpp"
+#include "ltb/vlk/objs/vulkan_gpu_profiler.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+namespace ltb::gui
+{
+namespace
+{
+
+constexpr auto csv_export_path  = "gpu_profile.csv";
+constexpr auto json_export_path = "gpu_profile.json";
+
+auto log_export( utils::Result< void > const& result, char const* const file_path ) -> void
+{
+    if ( result )
+    {
+        spdlog::info( "GPU profile written to '{}'", file_path );
+    }
+    else
+    {
+        spdlog::error( result.error( ).debug_error_message( ) );
+    }
+}
+
+} // namespace
+
+auto configure_gpu_profiler_window(
+    std::vector< vlk::objs::VulkanGpuProfiler const* > const& profilers
+) -> void
+{
+    if ( ImGui::Begin( "GPU Profiler" ) )
+    {
+        auto stats = std::vector< vlk::objs::GpuScopeStats >{ };
+        for ( auto const* const profiler : profilers )
+        {
+            if ( ( nullptr != profiler ) && profiler->is_initialized( ) )
+            {
+                auto profiler_stats = profiler->stats( );
+                stats.insert( stats.end( ), profiler_stats.begin( ), profiler_stats.end( ) );
+            }
+        }
+
+        if ( ImGui::Button( "Export CSV" ) )
+        {
+            log_export( vlk::objs::write_gpu_stats_csv( csv_export_path, stats ), csv_export_path );
+        }
+        ImGui::SameLine( );
+        if ( ImGui::Button( "Export JSON" ) )
+        {
+            log_export(
+                vlk::objs::write_gpu_stats_json( json_export_path, stats ),
+                json_export_path
+            );
+        }
+
+        constexpr auto table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+        if ( ImGui::BeginTable( "Scopes", 5, table_flags ) )
+        {
+            ImGui::TableSetupColumn( "Scope" );
+            ImGui::TableSetupColumn( "Last (ms)" );
+            ImGui::TableSetupColumn( "Min (ms)" );
+            ImGui::TableSetupColumn( "Avg (ms)" );
+            ImGui::TableSetupColumn( "P99 (ms)" );
+            ImGui::TableHeadersRow( );
+
+            for ( auto const& scope : stats )
+            {
+                ImGui::TableNextRow( );
+                ImGui::TableNextColumn( );
+                ImGui::Text( "%s", scope.name.c_str( ) );
+                ImGui::TableNextColumn( );
+                imgui_fmt< ImGui::Text >( "{:.3f}", scope.last_ms );
+                ImGui::TableNextColumn( );
+                imgui_fmt< ImGui::Text >( "{:.3f}", scope.min_ms );
+                ImGui::TableNextColumn( );
+                imgui_fmt< ImGui::Text >( "{:.3f}", scope.avg_ms );
+                ImGui::TableNextColumn( );
+                imgui_fmt< ImGui::Text >( "{:.3f}", scope.p99_ms );
+            }
+            ImGui::EndTable( );
+        }
+
+        for ( auto const& scope : stats )
+        {
+            if ( scope.statistics.empty( ) )
+            {
+                continue;
+            }
+            if ( ImGui::TreeNode( scope.name.c_str( ) ) )
+            {
+                for ( auto const& statistic : scope.statistics )
+                {
+                    imgui_fmt< ImGui::Text >(
+                        "{}: {}",
+                        vk::to_string( statistic.counter ),
+                        statistic.value
+                    );
+                }
+                ImGui::TreePop( );
+            }
+        }
+    }
+    ImGui::End( );
+}
+
+} // namespace ltb::gui
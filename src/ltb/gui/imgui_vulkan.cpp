@@ -46,10 +46,13 @@ auto initialize_imgui_vulkan(
     init_info.Device         = gpu.device( ).get( );
     init_info.QueueFamily    = gpu.physical_device( ).queue_families( ).at( queue_type );
     init_info.Queue          = gpu.device( ).queues( ).at( queue_type );
-    init_info.DescriptorPool = gpu.descriptor_pool( ).get( );
+    init_info.PipelineCache  = gpu.pipeline_cache( ).get( );
     init_info.MinImageCount  = presentation.swapchain( ).min_image_count( );
     init_info.ImageCount = static_cast< uint32 >( presentation.swapchain_image_views( ).size( ) );
 
+    // ImGui frees the sets of its textures one at a time, so it gets a pool of its own.
+    init_info.DescriptorPoolSize = IMGUI_IMPL_VULKAN_MINIMUM_IMAGE_SAMPLER_POOL_SIZE;
+
     init_info.PipelineInfoMain.RenderPass = presentation.render_pass( ).get( );
     init_info.PipelineInfoMain.Subpass    = 0U;
 
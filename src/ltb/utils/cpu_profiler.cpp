@@ -0,0 +1,202 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/utils/cpu_profiler.hpp"
+
+// project
+#include "ltb/utils/ignore.hpp"
+#include "ltb/utils/json_escape.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ltb::utils
+{
+namespace
+{
+
+// Caps the memory a forgotten recording can use. Later zones on the thread are dropped.
+constexpr auto max_zones_per_thread = 1UZ << 20UZ;
+
+struct CompletedZone
+{
+    char const*      name       = nullptr;
+    Timer::TimePoint start_time = { };
+    Duration         duration   = Duration::zero( );
+};
+
+// Only its own thread appends to a buffer, so its mutex is uncontended except while a
+// trace is being written or cleared.
+struct ThreadZones
+{
+    std::mutex                   mutex         = { };
+    uint32                       thread_id     = 0U;
+    std::string                  thread_name   = { };
+    std::vector< CompletedZone > zones         = { };
+    std::size_t                  dropped_zones = 0UZ;
+};
+
+struct Registry
+{
+    std::mutex mutex = { };
+
+    // Buffers are shared so the zones of finished threads can still be written.
+    std::vector< std::shared_ptr< ThreadZones > > threads = { };
+
+    // Trace timestamps are relative to this.
+    Timer::TimePoint epoch = std::chrono::steady_clock::now( );
+};
+
+auto registry( ) -> Registry&
+{
+    static auto instance = Registry{ };
+    return instance;
+}
+
+auto thread_zones( ) -> ThreadZones&
+{
+    thread_local auto const zones = [] {
+        auto  new_zones = std::make_shared< ThreadZones >( );
+        auto& threads   = registry( );
+
+        auto const lock        = std::scoped_lock{ threads.mutex };
+        new_zones->thread_id   = static_cast< uint32 >( threads.threads.size( ) );
+        new_zones->thread_name = fmt::format( "Thread {}", new_zones->thread_id );
+        threads.threads.push_back( new_zones );
+
+        return new_zones;
+    }( );
+    return *zones;
+}
+
+} // namespace
+
+auto set_cpu_profiler_enabled( bool const enabled ) -> void
+{
+    // Creates the registry, and its epoch, before any zone can start.
+    utils::ignore( registry( ) );
+    detail::cpu_profiler_enabled.store( enabled, std::memory_order_relaxed );
+}
+
+auto set_cpu_profiler_thread_name( std::string name ) -> void
+{
+    auto&      zones  = thread_zones( );
+    auto const lock   = std::scoped_lock{ zones.mutex };
+    zones.thread_name = std::move( name );
+}
+
+auto clear_cpu_profile( ) -> void
+{
+    auto&      threads = registry( );
+    auto const lock    = std::scoped_lock{ threads.mutex };
+
+    for ( auto const& zones : threads.threads )
+    {
+        auto const zones_lock = std::scoped_lock{ zones->mutex };
+        zones->zones.clear( );
+        zones->dropped_zones = 0UZ;
+    }
+}
+
+auto write_cpu_trace_json( std::filesystem::path const& file_path ) -> Result< void >
+{
+    auto file = std::ofstream( file_path );
+    if ( !file.is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Failed to open file '{}'", file_path.string( ) );
+    }
+
+    auto&      threads = registry( );
+    auto const lock    = std::scoped_lock{ threads.mutex };
+
+    // Complete ("X") events give the start and duration of each zone. Viewers nest the
+    // zones of a thread by time.
+    auto separator = "";
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    for ( auto const& zones : threads.threads )
+    {
+        auto const zones_lock = std::scoped_lock{ zones->mutex };
+
+        file << fmt::format(
+            "{}{{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": {}, "
+            "\"args\": {{\"name\": \"{}\"}}}}",
+            separator,
+            zones->thread_id,
+            escape_json( zones->thread_name )
+        );
+        separator = ",\n";
+
+        if ( zones->dropped_zones > 0UZ )
+        {
+            spdlog::warn(
+                "CPU profile dropped {} zones on '{}'",
+                zones->dropped_zones,
+                zones->thread_name
+            );
+        }
+
+        // Zones are recorded when they end, so children come before their parents. Viewers
+        // expect parents first when zones start at the same time.
+        auto sorted = zones->zones;
+        std::ranges::sort( sorted, []( CompletedZone const& lhs, CompletedZone const& rhs ) {
+            return ( lhs.start_time == rhs.start_time ) ? ( lhs.duration > rhs.duration )
+                                                        : ( lhs.start_time < rhs.start_time );
+        } );
+
+        for ( auto const& zone : sorted )
+        {
+            file << fmt::format(
+                ",\n{{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 0, \"tid\": {}, \"ts\": {:.3f}, "
+                "\"dur\": {:.3f}}}",
+                escape_json( zone.name ),
+                zones->thread_id,
+                to_micros< float64 >( zone.start_time - threads.epoch ),
+                to_micros< float64 >( zone.duration )
+            );
+        }
+    }
+    file << "\n]}\n";
+
+    return success( );
+}
+
+CpuProfileZone::CpuProfileZone( char const* const name )
+    : name_( name )
+{
+    if ( is_cpu_profiler_enabled( ) )
+    {
+        timer_.emplace( );
+    }
+}
+
+CpuProfileZone::~CpuProfileZone( )
+{
+    if ( !timer_.has_value( ) )
+    {
+        return;
+    }
+
+    auto const duration = timer_->duration_since_start( );
+
+    auto&      zones = thread_zones( );
+    auto const lock  = std::scoped_lock{ zones.mutex };
+    if ( zones.zones.size( ) >= max_zones_per_thread )
+    {
+        ++zones.dropped_zones;
+        return;
+    }
+    zones.zones.push_back( {
+        .name       = name_,
+        .start_time = timer_->start_time( ),
+        .duration   = duration,
+    } );
+}
+
+} // namespace ltb::utils
@@ -0,0 +1,23 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/utils/json_escape.hpp"
+
+namespace ltb::utils
+{
+
+auto escape_json( std::string_view const text ) -> std::string
+{
+    auto escaped = std::string{ };
+    for ( auto const character : text )
+    {
+        if ( ( '"' == character ) || ( '\\' == character ) )
+        {
+            escaped.push_back( '\\' );
+        }
+        escaped.push_back( character );
+    }
+    return escaped;
+}
+
+} // namespace ltb::utils
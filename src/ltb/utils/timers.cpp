@@ -25,6 +25,11 @@ auto Timer::duration_since_start( ) -> Duration
     return time_now - start_time_;
 }
 
+auto Timer::start_time( ) const -> TimePoint
+{
+    return start_time_;
+}
+
 ScopedTimer::ScopedTimer( Callback callback )
     : callback_( std::move( callback ) )
 {
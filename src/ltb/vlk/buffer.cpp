@@ -77,4 +77,10 @@ auto Buffer::memory_requirements( ) const -> vk::MemoryRequirements const&
     return memory_requirements_;
 }
 
+auto Buffer::device_address( ) const -> vk::DeviceAddress
+{
+    auto const address_info = vk::BufferDeviceAddressInfo{ }.setBuffer( buffer_.get( ) );
+    return device_.get( ).getBufferAddress( address_info );
+}
+
 } // namespace ltb::vlk
@@ -6,21 +6,27 @@
 // project
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device.hpp"
+#include "ltb/vlk/pipeline_cache.hpp"
 #include "ltb/vlk/pipeline_layout.hpp"
 #include "ltb/vlk/shader_module.hpp"
 
 // external
 #include <spdlog/spdlog.h>
 
+// standard
+#include <utility>
+
 namespace ltb::vlk
 {
 
 ComputePipeline::ComputePipeline(
     Device&         device,
+    PipelineCache&  pipeline_cache,
     ShaderModule&   shader_module,
     PipelineLayout& pipeline_layout
 )
     : device_( device )
+    , pipeline_cache_( pipeline_cache )
     , shader_module_( shader_module )
     , pipeline_layout_( pipeline_layout )
 {
@@ -32,25 +38,19 @@ auto ComputePipeline::initialize( ) -> utils::Result< void >
     {
         return utils::success( );
     }
-    LTB_CHECK_VALID( device_.is_initialized( ) );
-    LTB_CHECK_VALID( shader_module_.is_initialized( ) );
-    LTB_CHECK_VALID( pipeline_layout_.is_initialized( ) );
+    LTB_CHECK( pipeline_, this->create( ) );
 
-    auto const shader_stage_info = shader_module_.get_shader_stage_create_info( );
-
-    auto const compute_pipeline_info = vk::ComputePipelineCreateInfo{ }
-                                           .setLayout( pipeline_layout_.get( ) )
-                                           .setStage( shader_stage_info );
+    return utils::success( );
+}
 
-    VK_CHECK(
-        auto pipeline,
-        device_.get( ).createComputePipelineUnique( nullptr, compute_pipeline_info )
-    );
-    spdlog::debug( "vk::createComputePipelineUnique()" );
+auto ComputePipeline::rebuild( ) -> utils::Result< vk::UniquePipeline >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK( auto pipeline, this->create( ) );
 
-    pipeline_ = std::move( pipeline );
+    std::swap( pipeline_, pipeline );
 
-    return utils::success( );
+    return pipeline;
 }
 
 auto ComputePipeline::is_initialized( ) const -> bool
@@ -68,4 +68,26 @@ auto ComputePipeline::get( ) -> vk::Pipeline&
     return pipeline_.get( );
 }
 
+auto ComputePipeline::create( ) const -> utils::Result< vk::UniquePipeline >
+{
+    LTB_CHECK_VALID( device_.is_initialized( ) );
+    LTB_CHECK_VALID( pipeline_cache_.is_initialized( ) );
+    LTB_CHECK_VALID( shader_module_.is_initialized( ) );
+    LTB_CHECK_VALID( pipeline_layout_.is_initialized( ) );
+
+    auto const shader_stage_info = shader_module_.get_shader_stage_create_info( );
+
+    auto const compute_pipeline_info = vk::ComputePipelineCreateInfo{ }
+                                           .setLayout( pipeline_layout_.get( ) )
+                                           .setStage( shader_stage_info );
+
+    VK_CHECK(
+        auto pipeline,
+        device_.get( ).createComputePipelineUnique( pipeline_cache_.get( ), compute_pipeline_info )
+    );
+    spdlog::debug( "vk::createComputePipelineUnique()" );
+
+    return pipeline;
+}
+
 } // namespace ltb::vlk
@@ -6,14 +6,20 @@
 // project
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device_memory_utils.hpp"
-#include "ltb/vlk/ltb_vlk_config.hpp"
+#include "ltb/vlk/embedded_spirv.hpp"
 #include "ltb/vlk/objs/frame_info.hpp"
+#include "ltb/vlk/objs/vulkan_parallel_recorder.hpp"
+#include "ltb/vlk/objs/vulkan_presentation.hpp"
+#include "ltb/vlk/objs/vulkan_uploader.hpp"
 
 // external
-#include "ltb/vlk/command_pool.hpp"
 #include <range/v3/range/conversion.hpp>
 #include <spdlog/spdlog.h>
 
+// standard
+#include <array>
+#include <cstring>
+
 namespace ltb::vlk::dd
 {
 
@@ -29,37 +35,159 @@ auto LinesPipeline2::initialize( LinesPipeline2Settings const& settings ) -> uti
     {
         return utils::success( );
     }
-    LTB_CHECK_VALID( settings.frame_count > 0U );
-    LTB_CHECK_VALID( settings.camera_ubo.is_initialized( ) );
+    LTB_CHECK_VALID( settings.camera_uniforms.is_initialized( ) );
+    LTB_CHECK_VALID( settings.camera_uniforms_size > 0U );
 
-    auto shader_modules = std::vector< ShaderModuleSettings >{
-        {
-            .spirv_file = config::shader_dir_path( ) / "lines_2d.vert.spv",
-            .stage      = vk::ShaderStageFlagBits::eVertex,
-        },
-        {
-            .spirv_file = config::shader_dir_path( ) / "lines_2d.frag.spv",
-            .stage      = vk::ShaderStageFlagBits::eFragment,
+    if ( nullptr != settings.bindless )
+    {
+        LTB_CHECK( this->initialize_bindless_pipeline( settings ) );
+    }
+    else
+    {
+        LTB_CHECK( this->initialize_vertex_pipeline( ) );
+    }
+
+    auto& descriptor_sets_list = pipeline_.descriptor_sets( );
+    LTB_CHECK_VALID( 1UZ == descriptor_sets_list.size( ) );
+
+    auto& descriptor_sets = descriptor_sets_list.front( );
+    LTB_CHECK_VALID( 1UZ == descriptor_sets.get( ).size( ) );
+
+    auto const descriptors = std::array{
+        DescriptorInfo{
+            .buffer = settings.camera_uniforms.descriptor_info( settings.camera_uniforms_size ),
         },
     };
+    LTB_CHECK( descriptor_sets.update( 0U, descriptors ) );
 
-    auto uniform_bindings = std::vector{
-        vk::DescriptorSetLayoutBinding{ }
-            .setBinding( 0U )
-            .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-            .setDescriptorCount( 1U )
-            .setStageFlags( vk::ShaderStageFlagBits::eVertex ),
+    initialized_ = true;
+
+    return utils::success( );
+}
+
+auto LinesPipeline2::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto LinesPipeline2::initialize_mesh( SimpleMesh2 const& mesh, objs::VulkanUploader& uploader )
+    -> utils::Result< SimpleMeshUniforms* >
+{
+    LTB_CHECK_VALID( uploader.is_initialized( ) );
+    LTB_CHECK_VALID( !mesh.positions.empty( ) );
+    LTB_CHECK_VALID( ( nullptr == bindless_ ) || ( draw_list_.size( ) < max_bindless_meshes_ ) );
+
+    auto const vertex_count   = static_cast< uint32 >( mesh.positions.size( ) );
+    auto const positions_size = vertex_count * SimpleMesh2::position_size_bytes;
+
+    auto vbo_layout = MemoryLayout{ };
+    append_memory_size( vbo_layout, positions_size );
+
+    auto& mesh_data = mesh_data_.emplace_back( gpu_ );
+
+    // Bindless shaders read the positions through the buffer's device address.
+    auto buffer_usage = vk::BufferUsageFlagBits::eVertexBuffer
+                      | vk::BufferUsageFlagBits::eIndexBuffer
+                      | vk::BufferUsageFlagBits::eTransferDst;
+    if ( nullptr != bindless_ )
+    {
+        buffer_usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+    }
+
+    LTB_CHECK( mesh_data.vbo.initialize( {
+        .layout             = std::move( vbo_layout ),
+        .buffer_usage       = buffer_usage,
+        .memory_properties  = vk::MemoryPropertyFlagBits::eDeviceLocal,
+        .store_mapped_value = false,
+    } ) );
+    LTB_CHECK_VALID( positions_size <= mesh_data.vbo.layout( ).total_size );
+
+    auto const& positions_range = mesh_data.vbo.layout( ).ranges.front( );
+    LTB_CHECK( uploader.upload(
+        mesh.positions.data( ),
+        positions_size,
+        mesh_data.vbo.buffer( ),
+        positions_range.offset
+    ) );
+
+    mesh_data.draw_count = vertex_count;
+    draw_list_.push_back( &mesh_data );
+
+    if ( nullptr != bindless_ )
+    {
+        auto const vbo_address = mesh_data.vbo.buffer( ).device_address( );
+        mesh_addresses_.push_back( vbo_address + positions_range.offset );
+    }
+
+    return &mesh_data.uniforms;
+}
+
+auto LinesPipeline2::draw( objs::FrameInfo const& frame, uint32 const camera_offset )
+    -> utils::Result< void >
+{
+    pipeline_.bind( frame.command_buffer );
+
+    LTB_CHECK( pipeline_.bind_descriptor_sets( frame, { camera_offset } ) );
+
+    if ( nullptr != bindless_ )
+    {
+        LTB_CHECK( this->write_mesh_records( frame ) );
+        LTB_CHECK( this->bind_bindless( frame ) );
+    }
+
+    for ( auto mesh_index = 0UZ; mesh_index < draw_list_.size( ); ++mesh_index )
+    {
+        LTB_CHECK( draw_mesh( mesh_index, frame ) );
+    }
+    return utils::success( );
+}
+
+auto LinesPipeline2::draw(
+    objs::FrameInfo const&        frame,
+    uint32 const                  camera_offset,
+    objs::VulkanParallelRecorder& recorder
+) -> utils::Result< void >
+{
+    LTB_CHECK( auto const inheritance, presentation_.inheritance_info( frame.image_index ) );
+
+    // Written once before the workers start since they all read the same records.
+    if ( nullptr != bindless_ )
+    {
+        LTB_CHECK( this->write_mesh_records( frame ) );
+    }
+
+    // Secondary command buffers start without any bound state.
+    auto const record_meshes = [ this, &frame, camera_offset ](
+                                   vk::CommandBuffer const& command_buffer,
+                                   std::size_t const        first,
+                                   std::size_t const        last
+                               ) -> utils::Result< void > {
+        auto worker_frame           = frame;
+        worker_frame.command_buffer = command_buffer;
+
+        pipeline_.bind( command_buffer );
+        LTB_CHECK( pipeline_.bind_descriptor_sets( worker_frame, { camera_offset } ) );
+        if ( nullptr != bindless_ )
+        {
+            LTB_CHECK( this->bind_bindless( worker_frame ) );
+        }
+        presentation_.set_viewport_and_scissor( command_buffer );
+
+        for ( auto mesh_index = first; mesh_index < last; ++mesh_index )
+        {
+            LTB_CHECK( draw_mesh( mesh_index, worker_frame ) );
+        }
+        return utils::success( );
     };
 
-    auto uniform_push_constants = std::vector{
-        vk::PushConstantRange{ }
-            .setStageFlags( vk::ShaderStageFlagBits::eVertex )
-            .setOffset( 0U )
-            .setSize( sizeof( SimpleModelUniforms ) ),
-        vk::PushConstantRange{ }
-            .setStageFlags( vk::ShaderStageFlagBits::eFragment )
-            .setOffset( sizeof( SimpleModelUniforms ) )
-            .setSize( sizeof( SimpleDisplayUniforms ) ),
+    return recorder.record( frame, inheritance, draw_list_.size( ), record_meshes );
+}
+
+auto LinesPipeline2::initialize_vertex_pipeline( ) -> utils::Result< void >
+{
+    auto shader_modules = std::vector< ShaderModuleSettings >{
+        shader_module_settings( "lines_2d.vert.spv", vk::ShaderStageFlagBits::eVertex ),
+        shader_module_settings( "lines_2d.frag.spv", vk::ShaderStageFlagBits::eFragment ),
     };
 
     auto vertex_bindings = std::vector{
@@ -77,11 +205,12 @@ auto LinesPipeline2::initialize( LinesPipeline2Settings const& settings ) -> uti
             .setOffset( 0U ),
     };
 
+    // The layouts are reflected from the shaders. The camera uniforms are selected with a
+    // dynamic offset.
     LTB_CHECK( pipeline_.initialize( {
-        .shader_modules         = std::move( shader_modules ),
-        .descriptor_set_count   = settings.frame_count,
-        .uniform_binding_sets   = { std::move( uniform_bindings ) },
-        .uniform_push_constants = std::move( uniform_push_constants ),
+        .shader_modules       = std::move( shader_modules ),
+        .descriptor_set_count = 1U,
+        .dynamic_buffers      = { { .set = 0U, .binding = 0U } },
 
         .pipeline = {
             .vertex_bindings    = std::move( vertex_bindings ),
@@ -91,142 +220,152 @@ auto LinesPipeline2::initialize( LinesPipeline2Settings const& settings ) -> uti
         },
     } ) );
 
-    auto const& descriptor_sets_list = pipeline_.descriptor_sets( );
-    LTB_CHECK_VALID( 1UZ == descriptor_sets_list.size( ) );
-
-    auto const& descriptor_sets = descriptor_sets_list.front( ).get( );
-    for ( auto frame_index = 0U; frame_index < settings.frame_count; ++frame_index )
-    {
-        LTB_CHECK_VALID( frame_index < settings.camera_ubo.layout( ).ranges.size( ) );
-        LTB_CHECK_VALID( frame_index < descriptor_sets.size( ) );
-
-        auto const& memory_range   = settings.camera_ubo.layout( ).ranges[ frame_index ];
-        auto const& descriptor_set = descriptor_sets[ frame_index ];
-
-        auto const descriptor_buffer_info = vk::DescriptorBufferInfo{ }
-                                                .setBuffer( settings.camera_ubo.buffer( ).get( ) )
-                                                .setOffset( memory_range.offset )
-                                                .setRange( memory_range.size );
-
-        auto const descriptor_writes = std::vector{
-            vk::WriteDescriptorSet{ }
-                .setDstSet( descriptor_set )
-                .setDstBinding( 0U )
-                .setDstArrayElement( 0U )
-                .setDescriptorType( vk::DescriptorType::eUniformBuffer )
-                .setBufferInfo( descriptor_buffer_info ),
-        };
-
-        gpu_.device( ).get( ).updateDescriptorSets( descriptor_writes, { } );
-    }
-
-    initialized_ = true;
-
     return utils::success( );
 }
 
-auto LinesPipeline2::is_initialized( ) const -> bool
-{
-    return initialized_;
-}
-
-auto LinesPipeline2::initialize_mesh(
-    SimpleMesh2 const& mesh,
-    CommandPool&       command_pool,
-    vk::Queue const&   queue
-) -> utils::Result< SimpleMeshUniforms* >
+auto LinesPipeline2::initialize_bindless_pipeline( LinesPipeline2Settings const& settings )
+    -> utils::Result< void >
 {
-    LTB_CHECK_VALID( command_pool.is_initialized( ) );
-    LTB_CHECK_VALID( !mesh.positions.empty( ) );
-
-    auto const vertex_count   = static_cast< uint32 >( mesh.positions.size( ) );
-    auto const positions_size = vertex_count * SimpleMesh2::position_size_bytes;
+    auto& bindless = *settings.bindless;
+    LTB_CHECK_VALID( bindless.is_initialized( ) );
+    LTB_CHECK_VALID( settings.max_bindless_meshes > 0U );
 
-    auto vbo_layout = MemoryLayout{ };
-    append_memory_size( vbo_layout, positions_size );
+    auto shader_modules = std::vector< ShaderModuleSettings >{
+        shader_module_settings( "lines_2d_bindless.vert.spv", vk::ShaderStageFlagBits::eVertex ),
+        shader_module_settings( "lines_2d_bindless.frag.spv", vk::ShaderStageFlagBits::eFragment ),
+    };
 
-    auto& mesh_data = mesh_data_.emplace_back( gpu_ );
+    // Positions are read through device addresses, so there are no vertex inputs. The
+    // table is bound at set 1, after the camera uniforms.
+    LTB_CHECK( pipeline_.initialize( {
+        .shader_modules       = std::move( shader_modules ),
+        .descriptor_set_count = 1U,
+        .dynamic_buffers      = { { .set = 0U, .binding = 0U } },
+        .external_sets        = { {
+            .set      = 1U,
+            .layout   = bindless.layout( ),
+            .bindings = bindless.bindings( ),
+        } },
 
-    LTB_CHECK( mesh_data.vbo.initialize( {
-        .layout       = std::move( vbo_layout ),
-        .buffer_usage = vk::BufferUsageFlagBits::eVertexBuffer
-                      | vk::BufferUsageFlagBits::eIndexBuffer
-                      | vk::BufferUsageFlagBits::eTransferDst,
-        .memory_properties  = vk::MemoryPropertyFlagBits::eDeviceLocal,
-        .store_mapped_value = false,
+        .pipeline = {
+            .vertex_bindings    = { },
+            .vertex_attributes  = { },
+            .primitive_topology = vk::PrimitiveTopology::eLineList,
+            .depth_stencil      = std::nullopt,
+        },
     } ) );
-    LTB_CHECK_VALID( positions_size <= mesh_data.vbo.layout( ).total_size );
 
-    auto staging_vbo = objs::VulkanBuffer{ gpu_ };
+    auto const frame_count  = settings.camera_uniforms.settings( ).frame_count;
+    auto const records_size = sizeof( BindlessMeshRecord ) * settings.max_bindless_meshes;
+    auto const alignment
+        = gpu_.physical_device( ).properties( ).limits.minStorageBufferOffsetAlignment;
 
-    LTB_CHECK( staging_vbo.initialize( {
-        .layout       = mesh_data.vbo.layout( ),
-        .buffer_usage = vk::BufferUsageFlagBits::eTransferSrc,
+    auto records_layout = MemoryLayout{ };
+    append_memory_size_n(
+        records_layout,
+        vk::MemoryRequirements{ records_size, alignment },
+        frame_count
+    );
+
+    LTB_CHECK( mesh_records_.initialize( {
+        .layout       = std::move( records_layout ),
+        .buffer_usage = vk::BufferUsageFlagBits::eStorageBuffer,
         .memory_properties
         = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
-        .store_mapped_value = false,
+        .store_mapped_value = true,
+        .tag                = "bindless mesh records",
     } ) );
-    LTB_CHECK_VALID( positions_size <= staging_vbo.layout( ).total_size );
 
-    LTB_CHECK(
-        auto* const mapped_staging_data,
-        staging_vbo.memory( ).map( {
-            .size = staging_vbo.layout( ).total_size,
-        } )
-    );
-    LTB_CHECK_VALID(
-        std::memcpy( mapped_staging_data, mesh.positions.data( ), positions_size )
-        == mapped_staging_data
-    );
-    staging_vbo.memory( ).unmap( );
-
-    auto tmp_command_buffer = CommandBuffer{ gpu_.device( ), command_pool };
-    LTB_CHECK( tmp_command_buffer.initialize( ) );
-    auto const& command_buffer = tmp_command_buffer.get( );
-
-    VK_CHECK( command_buffer.begin(
-        vk::CommandBufferBeginInfo{ }.setFlags( vk::CommandBufferUsageFlagBits::eOneTimeSubmit )
-    ) );
+    for ( auto const& range : mesh_records_.layout( ).ranges )
+    {
+        LTB_CHECK(
+            auto const handle,
+            bindless.add_storage_buffer( vk::DescriptorBufferInfo{ }
+                                             .setBuffer( mesh_records_.buffer( ).get( ) )
+                                             .setOffset( range.offset )
+                                             .setRange( records_size ) )
+        );
+        frame_records_.push_back( handle );
+    }
 
-    command_buffer.copyBuffer(
-        staging_vbo.buffer( ).get( ),
-        mesh_data.vbo.buffer( ).get( ),
-        { vk::BufferCopy{ }.setSize( staging_vbo.layout( ).total_size ) }
-    );
+    bindless_            = &bindless;
+    max_bindless_meshes_ = settings.max_bindless_meshes;
 
-    VK_CHECK( command_buffer.end( ) );
+    return utils::success( );
+}
 
-    auto const submit_info = vk::SubmitInfo{ }.setCommandBuffers( command_buffer );
+auto LinesPipeline2::write_mesh_records( objs::FrameInfo const& frame ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( frame.frame_index < mesh_records_.layout( ).ranges.size( ) );
+    LTB_CHECK_VALID( draw_list_.size( ) == mesh_addresses_.size( ) );
 
-    VK_CHECK( queue.submit( submit_info, nullptr ) );
-    VK_CHECK( queue.waitIdle( ) );
+    // The frame's previous commands are done, so its region is free to overwrite.
+    auto const& range   = mesh_records_.layout( ).ranges[ frame.frame_index ];
+    auto* const records = mesh_records_.mapped_data( ) + range.offset;
 
-    mesh_data.draw_count = vertex_count;
+    for ( auto mesh_index = 0UZ; mesh_index < draw_list_.size( ); ++mesh_index )
+    {
+        auto const record = BindlessMeshRecord{
+            .uniforms  = draw_list_[ mesh_index ]->uniforms,
+            .positions = mesh_addresses_[ mesh_index ],
+        };
+        std::memcpy( records + ( mesh_index * sizeof( record ) ), &record, sizeof( record ) );
+    }
 
-    return &mesh_data.uniforms;
+    return utils::success( );
 }
 
-auto LinesPipeline2::draw( objs::FrameInfo const& frame ) -> utils::Result< void >
+auto LinesPipeline2::bind_bindless( objs::FrameInfo const& frame ) -> utils::Result< void >
 {
-    pipeline_.bind( frame.command_buffer );
+    LTB_CHECK_VALID( frame.frame_index < frame_records_.size( ) );
 
-    LTB_CHECK( pipeline_.bind_descriptor_sets( frame ) );
+    constexpr auto bindless_set = 1U;
+    bindless_->bind(
+        frame,
+        vk::PipelineBindPoint::eGraphics,
+        pipeline_.pipeline_layout( ).get( ),
+        bindless_set
+    );
+
+    auto const     mesh_records = frame_records_[ frame.frame_index ];
+    constexpr auto offset       = 0U;
+    frame.command_buffer.pushConstants(
+        pipeline_.pipeline_layout( ).get( ),
+        vk::ShaderStageFlagBits::eVertex,
+        offset,
+        sizeof( mesh_records ),
+        &mesh_records
+    );
 
-    for ( auto const& mesh_data : mesh_data_ )
-    {
-        LTB_CHECK( draw_mesh( mesh_data, frame ) );
-    }
     return utils::success( );
 }
 
-auto LinesPipeline2::draw_mesh( MeshAndUniforms const& mesh_data, objs::FrameInfo const& frame )
+auto LinesPipeline2::draw_mesh( std::size_t const mesh_index, objs::FrameInfo const& frame )
     -> utils::Result< void >
 {
+    LTB_CHECK_VALID( mesh_index < draw_list_.size( ) );
+
+    auto const& mesh_data = *draw_list_[ mesh_index ];
     if ( mesh_data.draw_count <= 0U )
     {
         return utils::success( );
     }
 
+    if ( nullptr != bindless_ )
+    {
+        // The shader reads the mesh's record at `gl_InstanceIndex`, which starts at the
+        // first instance.
+        constexpr auto instance_count = 1U;
+        constexpr auto first_vertex   = 0U;
+        frame.command_buffer.draw(
+            mesh_data.draw_count,
+            instance_count,
+            first_vertex,
+            static_cast< uint32 >( mesh_index )
+        );
+        return utils::success( );
+    }
+
     constexpr auto model_offset = 0U;
     frame.command_buffer.pushConstants(
         pipeline_.pipeline_layout( ).get( ),
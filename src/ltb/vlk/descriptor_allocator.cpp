@@ -0,0 +1,150 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/descriptor_allocator.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+
+// external
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/transform.hpp>
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+
+namespace ltb::vlk
+{
+namespace
+{
+
+// Both mean the pool cannot fit the sets but a different pool might.
+auto is_pool_exhausted( vk::Result const result ) -> bool
+{
+    return ( vk::Result::eErrorOutOfPoolMemory == result )
+        || ( vk::Result::eErrorFragmentedPool == result );
+}
+
+} // namespace
+
+DescriptorAllocator::DescriptorAllocator( Device& device )
+    : device_( device )
+{
+}
+
+auto DescriptorAllocator::initialize( DescriptorAllocatorSettings settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( device_.is_initialized( ) );
+    LTB_CHECK_VALID( !settings.descriptors_per_set.empty( ) );
+    LTB_CHECK_VALID( settings.sets_per_pool > 0U );
+    LTB_CHECK_VALID( settings.sets_per_pool <= settings.max_sets_per_pool );
+
+    next_sets_per_pool_ = settings.sets_per_pool;
+    settings_           = std::move( settings );
+    initialized_        = true;
+
+    return utils::success( );
+}
+
+auto DescriptorAllocator::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto DescriptorAllocator::allocate( std::vector< vk::DescriptorSetLayout > const& layouts )
+    -> utils::Result< std::vector< vk::DescriptorSet > >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( !layouts.empty( ) );
+
+    while ( true )
+    {
+        auto const new_pool = ready_pools_.empty( );
+        if ( new_pool )
+        {
+            LTB_CHECK( this->add_pool( ) );
+        }
+
+        auto const allocate_info = vk::DescriptorSetAllocateInfo{ }
+                                       .setDescriptorPool( ready_pools_.back( ).get( ) )
+                                       .setSetLayouts( layouts );
+
+        auto descriptor_sets = device_.get( ).allocateDescriptorSets( allocate_info );
+
+        // A new pool that cannot fit the sets never will, so only older pools are retried.
+        if ( ( !new_pool ) && is_pool_exhausted( descriptor_sets.result ) )
+        {
+            full_pools_.push_back( std::move( ready_pools_.back( ) ) );
+            ready_pools_.pop_back( );
+            continue;
+        }
+
+        VK_CHECK( auto sets, std::move( descriptor_sets ) );
+        return sets;
+    }
+}
+
+auto DescriptorAllocator::allocate( vk::DescriptorSetLayout const& layout )
+    -> utils::Result< vk::DescriptorSet >
+{
+    LTB_CHECK( auto const descriptor_sets, this->allocate( std::vector{ layout } ) );
+    return descriptor_sets.front( );
+}
+
+auto DescriptorAllocator::reset( ) -> void
+{
+    for ( auto& pool : full_pools_ )
+    {
+        ready_pools_.push_back( std::move( pool ) );
+    }
+    full_pools_.clear( );
+
+    for ( auto const& pool : ready_pools_ )
+    {
+        device_.get( ).resetDescriptorPool( pool.get( ) );
+    }
+}
+
+auto DescriptorAllocator::pool_count( ) const -> std::size_t
+{
+    return ready_pools_.size( ) + full_pools_.size( );
+}
+
+auto DescriptorAllocator::settings( ) const -> DescriptorAllocatorSettings const&
+{
+    return settings_;
+}
+
+auto DescriptorAllocator::add_pool( ) -> utils::Result< void >
+{
+    auto const sets_per_pool = next_sets_per_pool_;
+
+    auto pool_sizes = settings_.descriptors_per_set
+                    | ranges::views::transform( [ sets_per_pool ]( vk::DescriptorPoolSize size ) {
+                          return size.setDescriptorCount( size.descriptorCount * sets_per_pool );
+                      } )
+                    | ranges::to< std::vector >( );
+
+    // Sets are only freed by resetting the whole pool, so `eFreeDescriptorSet` is not set.
+    auto pool = DescriptorPool{ device_ };
+    LTB_CHECK( pool.initialize( {
+        .pool_sizes = std::move( pool_sizes ),
+        .max_sets   = sets_per_pool,
+        .flags      = { },
+    } ) );
+    ready_pools_.push_back( std::move( pool ) );
+
+    next_sets_per_pool_ = std::min( sets_per_pool * 2U, settings_.max_sets_per_pool );
+
+    spdlog::debug( "Added a descriptor pool with room for {} sets", sets_per_pool );
+    return utils::success( );
+}
+
+} // namespace ltb::vlk
@@ -25,6 +25,8 @@ auto DescriptorPool::initialize( DescriptorPoolSettings settings ) -> utils::Res
         return utils::success( );
     }
     LTB_CHECK_VALID( device_.is_initialized( ) );
+    LTB_CHECK_VALID( !settings.pool_sizes.empty( ) );
+    LTB_CHECK_VALID( settings.max_sets > 0U );
 
     auto const descriptor_pool_info = vk::DescriptorPoolCreateInfo{ }
                                           .setPoolSizes( settings.pool_sizes )
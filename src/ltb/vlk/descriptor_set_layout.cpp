@@ -6,6 +6,7 @@
 // project
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device.hpp"
+#include "ltb/vlk/object_cache.hpp"
 
 // external
 #include <spdlog/spdlog.h>
@@ -26,8 +27,19 @@ auto DescriptorSetLayout::initialize( DescriptorSetLayoutSettings settings )
         return utils::success( );
     }
     LTB_CHECK_VALID( device_.is_initialized( ) );
+    LTB_CHECK_VALID(
+        settings.binding_flags.empty( )
+        || ( settings.binding_flags.size( ) == settings.bindings.size( ) )
+    );
+
+    auto const binding_flags_info = vk::DescriptorSetLayoutBindingFlagsCreateInfo{ }
+                                        .setBindingFlags( settings.binding_flags );
 
-    auto const create_info = vk::DescriptorSetLayoutCreateInfo{ }.setBindings( settings.bindings );
+    auto const create_info
+        = vk::DescriptorSetLayoutCreateInfo{ }
+              .setFlags( settings.flags )
+              .setBindings( settings.bindings )
+              .setPNext( settings.binding_flags.empty( ) ? nullptr : &binding_flags_info );
 
     VK_CHECK(
         auto descriptor_set_layout,
@@ -36,24 +48,47 @@ auto DescriptorSetLayout::initialize( DescriptorSetLayoutSettings settings )
     spdlog::debug( "vk::createDescriptorSetLayoutUnique()" );
 
     settings_              = std::move( settings );
-    descriptor_set_layout_ = std::move( descriptor_set_layout );
+    descriptor_set_layout_ = descriptor_set_layout.get( );
+    owned_layout_          = std::move( descriptor_set_layout );
+
+    return utils::success( );
+}
+
+auto DescriptorSetLayout::initialize( DescriptorSetLayoutSettings settings, ObjectCache& cache )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( cache.is_initialized( ) );
+
+    LTB_CHECK( auto const descriptor_set_layout, cache.descriptor_set_layout( settings ) );
+
+    settings_              = std::move( settings );
+    descriptor_set_layout_ = descriptor_set_layout;
 
     return utils::success( );
 }
 
 auto DescriptorSetLayout::is_initialized( ) const -> bool
 {
-    return nullptr != descriptor_set_layout_.get( );
+    return nullptr != descriptor_set_layout_;
 }
 
 auto DescriptorSetLayout::get( ) const -> vk::DescriptorSetLayout const&
 {
-    return descriptor_set_layout_.get( );
+    return descriptor_set_layout_;
 }
 
 auto DescriptorSetLayout::get( ) -> vk::DescriptorSetLayout&
 {
-    return descriptor_set_layout_.get( );
+    return descriptor_set_layout_;
+}
+
+auto DescriptorSetLayout::settings( ) const -> DescriptorSetLayoutSettings const&
+{
+    return settings_;
 }
 
 } // namespace ltb::vlk
@@ -6,19 +6,23 @@
 // project
 #include "ltb/utils/container_utils.hpp"
 #include "ltb/vlk/check.hpp"
-#include "ltb/vlk/descriptor_pool.hpp"
+#include "ltb/vlk/descriptor_allocator.hpp"
 #include "ltb/vlk/device.hpp"
 
 // external
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/transform.hpp>
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
 
 namespace ltb::vlk
 {
 
-DescriptorSets::DescriptorSets( Device& device, DescriptorPool& descriptor_pool )
+DescriptorSets::DescriptorSets( Device& device, DescriptorAllocator& descriptor_allocator )
     : device_( device )
-    , descriptor_pool_( descriptor_pool )
+    , descriptor_allocator_( descriptor_allocator )
 {
 }
 
@@ -29,15 +33,17 @@ auto DescriptorSets::initialize( DescriptorSetsSettings settings ) -> utils::Res
         return utils::success( );
     }
     LTB_CHECK_VALID( device_.is_initialized( ) );
-    LTB_CHECK_VALID( descriptor_pool_.is_initialized( ) );
+    LTB_CHECK_VALID( descriptor_allocator_.is_initialized( ) );
+
+    LTB_CHECK( auto descriptor_sets, descriptor_allocator_.allocate( settings.layouts ) );
 
-    auto const descriptor_set_info = vk::DescriptorSetAllocateInfo{ }
-                                         .setDescriptorPool( descriptor_pool_.get( ) )
-                                         .setSetLayouts( settings.layouts );
+    settings_ = std::move( settings );
 
-    VK_CHECK( auto descriptor_sets, device_.get( ).allocateDescriptorSets( descriptor_set_info ) );
+    if ( !settings_.bindings.empty( ) )
+    {
+        LTB_CHECK( this->initialize_update_template( ) );
+    }
 
-    settings_        = std::move( settings );
     descriptor_sets_ = std::move( descriptor_sets );
 
     return utils::success( );
@@ -48,6 +54,25 @@ auto DescriptorSets::is_initialized( ) const -> bool
     return !descriptor_sets_.empty( );
 }
 
+auto DescriptorSets::update(
+    uint32 const                      set_index,
+    std::span< DescriptorInfo const > descriptors
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( update_template_ );
+    LTB_CHECK_VALID( set_index < descriptor_sets_.size( ) );
+    LTB_CHECK_VALID( descriptor_count_ == descriptors.size( ) );
+
+    device_.get( ).updateDescriptorSetWithTemplate(
+        descriptor_sets_[ set_index ],
+        update_template_.get( ),
+        descriptors.data( )
+    );
+
+    return utils::success( );
+}
+
 auto DescriptorSets::get( ) const -> std::vector< vk::DescriptorSet > const&
 {
     return descriptor_sets_;
@@ -61,7 +86,9 @@ auto DescriptorSets::get( ) -> std::vector< vk::DescriptorSet >&
 auto DescriptorSets::reset( ) -> void
 {
     descriptor_sets_.clear( );
-    settings_ = { };
+    update_template_.reset( );
+    descriptor_count_ = 0U;
+    settings_         = { };
 }
 
 auto DescriptorSets::settings( ) const -> DescriptorSetsSettings const&
@@ -69,4 +96,46 @@ auto DescriptorSets::settings( ) const -> DescriptorSetsSettings const&
     return settings_;
 }
 
+auto DescriptorSets::initialize_update_template( ) -> utils::Result< void >
+{
+    // One template works for every set only if they all share a layout.
+    LTB_CHECK_VALID( std::ranges::all_of( settings_.layouts, [ this ]( auto const& layout ) {
+        return layout == settings_.layouts.front( );
+    } ) );
+
+    auto bindings = settings_.bindings;
+    std::ranges::sort( bindings, { }, &vk::DescriptorSetLayoutBinding::binding );
+
+    // Every array element reads the next `DescriptorInfo` in the caller's array.
+    auto entries          = std::vector< vk::DescriptorUpdateTemplateEntry >{ };
+    auto descriptor_count = 0U;
+    for ( auto const& binding : bindings )
+    {
+        entries.push_back( vk::DescriptorUpdateTemplateEntry{ }
+                               .setDstBinding( binding.binding )
+                               .setDstArrayElement( 0U )
+                               .setDescriptorCount( binding.descriptorCount )
+                               .setDescriptorType( binding.descriptorType )
+                               .setOffset( descriptor_count * sizeof( DescriptorInfo ) )
+                               .setStride( sizeof( DescriptorInfo ) ) );
+        descriptor_count += binding.descriptorCount;
+    }
+
+    auto const create_info
+        = vk::DescriptorUpdateTemplateCreateInfo{ }
+              .setDescriptorUpdateEntries( entries )
+              .setTemplateType( vk::DescriptorUpdateTemplateType::eDescriptorSet )
+              .setDescriptorSetLayout( settings_.layouts.front( ) );
+
+    VK_CHECK(
+        update_template_,
+        device_.get( ).createDescriptorUpdateTemplateUnique( create_info )
+    );
+    spdlog::debug( "vk::createDescriptorUpdateTemplateUnique()" );
+
+    descriptor_count_ = descriptor_count;
+
+    return utils::success( );
+}
+
 } // namespace ltb::vlk
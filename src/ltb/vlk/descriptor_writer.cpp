@@ -0,0 +1,66 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/descriptor_writer.hpp"
+
+// project
+#include "ltb/vlk/device.hpp"
+
+namespace ltb::vlk
+{
+
+DescriptorWriter::DescriptorWriter( Device& device )
+    : device_( device )
+{
+}
+
+auto DescriptorWriter::write_buffer(
+    vk::DescriptorSet const         descriptor_set,
+    uint32 const                    binding,
+    vk::DescriptorType const        type,
+    vk::DescriptorBufferInfo const& info
+) -> void
+{
+    writes_.push_back( vk::WriteDescriptorSet{ }
+                           .setDstSet( descriptor_set )
+                           .setDstBinding( binding )
+                           .setDstArrayElement( 0U )
+                           .setDescriptorType( type )
+                           .setBufferInfo( buffer_infos_.emplace_back( info ) ) );
+}
+
+auto DescriptorWriter::write_image(
+    vk::DescriptorSet const        descriptor_set,
+    uint32 const                   binding,
+    vk::DescriptorType const       type,
+    vk::DescriptorImageInfo const& info
+) -> void
+{
+    writes_.push_back( vk::WriteDescriptorSet{ }
+                           .setDstSet( descriptor_set )
+                           .setDstBinding( binding )
+                           .setDstArrayElement( 0U )
+                           .setDescriptorType( type )
+                           .setImageInfo( image_infos_.emplace_back( info ) ) );
+}
+
+auto DescriptorWriter::flush( ) -> void
+{
+    if ( this->empty( ) )
+    {
+        return;
+    }
+
+    device_.get( ).updateDescriptorSets( writes_, { } );
+
+    writes_.clear( );
+    buffer_infos_.clear( );
+    image_infos_.clear( );
+}
+
+auto DescriptorWriter::empty( ) const -> bool
+{
+    return writes_.empty( );
+}
+
+} // namespace ltb::vlk
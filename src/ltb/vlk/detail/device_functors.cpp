@@ -108,6 +108,37 @@ auto CheckFeatureSupport::operator( )( vk::PhysicalDevice const& physical_device
     return physical_device;
 }
 
+auto CheckCoreFeatureSupport::operator( )( vk::PhysicalDevice const& physical_device ) const
+    -> utils::Result< vk::PhysicalDevice >
+{
+    auto const api_version = physical_device.getProperties( ).apiVersion;
+    if ( api_version < VK_API_VERSION_1_3 )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Vulkan {}.{} is not supported on this device (1.3 is required)",
+            VK_API_VERSION_MAJOR( api_version ),
+            VK_API_VERSION_MINOR( api_version )
+        );
+    }
+
+    auto const features = physical_device.getFeatures2<
+        vk::PhysicalDeviceFeatures2,
+        vk::PhysicalDeviceVulkan12Features,
+        vk::PhysicalDeviceVulkan13Features >( );
+    auto const& vulkan_12_features = features.get< vk::PhysicalDeviceVulkan12Features >( );
+    auto const& vulkan_13_features = features.get< vk::PhysicalDeviceVulkan13Features >( );
+
+    if ( ( !vulkan_12_features.timelineSemaphore ) || ( !vulkan_12_features.hostQueryReset )
+         || ( !vulkan_13_features.synchronization2 ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Timeline semaphores, host query resets or synchronization2 are not supported on "
+            "this device"
+        );
+    }
+    return physical_device;
+}
+
 auto CheckSurfaceSupport::operator( )( vk::PhysicalDevice const& physical_device ) const
     -> utils::Result< vk::PhysicalDevice >
 {
@@ -56,8 +56,6 @@ auto Device::initialize( ) -> utils::Result< void >
     }
     LTB_CHECK_VALID( physical_device_.is_initialized( ) );
 
-    auto const& settings = physical_device_.settings( );
-
     auto const queue_priorities = std::vector{ 1.0f };
 
     auto const queue_create_infos
@@ -67,21 +65,37 @@ auto Device::initialize( ) -> utils::Result< void >
 
     auto enable_fifo_latest_ready = vk::PhysicalDevicePresentModeFifoLatestReadyFeaturesKHR{ true };
 
+    // Physical device selection only accepts Vulkan 1.3 devices that support these and
+    // synchronization2.
+    auto vulkan_12_features = vk::PhysicalDeviceVulkan12Features{ }
+                                  .setTimelineSemaphore( true )
+                                  .setHostQueryReset( true );
+
+    if ( physical_device_.has_bindless( ) )
+    {
+        for ( auto const feature : bindless_features )
+        {
+            ( vulkan_12_features.*feature ) = true;
+        }
+    }
+
+    // Required by vkQueueSubmit2, core since Vulkan 1.3.
+    auto vulkan_13_features = vk::PhysicalDeviceVulkan13Features{ }.setSynchronization2( true );
+    vulkan_12_features.pNext = &vulkan_13_features;
+
     auto  device_features_2 = vk::PhysicalDeviceFeatures2{ };
     auto& device_features   = device_features_2.features;
 
-    for ( auto const feature : settings.device_features )
+    for ( auto const feature : physical_device_.device_features( ) )
     {
         ( device_features.*feature ) = true;
     }
 
-    if ( std::ranges::find(
-             physical_device_.extensions( ),
-             VK_KHR_PRESENT_MODE_FIFO_LATEST_READY_EXTENSION_NAME
-         )
-         != physical_device_.extensions( ).end( ) )
+    device_features_2.pNext = &vulkan_12_features;
+
+    if ( physical_device_.has_extension( VK_KHR_PRESENT_MODE_FIFO_LATEST_READY_EXTENSION_NAME ) )
     {
-        device_features_2.pNext = &enable_fifo_latest_ready;
+        vulkan_13_features.pNext = &enable_fifo_latest_ready;
     }
 
     auto const create_info = vk::DeviceCreateInfo{ }
@@ -57,9 +57,12 @@ auto DeviceMemory::initialize( DeviceMemorySettings const settings ) -> utils::R
     }
     LTB_CHECK_VALID( device_.is_initialized( ) );
 
+    auto const flags_info = vk::MemoryAllocateFlagsInfo{ }.setFlags( settings.allocate_flags );
+
     auto const alloc_info = vk::MemoryAllocateInfo{ }
                                 .setAllocationSize( settings.allocation_size )
-                                .setMemoryTypeIndex( settings.memory_type_index );
+                                .setMemoryTypeIndex( settings.memory_type_index )
+                                .setPNext( settings.allocate_flags ? &flags_info : nullptr );
 
     VK_CHECK( auto memory, device_.get( ).allocateMemoryUnique( alloc_info ) );
     spdlog::debug( "vk::allocateMemoryUnique()" );
@@ -0,0 +1,427 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/device_memory_allocator.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+#include "ltb/vlk/physical_device.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <optional>
+
+namespace ltb::vlk
+{
+namespace
+{
+
+auto align_up( vk::DeviceSize const value, vk::DeviceSize const alignment ) -> vk::DeviceSize
+{
+    return ( ( value + alignment ) - 1U ) / alignment * alignment;
+}
+
+/// \brief First-fit search of the free list. The chosen range is split so any
+///        alignment padding and the unused tail stay available.
+auto take_range(
+    std::map< vk::DeviceSize, vk::DeviceSize >& free_ranges,
+    vk::DeviceSize const                        size,
+    vk::DeviceSize const                        alignment
+) -> std::optional< vk::DeviceSize >
+{
+    for ( auto iter = free_ranges.begin( ); iter != free_ranges.end( ); ++iter )
+    {
+        auto const [ offset, range_size ] = *iter;
+
+        auto const aligned_offset = align_up( offset, alignment );
+        auto const padding        = aligned_offset - offset;
+
+        if ( ( padding + size ) > range_size )
+        {
+            continue;
+        }
+
+        free_ranges.erase( iter );
+
+        if ( padding > 0U )
+        {
+            free_ranges.emplace( offset, padding );
+        }
+        if ( auto const tail = range_size - padding - size; tail > 0U )
+        {
+            free_ranges.emplace( aligned_offset + size, tail );
+        }
+
+        return aligned_offset;
+    }
+
+    return std::nullopt;
+}
+
+auto return_range(
+    std::map< vk::DeviceSize, vk::DeviceSize >& free_ranges,
+    MemoryRange const&                          range
+) -> void
+{
+    auto [ iter, inserted ] = free_ranges.emplace( range.offset, range.size );
+    if ( !inserted )
+    {
+        spdlog::error( "Device memory range at offset {} was freed twice", range.offset );
+        return;
+    }
+
+    // Merge with the following range.
+    if ( auto next = std::next( iter );
+         ( next != free_ranges.end( ) ) && ( ( iter->first + iter->second ) == next->first ) )
+    {
+        iter->second += next->second;
+        free_ranges.erase( next );
+    }
+
+    // Merge with the preceding range.
+    if ( iter != free_ranges.begin( ) )
+    {
+        if ( auto prev = std::prev( iter ); ( prev->first + prev->second ) == iter->first )
+        {
+            prev->second += iter->second;
+            free_ranges.erase( iter );
+        }
+    }
+}
+
+} // namespace
+
+DeviceMemoryAllocator::MemoryBlock::MemoryBlock( Device& device )
+    : memory( device )
+{
+}
+
+DeviceMemoryAllocator::DeviceMemoryAllocator( Device& device )
+    : device_( device )
+{
+}
+
+auto DeviceMemoryAllocator::initialize( DeviceMemoryAllocatorSettings const settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( device_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.block_size > 0U );
+
+    auto const& physical_device = device_.physical_device( );
+    auto const& limits          = physical_device.properties( ).limits;
+
+    settings_               = settings;
+    memory_properties_      = physical_device.get( ).getMemoryProperties( );
+    image_granularity_      = std::max( limits.bufferImageGranularity, vk::DeviceSize{ 1U } );
+    non_coherent_atom_size_ = std::max( limits.nonCoherentAtomSize, vk::DeviceSize{ 1U } );
+    has_budget_ext_         = physical_device.has_extension( VK_EXT_MEMORY_BUDGET_EXTENSION_NAME );
+
+    heap_allocated_.assign( memory_properties_.memoryHeapCount, 0U );
+    heap_used_.assign( memory_properties_.memoryHeapCount, 0U );
+
+    initialized_ = true;
+
+    return utils::success( );
+}
+
+auto DeviceMemoryAllocator::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto DeviceMemoryAllocator::reset( ) -> void
+{
+    blocks_.clear( );
+    heap_allocated_.clear( );
+    heap_used_.clear( );
+    tags_.clear( );
+    tag_indices_.clear( );
+    memory_properties_      = vk::PhysicalDeviceMemoryProperties{ };
+    image_granularity_      = 1U;
+    non_coherent_atom_size_ = 1U;
+    has_budget_ext_         = false;
+    settings_               = { };
+    initialized_            = false;
+}
+
+auto DeviceMemoryAllocator::allocate(
+    vk::MemoryRequirements const& memory_requirements,
+    vk::MemoryPropertyFlags const memory_properties,
+    AllocationTiling const        tiling,
+    std::string_view const        tag
+) -> utils::Result< DeviceAllocation >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( memory_requirements.size > 0U );
+
+    LTB_CHECK(
+        auto const memory_type_index,
+        device_.physical_device( ).find_memory_type_index(
+            std::vector{ memory_requirements },
+            memory_properties
+        )
+    );
+
+    auto size      = memory_requirements.size;
+    auto alignment = std::max( memory_requirements.alignment, vk::DeviceSize{ 1U } );
+
+    if ( AllocationTiling::Optimal == tiling )
+    {
+        // Give optimally tiled resources whole granularity pages so they
+        // can never share a page with a linear resource in the same block.
+        size      = align_up( size, image_granularity_ );
+        alignment = std::max( alignment, image_granularity_ );
+    }
+
+    auto const type_flags = memory_properties_.memoryTypes[ memory_type_index ].propertyFlags;
+    if ( ( type_flags & vk::MemoryPropertyFlagBits::eHostVisible )
+         && !( type_flags & vk::MemoryPropertyFlagBits::eHostCoherent ) )
+    {
+        // Keep non-coherent allocations on whole atoms so flushing or invalidating
+        // them never touches a neighbouring allocation.
+        size      = align_up( size, non_coherent_atom_size_ );
+        alignment = std::max( alignment, non_coherent_atom_size_ );
+    }
+
+    auto& blocks = blocks_[ memory_type_index ];
+
+    auto* block  = static_cast< MemoryBlock* >( nullptr );
+    auto  offset = std::optional< vk::DeviceSize >{ };
+
+    for ( auto& existing_block : blocks )
+    {
+        if ( existing_block.dedicated )
+        {
+            continue;
+        }
+        if ( ( offset = take_range( existing_block.free_ranges, size, alignment ) ) )
+        {
+            block = &existing_block;
+            break;
+        }
+    }
+
+    if ( nullptr == block )
+    {
+        auto const dedicated  = ( size > settings_.block_size );
+        auto const block_size = dedicated ? align_up( size, alignment ) : settings_.block_size;
+
+        LTB_CHECK( block, this->allocate_block( memory_type_index, block_size, dedicated ) );
+
+        offset = take_range( block->free_ranges, size, alignment );
+        LTB_CHECK_VALID( offset.has_value( ) );
+    }
+
+    auto allocation = DeviceAllocation{
+        .memory            = block->memory.get( ),
+        .range             = { .size = size, .offset = offset.value( ) },
+        .memory_type_index = memory_type_index,
+        .tag_index         = this->find_or_add_tag( tag ),
+        .mapped_data       = nullptr,
+    };
+
+    if ( nullptr != block->mapped )
+    {
+        allocation.mapped_data = block->mapped + allocation.range.offset;
+    }
+
+    heap_used_[ this->heap_index( memory_type_index ) ] += size;
+
+    auto& tag_usage = tags_[ allocation.tag_index ];
+    tag_usage.used += size;
+    ++tag_usage.allocation_count;
+
+    return allocation;
+}
+
+auto DeviceMemoryAllocator::free( DeviceAllocation const& allocation ) -> void
+{
+    if ( nullptr == allocation.memory )
+    {
+        return;
+    }
+
+    auto blocks_iter = blocks_.find( allocation.memory_type_index );
+    if ( blocks_iter == blocks_.end( ) )
+    {
+        return;
+    }
+    auto& blocks = blocks_iter->second;
+
+    auto block_iter = blocks.begin( );
+    while ( ( block_iter != blocks.end( ) ) && ( block_iter->memory.get( ) != allocation.memory ) )
+    {
+        ++block_iter;
+    }
+    if ( block_iter == blocks.end( ) )
+    {
+        return;
+    }
+
+    return_range( block_iter->free_ranges, allocation.range );
+
+    auto const heap = this->heap_index( allocation.memory_type_index );
+    heap_used_[ heap ] -= allocation.range.size;
+
+    if ( allocation.tag_index < tags_.size( ) )
+    {
+        auto& tag_usage = tags_[ allocation.tag_index ];
+        tag_usage.used -= allocation.range.size;
+        --tag_usage.allocation_count;
+    }
+
+    // Dedicated blocks only ever hold one allocation so they are released immediately.
+    // Pooled blocks are kept around so later allocations can reuse them.
+    if ( block_iter->dedicated )
+    {
+        heap_allocated_[ heap ] -= block_iter->size;
+        blocks.erase( block_iter );
+    }
+}
+
+auto DeviceMemoryAllocator::settings( ) const -> DeviceMemoryAllocatorSettings const&
+{
+    return settings_;
+}
+
+auto DeviceMemoryAllocator::heap_usage( ) const -> std::vector< MemoryHeapUsage >
+{
+    auto heaps = std::vector< MemoryHeapUsage >( memory_properties_.memoryHeapCount );
+
+    for ( auto i = 0U; i < memory_properties_.memoryHeapCount; ++i )
+    {
+        auto const& heap = memory_properties_.memoryHeaps[ i ];
+
+        heaps[ i ] = MemoryHeapUsage{
+            .flags       = heap.flags,
+            .size        = heap.size,
+            .budget      = heap.size,
+            .usage       = heap_allocated_[ i ],
+            .allocated   = heap_allocated_[ i ],
+            .used        = heap_used_[ i ],
+            .from_driver = false,
+        };
+    }
+
+    if ( has_budget_ext_ )
+    {
+        auto const& physical_device = device_.physical_device( ).get( );
+        auto const  properties      = physical_device.getMemoryProperties2<
+             vk::PhysicalDeviceMemoryProperties2,
+             vk::PhysicalDeviceMemoryBudgetPropertiesEXT >( );
+        auto const& budget = properties.get< vk::PhysicalDeviceMemoryBudgetPropertiesEXT >( );
+
+        for ( auto i = 0U; i < memory_properties_.memoryHeapCount; ++i )
+        {
+            heaps[ i ].budget      = budget.heapBudget[ i ];
+            heaps[ i ].usage       = budget.heapUsage[ i ];
+            heaps[ i ].from_driver = true;
+        }
+    }
+
+    return heaps;
+}
+
+auto DeviceMemoryAllocator::tag_usage( ) const -> std::vector< MemoryTagUsage > const&
+{
+    return tags_;
+}
+
+auto DeviceMemoryAllocator::allocate_block(
+    uint32 const         memory_type_index,
+    vk::DeviceSize const size,
+    bool const           dedicated
+) -> utils::Result< MemoryBlock* >
+{
+    auto& block = blocks_[ memory_type_index ].emplace_back( device_ );
+
+    // Any buffer may need a device address once bindless is enabled, so every block can
+    // provide one.
+    auto allocate_flags = vk::MemoryAllocateFlags{ };
+    if ( device_.physical_device( ).has_bindless( ) )
+    {
+        allocate_flags = vk::MemoryAllocateFlagBits::eDeviceAddress;
+    }
+
+    if ( auto result = block.memory.initialize( {
+             .allocation_size   = size,
+             .memory_type_index = memory_type_index,
+             .allocate_flags    = allocate_flags,
+         } );
+         !result )
+    {
+        blocks_[ memory_type_index ].pop_back( );
+        return tl::make_unexpected( result.error( ) );
+    }
+
+    // Host visible blocks stay mapped for their entire lifetime. They are mapped before
+    // the block is counted so a failure leaves nothing behind.
+    auto const memory_type_properties = memory_properties_.memoryTypes[ memory_type_index ];
+    if ( memory_type_properties.propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible )
+    {
+        auto mapped = block.memory.map( );
+        if ( !mapped )
+        {
+            blocks_[ memory_type_index ].pop_back( );
+            return tl::make_unexpected( mapped.error( ) );
+        }
+        block.mapped = mapped.value( );
+    }
+
+    block.size      = size;
+    block.dedicated = dedicated;
+    block.free_ranges.emplace( 0U, size );
+
+    auto const heap = this->heap_index( memory_type_index );
+    heap_allocated_[ heap ] += size;
+
+    spdlog::debug(
+        "Allocated {} device memory block of {} bytes (memory type {})",
+        dedicated ? "dedicated" : "pooled",
+        size,
+        memory_type_index
+    );
+
+    if ( auto const usage = this->heap_usage( )[ heap ]; usage.usage > usage.budget )
+    {
+        spdlog::warn(
+            "Device memory heap {} is over budget ({} of {} bytes used)",
+            heap,
+            usage.usage,
+            usage.budget
+        );
+    }
+
+    return &block;
+}
+
+auto DeviceMemoryAllocator::find_or_add_tag( std::string_view const tag ) -> uint32
+{
+    auto const name = tag.empty( ) ? std::string_view{ "untagged" } : tag;
+
+    if ( auto const iter = tag_indices_.find( name ); iter != tag_indices_.end( ) )
+    {
+        return iter->second;
+    }
+
+    auto const tag_index = static_cast< uint32 >( tags_.size( ) );
+    tags_.push_back( { .tag = std::string( name ) } );
+    tag_indices_.emplace( name, tag_index );
+
+    return tag_index;
+}
+
+auto DeviceMemoryAllocator::heap_index( uint32 const memory_type_index ) const -> uint32
+{
+    return memory_properties_.memoryTypes[ memory_type_index ].heapIndex;
+}
+
+} // namespace ltb::vlk
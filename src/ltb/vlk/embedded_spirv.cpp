@@ -0,0 +1,58 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/embedded_spirv.hpp"
+
+// project
+#include "ltb/vlk/ltb_vlk_config.hpp"
+
+// standard
+#include <algorithm>
+#include <array>
+
+#if defined( LTB_VLK_EMBED_SPIRV )
+// generated
+#include "ltb/vlk/embedded_spirv_data.hpp"
+#endif
+
+namespace ltb::vlk
+{
+namespace
+{
+
+#if defined( LTB_VLK_EMBED_SPIRV )
+constexpr auto const& spirv_table = detail::embedded_spirv_table;
+#else
+constexpr auto spirv_table = std::array< EmbeddedSpirv, 0UZ >{ };
+#endif
+
+} // namespace
+
+auto embedded_spirv( ) -> std::span< EmbeddedSpirv const >
+{
+    return spirv_table;
+}
+
+auto find_embedded_spirv( std::string_view const name ) -> std::span< uint32 const >
+{
+    auto const iter = std::ranges::find( spirv_table, name, &EmbeddedSpirv::name );
+    if ( iter == spirv_table.end( ) )
+    {
+        return { };
+    }
+    return iter->code;
+}
+
+auto shader_module_settings(
+    std::string_view const        spirv_name,
+    vk::ShaderStageFlagBits const stage
+) -> ShaderModuleSettings
+{
+    return {
+        .spirv_file = config::shader_dir_path( ) / spirv_name,
+        .spirv_code = find_embedded_spirv( spirv_name ),
+        .stage      = stage,
+    };
+}
+
+} // namespace ltb::vlk
@@ -6,6 +6,7 @@
 // project
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device.hpp"
+#include "ltb/vlk/pipeline_cache.hpp"
 #include "ltb/vlk/pipeline_layout.hpp"
 #include "ltb/vlk/render_pass.hpp"
 #include "ltb/vlk/shader_module.hpp"
@@ -15,16 +16,21 @@
 #include <range/v3/view/transform.hpp>
 #include <spdlog/spdlog.h>
 
+// standard
+#include <utility>
+
 namespace ltb::vlk
 {
 
 GraphicsPipeline::GraphicsPipeline(
     Device&                      device,
+    PipelineCache&               pipeline_cache,
     RenderPass&                  render_pass,
     std::vector< ShaderModule >& shader_modules,
     PipelineLayout&              pipeline_layout
 )
     : device_( device )
+    , pipeline_cache_( pipeline_cache )
     , render_pass_( render_pass )
     , shader_modules_( shader_modules )
     , pipeline_layout_( pipeline_layout )
@@ -37,7 +43,53 @@ auto GraphicsPipeline::initialize( GraphicsPipelineSettings settings ) -> utils:
     {
         return utils::success( );
     }
+    LTB_CHECK( pipeline_, this->create( settings ) );
+    settings_ = std::move( settings );
+
+    return utils::success( );
+}
+
+auto GraphicsPipeline::rebuild( ) -> utils::Result< vk::UniquePipeline >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK( auto pipeline, this->create( settings_ ) );
+
+    std::swap( pipeline_, pipeline );
+
+    return pipeline;
+}
+
+auto GraphicsPipeline::is_initialized( ) const -> bool
+{
+    return nullptr != pipeline_.get( );
+}
+
+auto GraphicsPipeline::get( ) const -> vk::Pipeline const&
+{
+    return pipeline_.get( );
+}
+
+auto GraphicsPipeline::get( ) -> vk::Pipeline&
+{
+    return pipeline_.get( );
+}
+
+auto GraphicsPipeline::reset( ) -> void
+{
+    pipeline_.reset( );
+    settings_ = { };
+}
+
+auto GraphicsPipeline::settings( ) const -> GraphicsPipelineSettings const&
+{
+    return settings_;
+}
+
+auto GraphicsPipeline::create( GraphicsPipelineSettings const& settings ) const
+    -> utils::Result< vk::UniquePipeline >
+{
     LTB_CHECK_VALID( device_.is_initialized( ) );
+    LTB_CHECK_VALID( pipeline_cache_.is_initialized( ) );
     LTB_CHECK_VALID( render_pass_.is_initialized( ) );
     LTB_CHECK_VALID( pipeline_layout_.is_initialized( ) );
     for ( auto& shader_module : shader_modules_ )
@@ -123,40 +175,11 @@ auto GraphicsPipeline::initialize( GraphicsPipelineSettings settings ) -> utils:
 
     VK_CHECK(
         auto pipelines,
-        device_.get( ).createGraphicsPipelinesUnique( nullptr, pipeline_infos )
+        device_.get( ).createGraphicsPipelinesUnique( pipeline_cache_.get( ), pipeline_infos )
     );
     spdlog::debug( "vk::createGraphicsPipelinesUnique()" );
 
-    settings_ = std::move( settings );
-    pipeline_ = std::move( pipelines.front( ) );
-
-    return utils::success( );
-}
-
-auto GraphicsPipeline::is_initialized( ) const -> bool
-{
-    return nullptr != pipeline_.get( );
-}
-
-auto GraphicsPipeline::get( ) const -> vk::Pipeline const&
-{
-    return pipeline_.get( );
-}
-
-auto GraphicsPipeline::get( ) -> vk::Pipeline&
-{
-    return pipeline_.get( );
-}
-
-auto GraphicsPipeline::reset( ) -> void
-{
-    pipeline_.reset( );
-    settings_ = { };
-}
-
-auto GraphicsPipeline::settings( ) const -> GraphicsPipelineSettings const&
-{
-    return settings_;
+    return std::move( pipelines.front( ) );
 }
 
 } // namespace ltb::vlk
@@ -0,0 +1,215 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/object_cache.hpp"
+
+// project
+#include "ltb/utils/hash_utils.hpp"
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+
+namespace ltb::vlk
+{
+namespace
+{
+
+template < typename Flags >
+auto hash_flags( std::size_t const seed, Flags const flags ) -> std::size_t
+{
+    return utils::hash_combine( seed, static_cast< typename Flags::MaskType >( flags ) );
+}
+
+template < typename Handle >
+auto hash_handle( std::size_t const seed, Handle const handle ) -> std::size_t
+{
+    return utils::hash_combine( seed, static_cast< typename Handle::CType >( handle ) );
+}
+
+} // namespace
+
+auto ObjectCacheHash::operator( )( DescriptorSetLayoutSettings const& settings ) const
+    -> std::size_t
+{
+    auto seed = settings.bindings.size( );
+    for ( auto const& binding : settings.bindings )
+    {
+        seed = utils::hash_combine( seed, binding.binding );
+        seed = utils::hash_combine( seed, binding.descriptorType );
+        seed = utils::hash_combine( seed, binding.descriptorCount );
+        seed = hash_flags( seed, binding.stageFlags );
+    }
+    seed = hash_flags( seed, settings.flags );
+    for ( auto const& flags : settings.binding_flags )
+    {
+        seed = hash_flags( seed, flags );
+    }
+    return seed;
+}
+
+auto ObjectCacheHash::operator( )( PipelineLayoutSettings const& settings ) const -> std::size_t
+{
+    // The set layouts come from the cache, so equal layouts have equal handles.
+    auto seed = settings.descriptor_set_layouts.size( );
+    for ( auto const& descriptor_set_layout : settings.descriptor_set_layouts )
+    {
+        seed = hash_handle( seed, descriptor_set_layout );
+    }
+    for ( auto const& range : settings.push_constant_ranges )
+    {
+        seed = hash_flags( seed, range.stageFlags );
+        seed = utils::hash_combine( seed, range.offset );
+        seed = utils::hash_combine( seed, range.size );
+    }
+    return seed;
+}
+
+auto ObjectCacheHash::operator( )( vk::SamplerCreateInfo const& create_info ) const
+    -> std::size_t
+{
+    auto seed = std::size_t{ 0U };
+    seed      = hash_flags( seed, create_info.flags );
+    seed      = utils::hash_combine( seed, create_info.magFilter );
+    seed      = utils::hash_combine( seed, create_info.minFilter );
+    seed      = utils::hash_combine( seed, create_info.mipmapMode );
+    seed      = utils::hash_combine( seed, create_info.addressModeU );
+    seed      = utils::hash_combine( seed, create_info.addressModeV );
+    seed      = utils::hash_combine( seed, create_info.addressModeW );
+    seed      = utils::hash_combine( seed, create_info.mipLodBias );
+    seed      = utils::hash_combine( seed, create_info.anisotropyEnable );
+    seed      = utils::hash_combine( seed, create_info.maxAnisotropy );
+    seed      = utils::hash_combine( seed, create_info.compareEnable );
+    seed      = utils::hash_combine( seed, create_info.compareOp );
+    seed      = utils::hash_combine( seed, create_info.minLod );
+    seed      = utils::hash_combine( seed, create_info.maxLod );
+    seed      = utils::hash_combine( seed, create_info.borderColor );
+    seed      = utils::hash_combine( seed, create_info.unnormalizedCoordinates );
+    return seed;
+}
+
+ObjectCache::ObjectCache( Device& device )
+    : device_( device )
+{
+}
+
+auto ObjectCache::initialize( ) -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( device_.is_initialized( ) );
+
+    initialized_ = true;
+
+    return utils::success( );
+}
+
+auto ObjectCache::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto ObjectCache::descriptor_set_layout( DescriptorSetLayoutSettings const& settings )
+    -> utils::Result< vk::DescriptorSetLayout >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    // Bindings compare their immutable samplers by address, which a later array can reuse.
+    auto const has_immutable_samplers = []( vk::DescriptorSetLayoutBinding const& binding ) {
+        return nullptr != binding.pImmutableSamplers;
+    };
+    LTB_CHECK_VALID( std::ranges::none_of( settings.bindings, has_immutable_samplers ) );
+    LTB_CHECK_VALID(
+        settings.binding_flags.empty( )
+        || ( settings.binding_flags.size( ) == settings.bindings.size( ) )
+    );
+
+    auto const lock = std::scoped_lock{ mutex_ };
+
+    if ( auto const iter = descriptor_set_layouts_.find( settings );
+         iter != descriptor_set_layouts_.end( ) )
+    {
+        return iter->second.get( );
+    }
+
+    auto const binding_flags_info = vk::DescriptorSetLayoutBindingFlagsCreateInfo{ }
+                                        .setBindingFlags( settings.binding_flags );
+
+    auto const create_info
+        = vk::DescriptorSetLayoutCreateInfo{ }
+              .setFlags( settings.flags )
+              .setBindings( settings.bindings )
+              .setPNext( settings.binding_flags.empty( ) ? nullptr : &binding_flags_info );
+
+    VK_CHECK(
+        auto descriptor_set_layout,
+        device_.get( ).createDescriptorSetLayoutUnique( create_info )
+    );
+    spdlog::debug( "vk::createDescriptorSetLayoutUnique()" );
+
+    auto const handle = descriptor_set_layout.get( );
+    descriptor_set_layouts_.emplace( settings, std::move( descriptor_set_layout ) );
+
+    return handle;
+}
+
+auto ObjectCache::pipeline_layout( PipelineLayoutSettings const& settings )
+    -> utils::Result< vk::PipelineLayout >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    auto const lock = std::scoped_lock{ mutex_ };
+
+    if ( auto const iter = pipeline_layouts_.find( settings ); iter != pipeline_layouts_.end( ) )
+    {
+        return iter->second.get( );
+    }
+
+    auto const create_info = vk::PipelineLayoutCreateInfo{ }
+                                 .setSetLayouts( settings.descriptor_set_layouts )
+                                 .setPushConstantRanges( settings.push_constant_ranges );
+
+    VK_CHECK( auto pipeline_layout, device_.get( ).createPipelineLayoutUnique( create_info ) );
+    spdlog::debug( "vk::createPipelineLayout()" );
+
+    auto const handle = pipeline_layout.get( );
+    pipeline_layouts_.emplace( settings, std::move( pipeline_layout ) );
+
+    return handle;
+}
+
+auto ObjectCache::sampler( vk::SamplerCreateInfo const& create_info )
+    -> utils::Result< vk::Sampler >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( nullptr == create_info.pNext );
+
+    auto const lock = std::scoped_lock{ mutex_ };
+
+    if ( auto const iter = samplers_.find( create_info ); iter != samplers_.end( ) )
+    {
+        return iter->second.get( );
+    }
+
+    VK_CHECK( auto sampler, device_.get( ).createSamplerUnique( create_info ) );
+    spdlog::debug( "vk::createSamplerUnique()" );
+
+    auto const handle = sampler.get( );
+    samplers_.emplace( create_info, std::move( sampler ) );
+
+    return handle;
+}
+
+auto ObjectCache::object_count( ) const -> std::size_t
+{
+    auto const lock = std::scoped_lock{ mutex_ };
+    return descriptor_set_layouts_.size( ) + pipeline_layouts_.size( ) + samplers_.size( );
+}
+
+} // namespace ltb::vlk
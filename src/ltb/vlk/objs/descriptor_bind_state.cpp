@@ -0,0 +1,107 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/descriptor_bind_state.hpp"
+
+// project
+#include "ltb/vlk/descriptor_writer.hpp"
+#include "ltb/vlk/objs/frame_info.hpp"
+
+// standard
+#include <algorithm>
+
+namespace ltb::vlk::objs
+{
+
+auto DescriptorBindState::reset( vk::CommandBuffer const command_buffer ) -> void
+{
+    command_buffer_ = command_buffer;
+    graphics_       = { };
+    compute_        = { };
+}
+
+auto DescriptorBindState::update(
+    vk::PipelineBindPoint const          bind_point,
+    vk::PipelineLayout const             pipeline_layout,
+    std::span< vk::DescriptorSet const > descriptor_sets,
+    std::vector< uint32 > const&         dynamic_offsets
+) -> bool
+{
+    auto* const bound = this->bound_at( bind_point );
+    if ( nullptr == bound )
+    {
+        return true;
+    }
+
+    if ( ( bound->pipeline_layout == pipeline_layout )
+         && std::ranges::equal( bound->descriptor_sets, descriptor_sets )
+         && ( bound->dynamic_offsets == dynamic_offsets ) )
+    {
+        return false;
+    }
+
+    bound->pipeline_layout = pipeline_layout;
+    bound->descriptor_sets.assign( descriptor_sets.begin( ), descriptor_sets.end( ) );
+    bound->dynamic_offsets = dynamic_offsets;
+
+    return true;
+}
+
+auto DescriptorBindState::command_buffer( ) const -> vk::CommandBuffer
+{
+    return command_buffer_;
+}
+
+auto DescriptorBindState::bound_at( vk::PipelineBindPoint const bind_point )
+    -> BoundDescriptorSets*
+{
+    switch ( bind_point )
+    {
+        case vk::PipelineBindPoint::eGraphics:
+            return &graphics_;
+        case vk::PipelineBindPoint::eCompute:
+            return &compute_;
+        default:
+            return nullptr;
+    }
+}
+
+auto bind_descriptor_sets(
+    FrameInfo const&                     frame,
+    vk::PipelineBindPoint const          bind_point,
+    vk::PipelineLayout const             pipeline_layout,
+    std::span< vk::DescriptorSet const > descriptor_sets,
+    std::vector< uint32 > const&         dynamic_offsets
+) -> void
+{
+    // Frames copied for secondary command buffers keep the primary's state and writer,
+    // which do not apply to them. Their sets are written before they start recording.
+    auto* const state = frame.descriptor_bind_state;
+    auto const  is_primary
+        = ( nullptr != state ) && ( state->command_buffer( ) == frame.command_buffer );
+
+    // Sets cannot be written once they are bound, so every queued write is applied first.
+    if ( is_primary && ( nullptr != frame.descriptor_writer ) )
+    {
+        frame.descriptor_writer->flush( );
+    }
+
+    if ( is_primary
+         && ( !state->update( bind_point, pipeline_layout, descriptor_sets, dynamic_offsets ) ) )
+    {
+        return;
+    }
+
+    constexpr auto first_set = 0U;
+    frame.command_buffer.bindDescriptorSets(
+        bind_point,
+        pipeline_layout,
+        first_set,
+        static_cast< uint32 >( descriptor_sets.size( ) ),
+        descriptor_sets.data( ),
+        static_cast< uint32 >( dynamic_offsets.size( ) ),
+        dynamic_offsets.data( )
+    );
+}
+
+} // namespace ltb::vlk::objs
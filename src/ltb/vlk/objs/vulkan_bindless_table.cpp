@@ -0,0 +1,213 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_bindless_table.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/objs/frame_info.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+
+namespace ltb::vlk::objs
+{
+
+VulkanBindlessTable::VulkanBindlessTable( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanBindlessTable::initialize( VulkanBindlessTableSettings settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( gpu_.physical_device( ).has_bindless( ) );
+    LTB_CHECK_VALID( settings.max_storage_buffers > 0U );
+    LTB_CHECK_VALID( settings.max_storage_images > 0U );
+
+    // Slots are written while the table is bound, including by command buffers that are
+    // still executing, and most of them are never written.
+    constexpr auto binding_flags = vk::DescriptorBindingFlags{
+        vk::DescriptorBindingFlagBits::eUpdateAfterBind
+        | vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending
+        | vk::DescriptorBindingFlagBits::ePartiallyBound
+    };
+
+    // Not shared through the object cache since no other set has this layout.
+    LTB_CHECK( layout_.initialize( {
+        .bindings = {
+            vk::DescriptorSetLayoutBinding{ }
+                .setBinding( bindless_storage_buffer_binding )
+                .setDescriptorType( vk::DescriptorType::eStorageBuffer )
+                .setDescriptorCount( settings.max_storage_buffers )
+                .setStageFlags( settings.stages ),
+            vk::DescriptorSetLayoutBinding{ }
+                .setBinding( bindless_storage_image_binding )
+                .setDescriptorType( vk::DescriptorType::eStorageImage )
+                .setDescriptorCount( settings.max_storage_images )
+                .setStageFlags( settings.stages ),
+        },
+        .flags         = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+        .binding_flags = { binding_flags, binding_flags },
+    } ) );
+
+    LTB_CHECK( pool_.initialize( {
+        .pool_sizes = {
+            { vk::DescriptorType::eStorageBuffer, settings.max_storage_buffers },
+            { vk::DescriptorType::eStorageImage, settings.max_storage_images },
+        },
+        .max_sets = 1U,
+        .flags    = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+    } ) );
+
+    auto const allocate_info = vk::DescriptorSetAllocateInfo{ }
+                                   .setDescriptorPool( pool_.get( ) )
+                                   .setSetLayouts( layout_.get( ) );
+
+    VK_CHECK( auto descriptor_sets, gpu_.device( ).get( ).allocateDescriptorSets( allocate_info ) );
+    spdlog::debug(
+        "Bindless table with {} storage buffers and {} storage images",
+        settings.max_storage_buffers,
+        settings.max_storage_images
+    );
+
+    descriptor_set_ = descriptor_sets.front( );
+    settings_       = settings;
+    initialized_    = true;
+
+    return utils::success( );
+}
+
+auto VulkanBindlessTable::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto VulkanBindlessTable::add_storage_buffer( vk::DescriptorBufferInfo const& info )
+    -> utils::Result< BindlessHandle >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK(
+        auto const handle,
+        this->acquire( storage_buffers_, settings_.max_storage_buffers )
+    );
+
+    auto const write = vk::WriteDescriptorSet{ }
+                           .setDstSet( descriptor_set_ )
+                           .setDstBinding( bindless_storage_buffer_binding )
+                           .setDstArrayElement( handle )
+                           .setDescriptorType( vk::DescriptorType::eStorageBuffer )
+                           .setBufferInfo( info );
+    gpu_.device( ).get( ).updateDescriptorSets( write, { } );
+
+    return handle;
+}
+
+auto VulkanBindlessTable::add_storage_image( vk::DescriptorImageInfo const& info )
+    -> utils::Result< BindlessHandle >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK( auto const handle, this->acquire( storage_images_, settings_.max_storage_images ) );
+
+    auto const write = vk::WriteDescriptorSet{ }
+                           .setDstSet( descriptor_set_ )
+                           .setDstBinding( bindless_storage_image_binding )
+                           .setDstArrayElement( handle )
+                           .setDescriptorType( vk::DescriptorType::eStorageImage )
+                           .setImageInfo( info );
+    gpu_.device( ).get( ).updateDescriptorSets( write, { } );
+
+    return handle;
+}
+
+auto VulkanBindlessTable::remove_storage_buffer( BindlessHandle const handle )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    return this->release( storage_buffers_, handle );
+}
+
+auto VulkanBindlessTable::remove_storage_image( BindlessHandle const handle )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    return this->release( storage_images_, handle );
+}
+
+auto VulkanBindlessTable::bind(
+    FrameInfo const&            frame,
+    vk::PipelineBindPoint const bind_point,
+    vk::PipelineLayout const    pipeline_layout,
+    uint32 const                set
+) const -> void
+{
+    constexpr auto set_count = 1U;
+    frame.command_buffer.bindDescriptorSets(
+        bind_point,
+        pipeline_layout,
+        set,
+        set_count,
+        &descriptor_set_,
+        0U,
+        nullptr
+    );
+}
+
+auto VulkanBindlessTable::layout( ) const -> vk::DescriptorSetLayout
+{
+    return layout_.get( );
+}
+
+auto VulkanBindlessTable::bindings( ) const -> std::vector< vk::DescriptorSetLayoutBinding > const&
+{
+    return layout_.settings( ).bindings;
+}
+
+auto VulkanBindlessTable::descriptor_set( ) const -> vk::DescriptorSet
+{
+    return descriptor_set_;
+}
+
+auto VulkanBindlessTable::settings( ) const -> VulkanBindlessTableSettings const&
+{
+    return settings_;
+}
+
+auto VulkanBindlessTable::acquire( Slots& slots, uint32 const capacity )
+    -> utils::Result< BindlessHandle >
+{
+    if ( !slots.free.empty( ) )
+    {
+        auto const handle = slots.free.back( );
+        slots.free.pop_back( );
+        return handle;
+    }
+
+    if ( slots.next >= capacity )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "All {} bindless slots are in use", capacity );
+    }
+    return slots.next++;
+}
+
+auto VulkanBindlessTable::release( Slots& slots, BindlessHandle const handle )
+    -> utils::Result< void >
+{
+    // Releasing a handle that was never handed out, or twice, would give its slot to two
+    // resources.
+    LTB_CHECK_VALID( handle < slots.next );
+    LTB_CHECK_VALID( std::ranges::find( slots.free, handle ) == slots.free.end( ) );
+
+    slots.free.push_back( handle );
+    return utils::success( );
+}
+
+} // namespace ltb::vlk::objs
@@ -5,7 +5,6 @@
 
 // project
 #include "ltb/vlk/check.hpp"
-#include "ltb/vlk/device_memory_utils.hpp"
 
 namespace ltb::vlk::objs
 {
@@ -15,6 +14,11 @@ VulkanBuffer::VulkanBuffer( VulkanGpu& gpu )
 {
 }
 
+VulkanBuffer::~VulkanBuffer( )
+{
+    this->reset( );
+}
+
 auto VulkanBuffer::initialize( VulkanBufferSettings settings ) -> utils::Result< void >
 {
     if ( this->is_initialized( ) )
@@ -31,23 +35,27 @@ auto VulkanBuffer::initialize( VulkanBufferSettings settings ) -> utils::Result<
     } ) );
 
     LTB_CHECK(
-        auto const memory_range,
-        initialize_memory_chunk(
-            memory_,
-            gpu_.physical_device( ),
+        allocation_,
+        gpu_.memory_allocator( ).allocate(
             buffer_.memory_requirements( ),
-            settings.memory_properties
+            settings.memory_properties,
+            AllocationTiling::Linear,
+            settings.tag
         )
     );
-    LTB_CHECK_VALID( settings.layout.total_size <= memory_range.size );
+    LTB_CHECK_VALID( settings.layout.total_size <= allocation_.range.size );
 
-    VK_CHECK( gpu_.device( )
-                  .get( )
-                  .bindBufferMemory( buffer_.get( ), memory_.get( ), memory_range.offset ) );
+    VK_CHECK( gpu_.device( ).get( ).bindBufferMemory(
+        buffer_.get( ),
+        allocation_.memory,
+        allocation_.range.offset
+    ) );
 
     if ( settings.store_mapped_value )
     {
-        LTB_CHECK( mapped_data_, memory_.map( memory_range, { } ) );
+        // Host visible memory is persistently mapped by the allocator.
+        LTB_CHECK_VALID( nullptr != allocation_.mapped_data );
+        mapped_data_ = allocation_.mapped_data;
     }
 
     layout_ = std::move( settings.layout );
@@ -64,8 +72,10 @@ auto VulkanBuffer::is_initialized( ) const -> bool
 
 auto VulkanBuffer::reset( ) -> void
 {
-    memory_.reset( );
     buffer_.reset( );
+    gpu_.memory_allocator( ).free( allocation_ );
+    allocation_  = { };
+    mapped_data_ = nullptr;
     layout_      = { };
     initialized_ = false;
 }
@@ -90,14 +100,9 @@ auto VulkanBuffer::buffer( ) -> Buffer&
     return buffer_;
 }
 
-auto VulkanBuffer::memory( ) const -> DeviceMemory const&
-{
-    return memory_;
-}
-
-auto VulkanBuffer::memory( ) -> DeviceMemory&
+auto VulkanBuffer::allocation( ) const -> DeviceAllocation const&
 {
-    return memory_;
+    return allocation_;
 }
 
 auto VulkanBuffer::mapped_data( ) const -> uint8*
@@ -5,7 +5,6 @@
 
 // project
 #include "ltb/vlk/check.hpp"
-#include "ltb/vlk/device_memory_utils.hpp"
 #include "ltb/vlk/vector_utils.hpp"
 
 namespace ltb::vlk::objs
@@ -16,6 +15,11 @@ VulkanBuffers::VulkanBuffers( VulkanGpu& gpu )
 {
 }
 
+VulkanBuffers::~VulkanBuffers( )
+{
+    this->reset( );
+}
+
 auto VulkanBuffers::initialize( VulkanBuffersSettings const& settings ) -> utils::Result< void >
 {
     if ( this->is_initialized( ) )
@@ -32,26 +36,41 @@ auto VulkanBuffers::initialize( VulkanBuffersSettings const& settings ) -> utils
 
     auto const memory_requirements = get_member_functions( buffers_, &Buffer::memory_requirements );
 
+    layout_ = compute_memory_layout( memory_requirements );
+    LTB_CHECK_VALID( layout_.ranges.size( ) == buffers_.size( ) );
+
+    // All the buffers share a single sub-allocation so it
+    // has to satisfy every one of their requirements.
+    auto combined_requirements = vk::MemoryRequirements{ }
+                                     .setSize( layout_.total_size )
+                                     .setAlignment( 1U )
+                                     .setMemoryTypeBits( ~0U );
+    for ( auto const& requirements : memory_requirements )
+    {
+        combined_requirements.alignment
+            = std::max( combined_requirements.alignment, requirements.alignment );
+        combined_requirements.memoryTypeBits &= requirements.memoryTypeBits;
+    }
+
     LTB_CHECK(
-        layout_,
-        initialize_memory_chunk(
-            memory_,
-            gpu_.physical_device( ),
-            memory_requirements,
-            settings.memory_properties
+        allocation_,
+        gpu_.memory_allocator( ).allocate(
+            combined_requirements,
+            settings.memory_properties,
+            AllocationTiling::Linear,
+            settings.tag
         )
     );
-    LTB_CHECK_VALID( layout_.ranges.size( ) == buffers_.size( ) );
 
     auto const& device = gpu_.device( ).get( );
 
     auto const buffer_count = buffers_.size( );
     for ( auto i = 0U; i < buffer_count; ++i )
     {
-        auto const& buffer       = buffers_[ i ];
-        auto const& memory_range = layout_.ranges[ i ];
+        auto const& buffer        = buffers_[ i ];
+        auto const  memory_offset = allocation_.range.offset + layout_.ranges[ i ].offset;
 
-        VK_CHECK( device.bindBufferMemory( buffer.get( ), memory_.get( ), memory_range.offset ) );
+        VK_CHECK( device.bindBufferMemory( buffer.get( ), allocation_.memory, memory_offset ) );
     }
 
     initialized_ = true;
@@ -66,9 +85,10 @@ auto VulkanBuffers::is_initialized( ) const -> bool
 
 auto VulkanBuffers::reset( ) -> void
 {
-    memory_.reset( );
-    layout_ = { };
     buffers_.clear( );
+    gpu_.memory_allocator( ).free( allocation_ );
+    allocation_  = { };
+    layout_      = { };
     initialized_ = false;
 }
 
@@ -87,14 +107,9 @@ auto VulkanBuffers::buffers( ) const -> std::vector< Buffer > const&
     return buffers_;
 }
 
-auto VulkanBuffers::memory( ) const -> DeviceMemory const&
-{
-    return memory_;
-}
-
-auto VulkanBuffers::memory( ) -> DeviceMemory&
+auto VulkanBuffers::allocation( ) const -> DeviceAllocation const&
 {
-    return memory_;
+    return allocation_;
 }
 
 } // namespace ltb::vlk::objs
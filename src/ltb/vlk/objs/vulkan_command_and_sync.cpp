@@ -4,6 +4,7 @@
 #include "ltb/vlk/objs/vulkan_command_and_sync.hpp"
 
 // project
+#include "ltb/utils/cpu_profiler.hpp"
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device.hpp"
 #include "ltb/vlk/physical_device.hpp"
@@ -14,24 +15,39 @@
 #include <range/v3/view/transform.hpp>
 #include <spdlog/spdlog.h>
 
+// standard
+#include <algorithm>
+
 namespace ltb::vlk::objs
 {
 namespace
 {
 
-struct GetSemaphore
+// Every legacy stage bit has the same value in `vk::PipelineStageFlags2`.
+auto to_stage_flags_2( vk::PipelineStageFlags const stages ) -> vk::PipelineStageFlags2
 {
-    auto operator( )( SemaphoreAndStage const& sem_and_stage ) const -> vk::Semaphore
+    return vk::PipelineStageFlags2{ static_cast< VkPipelineStageFlags >( stages ) };
+}
+
+struct ToWaitInfo
+{
+    auto operator( )( SemaphoreAndStage const& sem_and_stage ) const -> vk::SemaphoreSubmitInfo
     {
-        return sem_and_stage.semaphore;
+        // The value is ignored for binary semaphores.
+        return vk::SemaphoreSubmitInfo{ }
+            .setSemaphore( sem_and_stage.semaphore )
+            .setValue( sem_and_stage.value )
+            .setStageMask( to_stage_flags_2( sem_and_stage.stage ) );
     }
 };
 
-struct GetStage
+struct ToSignalInfo
 {
-    auto operator( )( SemaphoreAndStage const& sem_and_stage ) const -> vk::PipelineStageFlags
+    auto operator( )( vk::Semaphore const& semaphore ) const -> vk::SemaphoreSubmitInfo
     {
-        return sem_and_stage.stage;
+        return vk::SemaphoreSubmitInfo{ }
+            .setSemaphore( semaphore )
+            .setStageMask( vk::PipelineStageFlagBits2::eAllCommands );
     }
 };
 
@@ -54,18 +70,49 @@ auto VulkanCommandAndSync::initialize( VulkanCommandAndSyncSettings const settin
 
     LTB_CHECK( command_pool_.initialize( settings.command_pool ) );
 
+    auto const use_fences = ( FrameSync::Fences == settings.frame_sync );
+
     for ( auto frame_index = 0U; frame_index < settings.frame_count; ++frame_index )
     {
         LTB_CHECK( command_buffers_.emplace_back( gpu_.device( ), command_pool_ ).initialize( ) );
-        LTB_CHECK( frame_fences_.emplace_back( gpu_.device( ) ).initialize( ) );
+        if ( use_fences )
+        {
+            LTB_CHECK( frame_fences_.emplace_back( gpu_.device( ) ).initialize( ) );
+        }
         LTB_CHECK( frame_semaphores_.emplace_back( gpu_.device( ) ).initialize( ) );
+        LTB_CHECK( frame_descriptors_.emplace_back( gpu_.device( ) )
+                       .initialize( settings.frame_descriptors ) );
+        descriptor_writers_.emplace_back( gpu_.device( ) );
     }
 
+    if ( !use_fences )
+    {
+        LTB_CHECK( timeline_.initialize( {
+            .type          = vk::SemaphoreType::eTimeline,
+            .initial_value = 0U,
+        } ) );
+        frame_values_.assign( settings.frame_count, 0U );
+    }
+    frame_sync_       = settings.frame_sync;
+    frames_in_flight_ = settings.frame_count;
+
+    descriptor_bind_states_.resize( settings.frame_count );
+
     for ( auto image_index = 0UL; image_index < settings.image_count; ++image_index )
     {
         LTB_CHECK( image_semaphores_.emplace_back( gpu_.device( ) ).initialize( ) );
     }
 
+    if ( settings.profiler_scopes_per_frame > 0U )
+    {
+        LTB_CHECK( profiler_.initialize( {
+            .frame_count          = settings.frame_count,
+            .max_scopes_per_frame = settings.profiler_scopes_per_frame,
+            .queue_type           = settings.command_pool.queue_type,
+            .pipeline_statistics  = settings.profiler_statistics,
+        } ) );
+    }
+
     initialized_ = true;
 
     return utils::success( );
@@ -87,6 +134,8 @@ auto VulkanCommandAndSync::start_frame(
     ResetCommandBuffer const reset_command_buffer
 ) -> utils::Result< std::optional< FrameInfo > >
 {
+    LTB_PROFILE_ZONE( "start_frame" );
+
     constexpr auto max_possible_timeout = std::numeric_limits< uint32 >::max( );
 
     auto const  frame_objects             = this->get_frame_objects( );
@@ -94,9 +143,7 @@ auto VulkanCommandAndSync::start_frame(
     auto const& in_flight_fence           = frame_objects.frame_fence;
     auto const& image_available_semaphore = frame_objects.frame_semaphore;
 
-    auto const     fences       = std::array{ in_flight_fence };
-    constexpr auto wait_for_all = true;
-    VK_CHECK( gpu_.device( ).get( ).waitForFences( fences, wait_for_all, max_possible_timeout ) );
+    LTB_CHECK( this->wait_for_frame( ) );
 
     auto const image_index_result = gpu_.device( ).get( ).acquireNextImageKHR(
         swapchain.get( ),
@@ -110,20 +157,20 @@ auto VulkanCommandAndSync::start_frame(
     }
     VK_CHECK( auto const image_index, image_index_result );
 
-    VK_CHECK( gpu_.device( ).get( ).resetFences( fences ) );
-
-    if ( ResetCommandBuffer::Yes == reset_command_buffer )
-    {
-        constexpr auto reset_flags = vk::CommandBufferResetFlags{ };
-        VK_CHECK( command_buffer.reset( reset_flags ) );
-    }
+    LTB_CHECK( this->begin_frame( reset_command_buffer ) );
 
     return FrameInfo{
-        .command_buffer  = command_buffer,
-        .frame_fence     = in_flight_fence,
-        .frame_index     = frame_index_,
-        .image_semaphore = image_available_semaphore,
-        .image_index     = image_index,
+        .command_buffer        = command_buffer,
+        .frame_fence           = in_flight_fence,
+        .frame_index           = frame_index_,
+        .image_semaphore       = image_available_semaphore,
+        .image_index           = image_index,
+        .timeline_semaphore    = this->timeline_semaphore( ),
+        .timeline_value        = this->next_timeline_value( ),
+        .profiler              = this->frame_profiler( ),
+        .descriptor_bind_state = &descriptor_bind_states_.at( frame_index_ ),
+        .descriptor_allocator  = &frame_descriptors_.at( frame_index_ ),
+        .descriptor_writer     = &descriptor_writers_.at( frame_index_ ),
     };
 }
 
@@ -135,42 +182,43 @@ auto VulkanCommandAndSync::start_frame( ) -> utils::Result< std::optional< Frame
 auto VulkanCommandAndSync::start_frame( ResetCommandBuffer const reset_command_buffer )
     -> utils::Result< std::optional< FrameInfo > >
 {
-    constexpr auto max_possible_timeout = std::numeric_limits< uint32 >::max( );
+    LTB_PROFILE_ZONE( "start_frame" );
 
     auto const  frame_objects   = this->get_frame_objects( );
     auto const& command_buffer  = frame_objects.command_buffer;
     auto const& in_flight_fence = frame_objects.frame_fence;
 
-    auto const     fences       = std::array{ in_flight_fence };
-    constexpr auto wait_for_all = true;
-    VK_CHECK( gpu_.device( ).get( ).waitForFences( fences, wait_for_all, max_possible_timeout ) );
-
-    VK_CHECK( gpu_.device( ).get( ).resetFences( fences ) );
-
-    if ( ResetCommandBuffer::Yes == reset_command_buffer )
-    {
-        constexpr auto reset_flags = vk::CommandBufferResetFlags{ };
-        VK_CHECK( command_buffer.reset( reset_flags ) );
-    }
+    LTB_CHECK( this->wait_for_frame( ) );
+    LTB_CHECK( this->begin_frame( reset_command_buffer ) );
 
     return FrameInfo{
-        .command_buffer  = command_buffer,
-        .frame_fence     = in_flight_fence,
-        .frame_index     = frame_index_,
-        .image_semaphore = nullptr,
-        .image_index     = std::numeric_limits< uint32 >::max( ),
+        .command_buffer        = command_buffer,
+        .frame_fence           = in_flight_fence,
+        .frame_index           = frame_index_,
+        .image_semaphore       = nullptr,
+        .image_index           = std::numeric_limits< uint32 >::max( ),
+        .timeline_semaphore    = this->timeline_semaphore( ),
+        .timeline_value        = this->next_timeline_value( ),
+        .profiler              = this->frame_profiler( ),
+        .descriptor_bind_state = &descriptor_bind_states_.at( frame_index_ ),
+        .descriptor_allocator  = &frame_descriptors_.at( frame_index_ ),
+        .descriptor_writer     = &descriptor_writers_.at( frame_index_ ),
     };
 }
 
 auto VulkanCommandAndSync::get_frame_objects( ) -> FrameObjects
 {
     assert( frame_index_ < command_buffers_.size( ) );
-    assert( frame_index_ < frame_fences_.size( ) );
+    assert( frame_fences_.empty( ) || ( frame_index_ < frame_fences_.size( ) ) );
     assert( frame_index_ < frame_semaphores_.size( ) );
 
+    // There are no fences in timeline mode.
+    auto const frame_fence
+        = frame_fences_.empty( ) ? vk::Fence{ } : frame_fences_.at( frame_index_ ).get( );
+
     return {
         .command_buffer  = command_buffers_.at( frame_index_ ).get( ),
-        .frame_fence     = frame_fences_.at( frame_index_ ).get( ),
+        .frame_fence     = frame_fence,
         .frame_semaphore = frame_semaphores_.at( frame_index_ ).get( ),
     };
 }
@@ -179,12 +227,15 @@ auto VulkanCommandAndSync::get_frame_objects( uint32 const frame_index )
     -> utils::Result< FrameObjects >
 {
     LTB_CHECK_VALID( frame_index < command_buffers_.size( ) );
-    LTB_CHECK_VALID( frame_index < frame_fences_.size( ) );
+    LTB_CHECK_VALID( frame_fences_.empty( ) || ( frame_index < frame_fences_.size( ) ) );
     LTB_CHECK_VALID( frame_index < frame_semaphores_.size( ) );
 
+    auto const frame_fence
+        = frame_fences_.empty( ) ? vk::Fence{ } : frame_fences_[ frame_index ].get( );
+
     return FrameObjects{
         .command_buffer  = command_buffers_[ frame_index ].get( ),
-        .frame_fence     = frame_fences_[ frame_index ].get( ),
+        .frame_fence     = frame_fence,
         .frame_semaphore = frame_semaphores_[ frame_index ].get( ),
     };
 }
@@ -199,6 +250,15 @@ auto VulkanCommandAndSync::get_present_semaphore( FrameInfo const& frame )
 
 auto VulkanCommandAndSync::end_frame( FrameInfo const& frame, vk::Queue const& submit_queue )
     -> utils::Result< void >
+{
+    return this->end_frame( frame, { }, submit_queue );
+}
+
+auto VulkanCommandAndSync::end_frame(
+    FrameInfo const&                        frame,
+    std::vector< SemaphoreAndStage > const& additional_waits,
+    vk::Queue const&                        submit_queue
+) -> utils::Result< void >
 {
     LTB_CHECK( auto const render_finished_semaphore, this->get_present_semaphore( frame ) );
 
@@ -208,6 +268,11 @@ auto VulkanCommandAndSync::end_frame( FrameInfo const& frame, vk::Queue const& s
             .stage     = vk::PipelineStageFlagBits::eColorAttachmentOutput,
         },
     };
+    wait_until_signaled.insert(
+        wait_until_signaled.end( ),
+        additional_waits.begin( ),
+        additional_waits.end( )
+    );
 
     auto signal_when_finished = std::vector{ render_finished_semaphore };
 
@@ -226,18 +291,39 @@ auto VulkanCommandAndSync::end_frame(
     vk::Queue const&                        submit_queue
 ) -> utils::Result< void >
 {
-    auto const wait_semaphores = wait_until_signaled | ranges::views::transform( GetSemaphore{ } )
-                               | ranges::to< std::vector >( );
-    auto const wait_stages = wait_until_signaled | ranges::views::transform( GetStage{ } )
-                           | ranges::to< std::vector >( );
+    LTB_PROFILE_ZONE( "end_frame" );
 
-    auto const submit_info = vk::SubmitInfo{ }
-                                 .setWaitSemaphores( wait_semaphores )
-                                 .setWaitDstStageMask( wait_stages )
-                                 .setSignalSemaphores( signal_when_finished )
-                                 .setCommandBuffers( frame.command_buffer );
+    LTB_CHECK(
+        auto const submit,
+        this->make_submit( frame, wait_until_signaled, signal_when_finished )
+    );
+
+    auto const submit_info = vk::SubmitInfo2{ }
+                                 .setWaitSemaphoreInfos( submit.waits )
+                                 .setCommandBufferInfos( submit.command_buffers )
+                                 .setSignalSemaphoreInfos( submit.signals );
+
+    VK_CHECK( submit_queue.submit2( submit_info, frame.frame_fence ) );
 
-    VK_CHECK( submit_queue.submit( submit_info, frame.frame_fence ) );
+    this->record_submitted( frame );
+
+    return utils::success( );
+}
+
+auto VulkanCommandAndSync::end_frame(
+    FrameInfo const&                        frame,
+    std::vector< SemaphoreAndStage > const& wait_until_signaled,
+    std::vector< vk::Semaphore > const&     signal_when_finished,
+    VulkanSubmitBatch&                      batch
+) -> utils::Result< void >
+{
+    LTB_PROFILE_ZONE( "end_frame" );
+
+    LTB_CHECK( auto submit, this->make_submit( frame, wait_until_signaled, signal_when_finished ) );
+    LTB_CHECK( batch.add( std::move( submit ), frame.frame_fence ) );
+
+    this->record_submitted( frame );
+    batch_ = &batch;
 
     return utils::success( );
 }
@@ -275,6 +361,65 @@ auto VulkanCommandAndSync::increment_frame( ) -> void
     frame_index_ = compute_next_frame( frame_index_ );
 }
 
+auto VulkanCommandAndSync::set_frames_in_flight( uint32 const frames_in_flight ) -> void
+{
+    auto const frame_count = static_cast< uint32 >( command_buffers_.size( ) );
+    frames_in_flight_      = std::clamp( frames_in_flight, 1U, frame_count );
+}
+
+auto VulkanCommandAndSync::frames_in_flight( ) const -> uint32
+{
+    return frames_in_flight_;
+}
+
+auto VulkanCommandAndSync::frame_sync( ) const -> FrameSync
+{
+    return frame_sync_;
+}
+
+auto VulkanCommandAndSync::timeline_semaphore( ) const -> vk::Semaphore
+{
+    return timeline_.get( );
+}
+
+auto VulkanCommandAndSync::last_submitted_value( ) const -> uint64
+{
+    return last_submitted_value_;
+}
+
+auto VulkanCommandAndSync::completed_value( ) const -> utils::Result< uint64 >
+{
+    LTB_CHECK_VALID( FrameSync::TimelineSemaphore == frame_sync_ );
+
+    VK_CHECK(
+        auto const value,
+        gpu_.device( ).get( ).getSemaphoreCounterValue( timeline_.get( ) )
+    );
+
+    return value;
+}
+
+auto VulkanCommandAndSync::wait_for_value( uint64 const value ) const -> utils::Result< void >
+{
+    LTB_CHECK_VALID( FrameSync::TimelineSemaphore == frame_sync_ );
+
+    if ( ( nullptr != batch_ ) && batch_->is_pending( timeline_.get( ), value ) )
+    {
+        LTB_CHECK( batch_->flush( ) );
+    }
+
+    constexpr auto max_possible_timeout = std::numeric_limits< uint64 >::max( );
+
+    auto const semaphores = std::array{ timeline_.get( ) };
+    auto const values     = std::array{ value };
+    auto const wait_info
+        = vk::SemaphoreWaitInfo{ }.setSemaphores( semaphores ).setValues( values );
+
+    VK_CHECK( gpu_.device( ).get( ).waitSemaphores( wait_info, max_possible_timeout ) );
+
+    return utils::success( );
+}
+
 auto VulkanCommandAndSync::frame_index( ) const -> uint32
 {
     return frame_index_;
@@ -297,6 +442,16 @@ auto VulkanCommandAndSync::compute_next_frame( uint32 const index ) const -> uin
     return ( index + 1U ) % frame_count;
 }
 
+auto VulkanCommandAndSync::profiler( ) const -> VulkanGpuProfiler const&
+{
+    return profiler_;
+}
+
+auto VulkanCommandAndSync::profiler( ) -> VulkanGpuProfiler&
+{
+    return profiler_;
+}
+
 auto VulkanCommandAndSync::command_pool( ) const -> CommandPool const&
 {
     return command_pool_;
@@ -347,4 +502,124 @@ auto VulkanCommandAndSync::image_semaphores( ) -> std::vector< Semaphore >&
     return image_semaphores_;
 }
 
+auto VulkanCommandAndSync::wait_for_frame( ) -> utils::Result< void >
+{
+    // The oldest frame allowed to still be in flight. Unless fewer frames in flight were
+    // requested, it is the frame that last used the current frame's resources.
+    auto const frame_count = static_cast< uint32 >( command_buffers_.size( ) );
+    auto const limiting_frame
+        = ( ( frame_index_ + frame_count ) - frames_in_flight_ ) % frame_count;
+
+    if ( FrameSync::TimelineSemaphore == frame_sync_ )
+    {
+        // Each frame's last submission signaled these values. Nothing to reset.
+        return this->wait_for_value(
+            std::max( frame_values_[ frame_index_ ], frame_values_[ limiting_frame ] )
+        );
+    }
+
+    constexpr auto max_possible_timeout = std::numeric_limits< uint32 >::max( );
+    constexpr auto wait_for_all         = true;
+
+    auto fences = std::vector{ this->get_frame_objects( ).frame_fence };
+    if ( limiting_frame != frame_index_ )
+    {
+        fences.push_back( frame_fences_[ limiting_frame ].get( ) );
+    }
+
+    if ( ( nullptr != batch_ )
+         && std::ranges::any_of( fences, [ this ]( vk::Fence const& fence ) {
+                return batch_->is_pending( fence );
+            } ) )
+    {
+        LTB_CHECK( batch_->flush( ) );
+    }
+    VK_CHECK( gpu_.device( ).get( ).waitForFences( fences, wait_for_all, max_possible_timeout ) );
+
+    return utils::success( );
+}
+
+auto VulkanCommandAndSync::begin_frame( ResetCommandBuffer const reset_command_buffer )
+    -> utils::Result< void >
+{
+    auto const frame_objects = this->get_frame_objects( );
+
+    if ( FrameSync::Fences == frame_sync_ )
+    {
+        auto const fences = std::array{ frame_objects.frame_fence };
+        VK_CHECK( gpu_.device( ).get( ).resetFences( fences ) );
+    }
+
+    if ( ResetCommandBuffer::Yes == reset_command_buffer )
+    {
+        constexpr auto reset_flags = vk::CommandBufferResetFlags{ };
+        VK_CHECK( frame_objects.command_buffer.reset( reset_flags ) );
+    }
+
+    // Nothing is bound until the frame's commands are recorded again.
+    descriptor_bind_states_.at( frame_index_ ).reset( frame_objects.command_buffer );
+
+    // The frame's previous commands are done so its descriptor sets can be reused.
+    frame_descriptors_.at( frame_index_ ).reset( );
+
+    // Writes queued after the frame's last bind are still meant for its sets.
+    descriptor_writers_.at( frame_index_ ).flush( );
+
+    if ( profiler_.is_initialized( ) )
+    {
+        // The frame's previous commands are done so its timestamps are ready.
+        LTB_CHECK( profiler_.start_frame( frame_index_ ) );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanCommandAndSync::next_timeline_value( ) const -> uint64
+{
+    return ( FrameSync::TimelineSemaphore == frame_sync_ ) ? ( last_submitted_value_ + 1U ) : 0U;
+}
+
+auto VulkanCommandAndSync::frame_profiler( ) -> VulkanGpuProfiler*
+{
+    return profiler_.is_initialized( ) ? &profiler_ : nullptr;
+}
+
+auto VulkanCommandAndSync::make_submit(
+    FrameInfo const&                        frame,
+    std::vector< SemaphoreAndStage > const& wait_until_signaled,
+    std::vector< vk::Semaphore > const&     signal_when_finished
+) const -> utils::Result< PendingSubmit >
+{
+    auto submit  = PendingSubmit{ };
+    submit.waits = wait_until_signaled | ranges::views::transform( ToWaitInfo{ } )
+                 | ranges::to< std::vector >( );
+    submit.command_buffers.push_back(
+        vk::CommandBufferSubmitInfo{ }.setCommandBuffer( frame.command_buffer )
+    );
+    submit.signals = signal_when_finished | ranges::views::transform( ToSignalInfo{ } )
+                   | ranges::to< std::vector >( );
+
+    if ( FrameSync::TimelineSemaphore == frame_sync_ )
+    {
+        LTB_CHECK_VALID( frame.frame_index < frame_values_.size( ) );
+        LTB_CHECK_VALID( frame.timeline_value > last_submitted_value_ );
+
+        submit.signals.push_back( vk::SemaphoreSubmitInfo{ }
+                                      .setSemaphore( timeline_.get( ) )
+                                      .setValue( frame.timeline_value )
+                                      .setStageMask( vk::PipelineStageFlagBits2::eAllCommands ) );
+    }
+
+    return submit;
+}
+
+auto VulkanCommandAndSync::record_submitted( FrameInfo const& frame ) -> void
+{
+    if ( FrameSync::TimelineSemaphore == frame_sync_ )
+    {
+        frame_values_[ frame.frame_index ] = frame.timeline_value;
+        last_submitted_value_              = frame.timeline_value;
+    }
+}
+
 } // namespace ltb::vlk::objs
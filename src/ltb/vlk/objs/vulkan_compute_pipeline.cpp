@@ -4,14 +4,30 @@
 #include "ltb/vlk/objs/vulkan_compute_pipeline.hpp"
 
 // project
+#include "ltb/utils/ignore.hpp"
 #include "ltb/vlk/check.hpp"
+#include "ltb/vlk/objs/descriptor_bind_state.hpp"
 #include "ltb/vlk/objs/frame_info.hpp"
 
 // external
 #include <spdlog/spdlog.h>
 
+// standard
+#include <algorithm>
+
 namespace ltb::vlk::objs
 {
+namespace
+{
+
+auto is_workgroup_size_constant( SpecializationConstant const& constant ) -> bool
+{
+    return ( constant.constant_id == workgroup_size_constant_ids.x )
+        || ( constant.constant_id == workgroup_size_constant_ids.y )
+        || ( constant.constant_id == workgroup_size_constant_ids.z );
+}
+
+} // namespace
 
 VulkanComputePipeline::VulkanComputePipeline( VulkanGpu& gpu )
     : gpu_( gpu )
@@ -25,26 +41,52 @@ auto VulkanComputePipeline::initialize( VulkanComputePipelineSettings settings )
     {
         return utils::success( );
     }
+    LTB_CHECK( this->initialize_layouts( std::move( settings ) ) );
+    return this->compile( );
+}
+
+auto VulkanComputePipeline::initialize_layouts( VulkanComputePipelineSettings settings )
+    -> utils::Result< void >
+{
     LTB_CHECK_VALID( gpu_.is_initialized( ) );
     LTB_CHECK_VALID( settings.descriptor_set_count > 0U );
+    LTB_CHECK_VALID( !pipeline_layout_.is_initialized( ) );
 
     LTB_CHECK( shader_module_.initialize( std::move( settings.shader_module ) ) );
+    LTB_CHECK( this->specialize(
+        shader_module_.settings( ).specialization_constants,
+        settings.workgroup_size
+    ) );
+    LTB_CHECK( this->reflect_layout( settings ) );
 
-    LTB_CHECK( descriptor_set_layout_.initialize( {
-        .bindings = std::move( settings.uniform_bindings ),
-    } ) );
+    // Shared with every other pipeline that has the same layouts.
+    LTB_CHECK( descriptor_set_layout_.initialize(
+        { .bindings = settings.uniform_bindings },
+        gpu_.object_cache( )
+    ) );
 
     LTB_CHECK( descriptor_sets_.initialize( {
         .layouts = {
             settings.descriptor_set_count,
             descriptor_set_layout_.get( ),
         },
+        .bindings = std::move( settings.uniform_bindings ),
     } ) );
 
-    LTB_CHECK( pipeline_layout_.initialize( {
-        .descriptor_set_layouts = { descriptor_set_layout_.get( ) },
-        .push_constant_ranges   = std::move( settings.uniform_push_constants ),
-    } ) );
+    LTB_CHECK( pipeline_layout_.initialize(
+        {
+            .descriptor_set_layouts = { descriptor_set_layout_.get( ) },
+            .push_constant_ranges   = std::move( settings.uniform_push_constants ),
+        },
+        gpu_.object_cache( )
+    ) );
+
+    return utils::success( );
+}
+
+auto VulkanComputePipeline::compile( ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( pipeline_layout_.is_initialized( ) );
 
     LTB_CHECK( pipeline_.initialize( ) );
 
@@ -58,6 +100,63 @@ auto VulkanComputePipeline::is_initialized( ) const -> bool
     return initialized_;
 }
 
+auto VulkanComputePipeline::reload_shaders( ) -> utils::Result< vk::UniquePipeline >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    LTB_CHECK( shader_module_.reload( ) );
+
+    return pipeline_.rebuild( );
+}
+
+auto VulkanComputePipeline::set_workgroup_size( glm::uvec3 const workgroup_size )
+    -> utils::Result< vk::UniquePipeline >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    // Drops the current size so `specialize` sees only the caller's own constants.
+    auto constants = shader_module_.settings( ).specialization_constants;
+    std::erase_if( constants, is_workgroup_size_constant );
+
+    auto const previous_size = workgroup_size_;
+    LTB_CHECK( this->specialize( constants, workgroup_size ) );
+
+    auto old_pipeline = pipeline_.rebuild( );
+    if ( !old_pipeline )
+    {
+        // Leaves the module specialized for the pipeline still in use.
+        utils::ignore( this->specialize( std::move( constants ), previous_size ) );
+    }
+    return old_pipeline;
+}
+
+auto VulkanComputePipeline::reallocate_descriptor_sets( uint32 const descriptor_set_count )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( descriptor_sets_.is_initialized( ) );
+    LTB_CHECK_VALID( descriptor_set_count > 0U );
+
+    auto settings = descriptor_sets_.settings( );
+    settings.layouts.assign( descriptor_set_count, descriptor_set_layout_.get( ) );
+
+    descriptor_sets_.reset( );
+    return descriptor_sets_.initialize( std::move( settings ) );
+}
+
+auto VulkanComputePipeline::workgroup_size( ) const -> glm::uvec3
+{
+    return workgroup_size_;
+}
+
+auto VulkanComputePipeline::dispatch(
+    vk::CommandBuffer const& command_buffer,
+    glm::uvec3 const         invocation_count
+) const -> void
+{
+    auto const group_count = workgroup_count( invocation_count, workgroup_size_ );
+    command_buffer.dispatch( group_count.x, group_count.y, group_count.z );
+}
+
 auto VulkanComputePipeline::bind( vk::CommandBuffer const& command_buffer ) -> void
 {
     command_buffer.bindPipeline( vk::PipelineBindPoint::eCompute, pipeline_.get( ) );
@@ -65,17 +164,27 @@ auto VulkanComputePipeline::bind( vk::CommandBuffer const& command_buffer ) -> v
 
 auto VulkanComputePipeline::bind_descriptor_sets( FrameInfo const& frame ) -> utils::Result< void >
 {
-    auto const descriptor_sets = descriptor_sets_.get( );
-    LTB_CHECK_VALID( frame.frame_index < descriptor_sets.size( ) );
+    return this->bind_descriptor_sets( frame, { } );
+}
+
+auto VulkanComputePipeline::bind_descriptor_sets(
+    FrameInfo const&             frame,
+    std::vector< uint32 > const& dynamic_offsets
+) -> utils::Result< void >
+{
+    auto const& descriptor_sets = descriptor_sets_.get( );
+    LTB_CHECK_VALID( !descriptor_sets.empty( ) );
+
+    // A single set is shared by every frame when its per-frame
+    // data is selected with dynamic offsets instead.
+    auto const set_index = frame.frame_index % descriptor_sets.size( );
 
-    constexpr auto bind_point = vk::PipelineBindPoint::eCompute;
-    constexpr auto first_set  = 0U;
-    frame.command_buffer.bindDescriptorSets(
-        bind_point,
+    objs::bind_descriptor_sets(
+        frame,
+        vk::PipelineBindPoint::eCompute,
         pipeline_layout_.get( ),
-        first_set,
-        descriptor_sets[ frame.frame_index ],
-        { }
+        std::span{ &descriptor_sets[ set_index ], 1UZ },
+        dynamic_offsets
     );
 
     return utils::success( );
@@ -131,4 +240,102 @@ auto VulkanComputePipeline::pipeline( ) -> ComputePipeline&
     return pipeline_;
 }
 
+auto VulkanComputePipeline::specialize(
+    std::vector< SpecializationConstant > constants,
+    glm::uvec3 const                      workgroup_size
+) -> utils::Result< void >
+{
+    auto const& limits = gpu_.physical_device( ).properties( ).limits;
+
+    for ( auto dim = 0; dim < 3; ++dim )
+    {
+        if ( ( 0U == workgroup_size[ dim ] )
+             || ( workgroup_size[ dim ] > limits.maxComputeWorkGroupSize[ dim ] ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Workgroup size {} in dimension {} is not in [1, {}]",
+                workgroup_size[ dim ],
+                dim,
+                limits.maxComputeWorkGroupSize[ dim ]
+            );
+        }
+    }
+    auto const invocations = workgroup_size.x * workgroup_size.y * workgroup_size.z;
+    if ( invocations > limits.maxComputeWorkGroupInvocations )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Workgroup size ({}, {}, {}) exceeds {} invocations",
+            workgroup_size.x,
+            workgroup_size.y,
+            workgroup_size.z,
+            limits.maxComputeWorkGroupInvocations
+        );
+    }
+
+    if ( std::ranges::any_of( constants, is_workgroup_size_constant ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Specialization constants {}, {} and {} are reserved for the workgroup size",
+            workgroup_size_constant_ids.x,
+            workgroup_size_constant_ids.y,
+            workgroup_size_constant_ids.z
+        );
+    }
+    for ( auto dim = 0; dim < 3; ++dim )
+    {
+        constants.push_back( {
+            .constant_id = workgroup_size_constant_ids[ dim ],
+            .value       = workgroup_size[ dim ],
+        } );
+    }
+
+    LTB_CHECK( shader_module_.set_specialization_constants( std::move( constants ) ) );
+    workgroup_size_ = workgroup_size;
+
+    return utils::success( );
+}
+
+auto VulkanComputePipeline::reflect_layout( VulkanComputePipelineSettings& settings ) const
+    -> utils::Result< void >
+{
+    if ( ( !settings.uniform_bindings.empty( ) ) && ( !settings.uniform_push_constants.empty( ) ) )
+    {
+        return utils::success( );
+    }
+
+    LTB_CHECK(
+        auto reflected,
+        reflect_pipeline_layout(
+            std::span{ &shader_module_.reflection( ), 1UZ },
+            settings.dynamic_buffers
+        )
+    );
+    if ( reflected.binding_sets.size( ) > 1UZ )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "'{}' uses {} descriptor sets but compute pipelines only support one",
+            shader_module_.settings( ).spirv_file.string( ),
+            reflected.binding_sets.size( )
+        );
+    }
+
+    if ( settings.uniform_bindings.empty( ) && ( !reflected.binding_sets.empty( ) ) )
+    {
+        LTB_CHECK( check_descriptor_counts( reflected.binding_sets.front( ) ) );
+        settings.uniform_bindings = std::move( reflected.binding_sets.front( ) );
+    }
+    if ( settings.uniform_push_constants.empty( ) )
+    {
+        settings.uniform_push_constants = std::move( reflected.push_constant_ranges );
+    }
+
+    return utils::success( );
+}
+
+auto workgroup_count( glm::uvec3 const invocation_count, glm::uvec3 const workgroup_size )
+    -> glm::uvec3
+{
+    return ( invocation_count + workgroup_size - 1U ) / workgroup_size;
+}
+
 } // namespace ltb::vlk::objs
@@ -4,6 +4,7 @@
 #include "ltb/vlk/objs/vulkan_gpu.hpp"
 
 // project
+#include "ltb/utils/cpu_profiler.hpp"
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/graphics_pipeline.hpp"
 #include "ltb/window/glfw_context.hpp"
@@ -27,6 +28,7 @@ auto VulkanGpu::initialize( VulkanGpuSettings settings ) -> utils::Result< void
     {
         return utils::success( );
     }
+    LTB_PROFILE_ZONE( "VulkanGpu::initialize" );
     LTB_CHECK_VALID( glfw_context_.is_initialized( ) );
     LTB_CHECK_VALID( glfw_window_.is_initialized( ) );
 
@@ -34,7 +36,10 @@ auto VulkanGpu::initialize( VulkanGpuSettings settings ) -> utils::Result< void
     LTB_CHECK( surface_.initialize( ) );
     LTB_CHECK( physical_device_.initialize( std::move( settings.device ), &surface_ ) );
     LTB_CHECK( device_.initialize( ) );
-    LTB_CHECK( descriptor_pool_.initialize( std::move( settings.descriptor_pool ) ) );
+    LTB_CHECK( memory_allocator_.initialize( settings.memory_allocator ) );
+    LTB_CHECK( descriptor_allocator_.initialize( std::move( settings.descriptor_allocator ) ) );
+    LTB_CHECK( pipeline_cache_.initialize( std::move( settings.pipeline_cache ) ) );
+    LTB_CHECK( object_cache_.initialize( ) );
 
     initialized_ = true;
 
@@ -86,14 +91,54 @@ auto VulkanGpu::device( ) -> Device&
     return device_;
 }
 
-auto VulkanGpu::descriptor_pool( ) const -> DescriptorPool const&
+auto VulkanGpu::memory_allocator( ) const -> DeviceMemoryAllocator const&
 {
-    return descriptor_pool_;
+    return memory_allocator_;
 }
 
-auto VulkanGpu::descriptor_pool( ) -> DescriptorPool&
+auto VulkanGpu::memory_allocator( ) -> DeviceMemoryAllocator&
 {
-    return descriptor_pool_;
+    return memory_allocator_;
+}
+
+auto VulkanGpu::memory_heap_usage( ) const -> std::vector< MemoryHeapUsage >
+{
+    return memory_allocator_.heap_usage( );
+}
+
+auto VulkanGpu::memory_tag_usage( ) const -> std::vector< MemoryTagUsage > const&
+{
+    return memory_allocator_.tag_usage( );
+}
+
+auto VulkanGpu::descriptor_allocator( ) const -> DescriptorAllocator const&
+{
+    return descriptor_allocator_;
+}
+
+auto VulkanGpu::descriptor_allocator( ) -> DescriptorAllocator&
+{
+    return descriptor_allocator_;
+}
+
+auto VulkanGpu::pipeline_cache( ) const -> PipelineCache const&
+{
+    return pipeline_cache_;
+}
+
+auto VulkanGpu::pipeline_cache( ) -> PipelineCache&
+{
+    return pipeline_cache_;
+}
+
+auto VulkanGpu::object_cache( ) const -> ObjectCache const&
+{
+    return object_cache_;
+}
+
+auto VulkanGpu::object_cache( ) -> ObjectCache&
+{
+    return object_cache_;
 }
 
 } // namespace ltb::vlk::objs
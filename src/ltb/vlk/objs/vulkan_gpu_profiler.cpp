@@ -0,0 +1,591 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_gpu_profiler.hpp"
+
+// project
+#include "ltb/utils/json_escape.hpp"
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+#include "ltb/vlk/physical_device.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+namespace ltb::vlk::objs
+{
+namespace
+{
+
+constexpr auto queries_per_scope = 2U;
+constexpr auto nanos_per_milli   = 1'000'000.0;
+
+auto compute_stats( std::string const& name, std::deque< float64 > const& samples_ms )
+    -> GpuScopeStats
+{
+    auto stats = GpuScopeStats{
+        .name         = name,
+        .sample_count = samples_ms.size( ),
+    };
+    if ( samples_ms.empty( ) )
+    {
+        return stats;
+    }
+
+    auto sorted = std::vector< float64 >( samples_ms.begin( ), samples_ms.end( ) );
+    std::ranges::sort( sorted );
+
+    auto const sample_count = static_cast< float64 >( sorted.size( ) );
+    auto const p99_rank     = static_cast< std::size_t >( std::ceil( 0.99 * sample_count ) );
+
+    stats.last_ms = samples_ms.back( );
+    stats.min_ms  = sorted.front( );
+    stats.avg_ms  = std::accumulate( sorted.begin( ), sorted.end( ), 0.0 ) / sample_count;
+    stats.p99_ms  = sorted[ std::max( p99_rank, 1UZ ) - 1UZ ];
+
+    return stats;
+}
+
+auto to_counters( vk::QueryPipelineStatisticFlags const flags )
+    -> std::vector< vk::QueryPipelineStatisticFlagBits >
+{
+    auto const bits     = static_cast< VkQueryPipelineStatisticFlags >( flags );
+    auto       counters = std::vector< vk::QueryPipelineStatisticFlagBits >{ };
+
+    for ( auto bit = 0U; bit < ( sizeof( bits ) * CHAR_BIT ); ++bit )
+    {
+        auto const flag = VkQueryPipelineStatisticFlags{ 1U } << bit;
+        if ( 0U != ( bits & flag ) )
+        {
+            counters.push_back( static_cast< vk::QueryPipelineStatisticFlagBits >( flag ) );
+        }
+    }
+
+    return counters;
+}
+
+/// \brief "Counter=value" pairs separated by `separator`, with each counter's name quoted
+///        by `quote`.
+auto format_statistics(
+    std::vector< PipelineStatistic > const& statistics,
+    std::string_view const                  quote,
+    std::string_view const                  separator
+) -> std::string
+{
+    auto formatted = std::string{ };
+    for ( auto const& statistic : statistics )
+    {
+        if ( !formatted.empty( ) )
+        {
+            formatted += separator;
+        }
+        formatted += fmt::format(
+            "{}{}{}{}{}",
+            quote,
+            vk::to_string( statistic.counter ),
+            quote,
+            ( quote.empty( ) ? "=" : ": " ),
+            statistic.value
+        );
+    }
+    return formatted;
+}
+
+auto open_output_file( std::filesystem::path const& file_path ) -> utils::Result< std::ofstream >
+{
+    auto file = std::ofstream( file_path );
+    if ( !file.is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Failed to open file '{}'", file_path.string( ) );
+    }
+    return file;
+}
+
+auto escape_csv( std::string_view const text ) -> std::string
+{
+    auto escaped = std::string{ "\"" };
+    for ( auto const character : text )
+    {
+        if ( '"' == character )
+        {
+            escaped.push_back( '"' );
+        }
+        escaped.push_back( character );
+    }
+    escaped.push_back( '"' );
+    return escaped;
+}
+
+} // namespace
+
+VulkanGpuProfiler::VulkanGpuProfiler( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanGpuProfiler::initialize( VulkanGpuProfilerSettings const settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.frame_count > 0U );
+    LTB_CHECK_VALID( settings.max_scopes_per_frame > 0U );
+    LTB_CHECK_VALID( settings.history_size > 0UZ );
+
+    auto const& physical_device = gpu_.physical_device( );
+    LTB_CHECK_VALID( physical_device.queue_families( ).contains( settings.queue_type ) );
+
+    auto const queue_family      = physical_device.queue_families( ).at( settings.queue_type );
+    auto const family_properties = physical_device.get( ).getQueueFamilyProperties( );
+    LTB_CHECK_VALID( queue_family < family_properties.size( ) );
+
+    auto const scope_count = settings.frame_count * settings.max_scopes_per_frame;
+
+    // Only the low `timestampValidBits` of each timestamp are meaningful.
+    auto const valid_bits = family_properties[ queue_family ].timestampValidBits;
+    if ( 0U == valid_bits )
+    {
+        spdlog::warn(
+            "Queue family {} does not support timestamps. GPU scopes are not timed.",
+            queue_family
+        );
+    }
+    else
+    {
+        LTB_CHECK( query_pool_.initialize( {
+            .query_type  = vk::QueryType::eTimestamp,
+            .query_count = scope_count * queries_per_scope,
+        } ) );
+    }
+
+    if ( settings.pipeline_statistics
+         && physical_device.has_feature( &vk::PhysicalDeviceFeatures::pipelineStatisticsQuery ) )
+    {
+        LTB_CHECK( statistics_query_pool_.initialize( {
+            .query_type          = vk::QueryType::ePipelineStatistics,
+            .query_count         = scope_count,
+            .pipeline_statistics = settings.pipeline_statistics,
+        } ) );
+        statistic_counters_ = to_counters( settings.pipeline_statistics );
+    }
+    else if ( settings.pipeline_statistics )
+    {
+        spdlog::warn( "Pipeline statistics queries are not supported by this device." );
+    }
+
+    timestamp_mask_ = ( valid_bits >= 64U ) ? std::numeric_limits< uint64 >::max( )
+                                             : ( ( uint64{ 1U } << valid_bits ) - 1U );
+    ms_per_tick_
+        = static_cast< float64 >( physical_device.properties( ).limits.timestampPeriod )
+        / nanos_per_milli;
+
+    settings_    = settings;
+    frames_      = std::vector< FrameScopes >( settings.frame_count );
+    initialized_ = true;
+
+    return utils::success( );
+}
+
+auto VulkanGpuProfiler::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto VulkanGpuProfiler::is_supported( ) const -> bool
+{
+    return query_pool_.is_initialized( );
+}
+
+auto VulkanGpuProfiler::collects_statistics( ) const -> bool
+{
+    return statistics_query_pool_.is_initialized( );
+}
+
+auto VulkanGpuProfiler::start_frame( uint32 const frame_index ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( frame_index < frames_.size( ) );
+
+    LTB_CHECK( this->collect_timestamps( frame_index ) );
+    LTB_CHECK( this->collect_statistics( frame_index ) );
+
+    auto& frame = frames_[ frame_index ];
+    frame.scopes.clear( );
+    frame.open_scopes.clear( );
+    frame.used_queries            = 0U;
+    frame.used_statistics_queries = 0U;
+    frame.statistics_active       = false;
+
+    return utils::success( );
+}
+
+auto VulkanGpuProfiler::begin_scope(
+    FrameInfo const&                frame,
+    std::string_view const          name,
+    ScopeStatistics const           statistics,
+    vk::PipelineStageFlagBits const stage
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( frame.frame_index < frames_.size( ) );
+
+    auto const with_statistics
+        = ( ScopeStatistics::Yes == statistics ) && this->collects_statistics( );
+
+    if ( ( !this->is_supported( ) ) && ( !this->collects_statistics( ) ) )
+    {
+        return utils::success( );
+    }
+
+    auto& frame_scopes = frames_[ frame.frame_index ];
+    if ( frame_scopes.scopes.size( ) >= settings_.max_scopes_per_frame )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "GPU profiler frame is out of scopes ({}). Increase max_scopes_per_frame.",
+            settings_.max_scopes_per_frame
+        );
+    }
+
+    auto scope = Scope{
+        .name_index  = this->name_index( name ),
+        .begin_query = frame_scopes.used_queries,
+        .end_query   = frame_scopes.used_queries + 1U,
+    };
+
+    if ( this->is_supported( ) )
+    {
+        frame_scopes.used_queries += queries_per_scope;
+
+        auto const first_query = frame.frame_index * this->queries_per_frame( );
+        frame.command_buffer
+            .writeTimestamp( stage, query_pool_.get( ), first_query + scope.begin_query );
+    }
+
+    if ( with_statistics )
+    {
+        // Only one query of a type can be active at a time.
+        if ( frame_scopes.statistics_active )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "GPU scope '{}' cannot collect statistics inside another statistics scope",
+                name
+            );
+        }
+        frame_scopes.statistics_active = true;
+
+        scope.statistics_query = frame_scopes.used_statistics_queries;
+        ++frame_scopes.used_statistics_queries;
+
+        auto const first_query = frame.frame_index * settings_.max_scopes_per_frame;
+        frame.command_buffer.beginQuery(
+            statistics_query_pool_.get( ),
+            first_query + scope.statistics_query.value( ),
+            vk::QueryControlFlags{ }
+        );
+    }
+
+    frame_scopes.open_scopes.push_back( frame_scopes.scopes.size( ) );
+    frame_scopes.scopes.push_back( scope );
+
+    return utils::success( );
+}
+
+auto VulkanGpuProfiler::end_scope( FrameInfo const& frame, vk::PipelineStageFlagBits const stage )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( frame.frame_index < frames_.size( ) );
+
+    if ( ( !this->is_supported( ) ) && ( !this->collects_statistics( ) ) )
+    {
+        return utils::success( );
+    }
+
+    auto& frame_scopes = frames_[ frame.frame_index ];
+    LTB_CHECK_VALID( !frame_scopes.open_scopes.empty( ) );
+
+    auto& scope = frame_scopes.scopes[ frame_scopes.open_scopes.back( ) ];
+    frame_scopes.open_scopes.pop_back( );
+    scope.ended = true;
+
+    if ( scope.statistics_query.has_value( ) )
+    {
+        auto const first_query = frame.frame_index * settings_.max_scopes_per_frame;
+        frame.command_buffer.endQuery(
+            statistics_query_pool_.get( ),
+            first_query + scope.statistics_query.value( )
+        );
+        frame_scopes.statistics_active = false;
+    }
+
+    if ( this->is_supported( ) )
+    {
+        auto const first_query = frame.frame_index * this->queries_per_frame( );
+        frame.command_buffer
+            .writeTimestamp( stage, query_pool_.get( ), first_query + scope.end_query );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanGpuProfiler::stats( ) const -> std::vector< GpuScopeStats >
+{
+    auto all_stats = std::vector< GpuScopeStats >{ };
+    all_stats.reserve( histories_.size( ) );
+
+    for ( auto const& history : histories_ )
+    {
+        auto scope_stats       = compute_stats( history.name, history.samples_ms );
+        scope_stats.statistics = history.statistics;
+        all_stats.push_back( std::move( scope_stats ) );
+    }
+
+    return all_stats;
+}
+
+auto VulkanGpuProfiler::settings( ) const -> VulkanGpuProfilerSettings const&
+{
+    return settings_;
+}
+
+auto VulkanGpuProfiler::queries_per_frame( ) const -> uint32
+{
+    return settings_.max_scopes_per_frame * queries_per_scope;
+}
+
+auto VulkanGpuProfiler::name_index( std::string_view const name ) -> std::size_t
+{
+    if ( auto const iter = name_indices_.find( name ); iter != name_indices_.end( ) )
+    {
+        return iter->second;
+    }
+
+    auto const index = histories_.size( );
+    histories_.push_back( { .name = std::string( name ) } );
+    name_indices_.emplace( std::string( name ), index );
+
+    return index;
+}
+
+auto VulkanGpuProfiler::collect_timestamps( uint32 const frame_index ) -> utils::Result< void >
+{
+    auto const& frame       = frames_[ frame_index ];
+    auto const  first_query = frame_index * this->queries_per_frame( );
+
+    if ( 0U == frame.used_queries )
+    {
+        return utils::success( );
+    }
+
+    // Each query writes its timestamp followed by its availability, so a scope that was
+    // begun but never ended only loses its own sample.
+    constexpr auto values_per_query = 2UZ;
+
+    auto       timestamps = std::vector< uint64 >( frame.used_queries * values_per_query );
+    auto const result     = gpu_.device( ).get( ).getQueryPoolResults(
+        query_pool_.get( ),
+        first_query,
+        frame.used_queries,
+        timestamps.size( ) * sizeof( uint64 ),
+        timestamps.data( ),
+        values_per_query * sizeof( uint64 ),
+        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability
+    );
+
+    // Not ready when any query in the frame is unavailable. Those are skipped below.
+    if ( vk::Result::eNotReady != result )
+    {
+        VK_CHECK( result );
+    }
+
+    auto const is_available = [ &timestamps ]( uint32 const query ) {
+        return 0U != timestamps[ ( query * values_per_query ) + 1UZ ];
+    };
+
+    auto unavailable_scopes = 0UZ;
+    for ( auto const& scope : frame.scopes )
+    {
+        if ( ( !scope.ended ) || ( !is_available( scope.begin_query ) )
+             || ( !is_available( scope.end_query ) ) )
+        {
+            ++unavailable_scopes;
+            continue;
+        }
+        auto const begin = timestamps[ scope.begin_query * values_per_query ];
+        auto const end   = timestamps[ scope.end_query * values_per_query ];
+        auto const ticks = ( end - begin ) & timestamp_mask_;
+
+        auto& samples = histories_[ scope.name_index ].samples_ms;
+        samples.push_back( static_cast< float64 >( ticks ) * ms_per_tick_ );
+        if ( samples.size( ) > settings_.history_size )
+        {
+            samples.pop_front( );
+        }
+    }
+
+    if ( unavailable_scopes > 0UZ )
+    {
+        spdlog::warn(
+            "Dropped {} GPU scopes that were not ended or whose commands were not submitted",
+            unavailable_scopes
+        );
+    }
+
+    gpu_.device( ).get( ).resetQueryPool( query_pool_.get( ), first_query, frame.used_queries );
+
+    return utils::success( );
+}
+
+auto VulkanGpuProfiler::collect_statistics( uint32 const frame_index ) -> utils::Result< void >
+{
+    auto const& frame       = frames_[ frame_index ];
+    auto const  first_query = frame_index * settings_.max_scopes_per_frame;
+
+    if ( 0U == frame.used_statistics_queries )
+    {
+        return utils::success( );
+    }
+
+    // Each query writes one value per counter, in counter bit order, followed by its
+    // availability.
+    auto const counter_count    = statistic_counters_.size( );
+    auto const values_per_query = counter_count + 1UZ;
+    auto       values = std::vector< uint64 >( frame.used_statistics_queries * values_per_query );
+    auto const result = gpu_.device( ).get( ).getQueryPoolResults(
+        statistics_query_pool_.get( ),
+        first_query,
+        frame.used_statistics_queries,
+        values.size( ) * sizeof( uint64 ),
+        values.data( ),
+        values_per_query * sizeof( uint64 ),
+        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability
+    );
+
+    // Not ready when any query in the frame is unavailable. Those are skipped below.
+    if ( vk::Result::eNotReady != result )
+    {
+        VK_CHECK( result );
+    }
+
+    for ( auto const& scope : frame.scopes )
+    {
+        if ( ( !scope.ended ) || ( !scope.statistics_query.has_value( ) ) )
+        {
+            continue;
+        }
+        auto const first_value = scope.statistics_query.value( ) * values_per_query;
+        if ( 0U == values[ first_value + counter_count ] )
+        {
+            continue;
+        }
+
+        auto& statistics = histories_[ scope.name_index ].statistics;
+        statistics.clear( );
+        for ( auto i = 0UZ; i < counter_count; ++i )
+        {
+            statistics.push_back( {
+                .counter = statistic_counters_[ i ],
+                .value   = values[ first_value + i ],
+            } );
+        }
+    }
+
+    gpu_.device( ).get( ).resetQueryPool(
+        statistics_query_pool_.get( ),
+        first_query,
+        frame.used_statistics_queries
+    );
+
+    return utils::success( );
+}
+
+auto begin_gpu_scope(
+    FrameInfo const&                frame,
+    std::string_view const          name,
+    ScopeStatistics const           statistics,
+    vk::PipelineStageFlagBits const stage
+) -> utils::Result< void >
+{
+    if ( nullptr == frame.profiler )
+    {
+        return utils::success( );
+    }
+    return frame.profiler->begin_scope( frame, name, statistics, stage );
+}
+
+auto end_gpu_scope( FrameInfo const& frame, vk::PipelineStageFlagBits const stage )
+    -> utils::Result< void >
+{
+    if ( nullptr == frame.profiler )
+    {
+        return utils::success( );
+    }
+    return frame.profiler->end_scope( frame, stage );
+}
+
+auto write_gpu_stats_csv(
+    std::filesystem::path const&        file_path,
+    std::vector< GpuScopeStats > const& stats
+) -> utils::Result< void >
+{
+    LTB_CHECK( auto file, open_output_file( file_path ) );
+
+    file << "scope,samples,last_ms,min_ms,avg_ms,p99_ms,statistics\n";
+    for ( auto const& scope : stats )
+    {
+        file << fmt::format(
+            "{},{},{:.6f},{:.6f},{:.6f},{:.6f},{}\n",
+            escape_csv( scope.name ),
+            scope.sample_count,
+            scope.last_ms,
+            scope.min_ms,
+            scope.avg_ms,
+            scope.p99_ms,
+            escape_csv( format_statistics( scope.statistics, "", ";" ) )
+        );
+    }
+
+    return utils::success( );
+}
+
+auto write_gpu_stats_json(
+    std::filesystem::path const&        file_path,
+    std::vector< GpuScopeStats > const& stats
+) -> utils::Result< void >
+{
+    LTB_CHECK( auto file, open_output_file( file_path ) );
+
+    file << "[\n";
+    for ( auto i = 0UZ; i < stats.size( ); ++i )
+    {
+        auto const& scope = stats[ i ];
+        file << fmt::format(
+            "  {{\"scope\": \"{}\", \"samples\": {}, \"last_ms\": {:.6f}, \"min_ms\": {:.6f}, "
+            "\"avg_ms\": {:.6f}, \"p99_ms\": {:.6f}, \"statistics\": {{{}}}}}{}\n",
+            utils::escape_json( scope.name ),
+            scope.sample_count,
+            scope.last_ms,
+            scope.min_ms,
+            scope.avg_ms,
+            scope.p99_ms,
+            format_statistics( scope.statistics, "\"", ", " ),
+            ( ( i + 1UZ ) < stats.size( ) ) ? "," : ""
+        );
+    }
+    file << "]\n";
+
+    return utils::success( );
+}
+
+} // namespace ltb::vlk::objs
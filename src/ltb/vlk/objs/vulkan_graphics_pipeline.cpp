@@ -5,14 +5,55 @@
 
 // project
 #include "ltb/vlk/check.hpp"
+#include "ltb/vlk/objs/descriptor_bind_state.hpp"
 #include "ltb/vlk/objs/frame_info.hpp"
 #include "ltb/vlk/vector_utils.hpp"
 
 // external
 #include <spdlog/spdlog.h>
 
+// standard
+#include <algorithm>
+#include <span>
+
 namespace ltb::vlk::objs
 {
+namespace
+{
+
+// The shaders may declare fewer bindings than the external set has, but every binding they
+// declare must exist in it with the same type, enough descriptors and the stage.
+auto check_external_bindings(
+    std::span< vk::DescriptorSetLayoutBinding const > const reflected,
+    ExternalDescriptorSet const&                            external
+) -> utils::Result< void >
+{
+    for ( auto const& binding : reflected )
+    {
+        auto const iter = std::ranges::find(
+            external.bindings,
+            binding.binding,
+            &vk::DescriptorSetLayoutBinding::binding
+        );
+
+        // A count of zero is a runtime sized array, which any count can back.
+        if ( ( external.bindings.end( ) == iter )
+             || ( iter->descriptorType != binding.descriptorType )
+             || ( iter->descriptorCount < binding.descriptorCount )
+             || ( ( iter->stageFlags & binding.stageFlags ) != binding.stageFlags ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Set {} binding {} does not match the external set's layout",
+                external.set,
+                binding.binding
+            );
+        }
+    }
+
+    return utils::success( );
+}
+
+} // namespace
 
 VulkanGraphicsPipeline::VulkanGraphicsPipeline( VulkanGpu& gpu, VulkanPresentation& presentation )
     : gpu_( gpu )
@@ -27,46 +68,151 @@ auto VulkanGraphicsPipeline::initialize( VulkanGraphicsPipelineSettings settings
     {
         return utils::success( );
     }
+    LTB_CHECK( auto pipeline_settings, this->initialize_layouts( std::move( settings ) ) );
+    return this->compile( std::move( pipeline_settings ) );
+}
+
+auto VulkanGraphicsPipeline::initialize_layouts( VulkanGraphicsPipelineSettings settings )
+    -> utils::Result< GraphicsPipelineSettings >
+{
     LTB_CHECK_VALID( gpu_.is_initialized( ) );
     LTB_CHECK_VALID( presentation_.is_initialized( ) );
+    LTB_CHECK_VALID( !pipeline_layout_.is_initialized( ) );
 
     LTB_CHECK_VALID( !settings.shader_modules.empty( ) );
     LTB_CHECK_VALID( settings.descriptor_set_count > 0U );
 
+    for ( auto i = 1UZ; i < settings.external_sets.size( ); ++i )
+    {
+        LTB_CHECK_VALID(
+            settings.external_sets[ i ].set == ( settings.external_sets[ i - 1UZ ].set + 1U )
+        );
+    }
+
     for ( auto& shader_module_settings : settings.shader_modules )
     {
         LTB_CHECK( shader_modules_.emplace_back( gpu_.device( ) )
                        .initialize( std::move( shader_module_settings ) ) );
     }
+    LTB_CHECK( this->reflect_layout( settings ) );
+    LTB_CHECK_VALID(
+        settings.external_sets.empty( )
+        || ( settings.uniform_binding_sets.size( ) == settings.external_sets.front( ).set )
+    );
 
     descriptor_set_layouts_.reserve( settings.uniform_binding_sets.size( ) );
     descriptor_sets_.reserve( settings.uniform_binding_sets.size( ) );
 
     for ( auto& bindings : settings.uniform_binding_sets )
     {
+        // Shared with every other pipeline that has the same layouts.
         LTB_CHECK( descriptor_set_layouts_.emplace_back( gpu_.device( ) )
-                       .initialize( {
-                           .bindings = std::move( bindings ),
-                       } ) );
+                       .initialize( { .bindings = bindings }, gpu_.object_cache( ) ) );
 
-        LTB_CHECK( descriptor_sets_.emplace_back( gpu_.device( ), gpu_.descriptor_pool( ) )
+        LTB_CHECK( descriptor_sets_.emplace_back( gpu_.device( ), gpu_.descriptor_allocator( ) )
                        .initialize( {
                            .layouts = {
                                settings.descriptor_set_count,
                                descriptor_set_layouts_.back( ).get( ),
                            },
+                           .bindings = std::move( bindings ),
                        } ) );
     }
 
     auto descriptor_set_layouts = descriptor_set_layouts_ | ranges::views::transform( Get{ } )
                                 | ranges::to< std::vector >( );
+    for ( auto const& external : settings.external_sets )
+    {
+        descriptor_set_layouts.push_back( external.layout );
+    }
 
-    LTB_CHECK( pipeline_layout_.initialize( {
-        .descriptor_set_layouts = std::move( descriptor_set_layouts ),
-        .push_constant_ranges   = std::move( settings.uniform_push_constants ),
-    } ) );
+    LTB_CHECK( pipeline_layout_.initialize(
+        {
+            .descriptor_set_layouts = std::move( descriptor_set_layouts ),
+            .push_constant_ranges   = std::move( settings.uniform_push_constants ),
+        },
+        gpu_.object_cache( )
+    ) );
 
-    LTB_CHECK( pipeline_.initialize( std::move( settings.pipeline ) ) );
+    return std::move( settings.pipeline );
+}
+
+auto VulkanGraphicsPipeline::reflect_layout( VulkanGraphicsPipelineSettings& settings ) const
+    -> utils::Result< void >
+{
+    auto reflections = shader_modules_
+                     | ranges::views::transform( &ShaderModule::reflection )
+                     | ranges::to< std::vector >( );
+
+    for ( auto const& reflection : reflections )
+    {
+        if ( vk::ShaderStageFlagBits::eVertex == reflection.stage )
+        {
+            LTB_CHECK( check_vertex_inputs( reflection, settings.pipeline.vertex_attributes ) );
+        }
+    }
+
+    if ( ( !settings.uniform_binding_sets.empty( ) )
+         && ( !settings.uniform_push_constants.empty( ) ) )
+    {
+        return utils::success( );
+    }
+
+    LTB_CHECK( auto reflected, reflect_pipeline_layout( reflections, settings.dynamic_buffers ) );
+
+    if ( settings.uniform_binding_sets.empty( ) )
+    {
+        auto&       binding_sets  = reflected.binding_sets;
+        auto const& external_sets = settings.external_sets;
+        auto const  own_set_count
+            = external_sets.empty( ) ? binding_sets.size( ) : external_sets.front( ).set;
+
+        // External sets are laid out by their owners. The shaders only have to agree with
+        // them, and may leave some of them out.
+        for ( auto set = own_set_count; set < binding_sets.size( ); ++set )
+        {
+            auto const external_index = set - own_set_count;
+            if ( external_index >= external_sets.size( ) )
+            {
+                return LTB_MAKE_UNEXPECTED_ERROR(
+                    "Set {} is declared by the shaders but is not an external set",
+                    set
+                );
+            }
+            LTB_CHECK(
+                check_external_bindings( binding_sets[ set ], external_sets[ external_index ] )
+            );
+        }
+
+        if ( binding_sets.size( ) < own_set_count )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "The shaders declare {} of the pipeline's {} sets",
+                binding_sets.size( ),
+                own_set_count
+            );
+        }
+        binding_sets.resize( own_set_count );
+
+        for ( auto const& bindings : binding_sets )
+        {
+            LTB_CHECK( check_descriptor_counts( bindings ) );
+        }
+        settings.uniform_binding_sets = std::move( reflected.binding_sets );
+    }
+    if ( settings.uniform_push_constants.empty( ) )
+    {
+        settings.uniform_push_constants = std::move( reflected.push_constant_ranges );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanGraphicsPipeline::compile( GraphicsPipelineSettings settings ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( pipeline_layout_.is_initialized( ) );
+
+    LTB_CHECK( pipeline_.initialize( std::move( settings ) ) );
 
     initialized_ = true;
 
@@ -80,22 +226,40 @@ auto VulkanGraphicsPipeline::bind( vk::CommandBuffer const& command_buffer ) ->
 
 auto VulkanGraphicsPipeline::bind_descriptor_sets( FrameInfo const& frame ) -> utils::Result< void >
 {
+    return this->bind_descriptor_sets( frame, { } );
+}
+
+auto VulkanGraphicsPipeline::bind_descriptor_sets(
+    FrameInfo const&             frame,
+    std::vector< uint32 > const& dynamic_offsets
+) -> utils::Result< void >
+{
+    if ( descriptor_sets_.empty( ) )
+    {
+        return utils::success( );
+    }
+
+    auto frame_descriptors = std::vector< vk::DescriptorSet >{ };
+    frame_descriptors.reserve( descriptor_sets_.size( ) );
+
     for ( auto& descriptor_sets : descriptor_sets_ )
     {
-        auto const descriptors = descriptor_sets.get( );
-        LTB_CHECK_VALID( frame.frame_index < descriptors.size( ) );
-
-        constexpr auto bind_point = vk::PipelineBindPoint::eGraphics;
-        constexpr auto first_set  = 0U;
-        frame.command_buffer.bindDescriptorSets(
-            bind_point,
-            pipeline_layout_.get( ),
-            first_set,
-            descriptors[ frame.frame_index ],
-            { }
-        );
+        auto const& descriptors = descriptor_sets.get( );
+        LTB_CHECK_VALID( !descriptors.empty( ) );
+
+        // A single set is shared by every frame when its per-frame
+        // data is selected with dynamic offsets instead.
+        frame_descriptors.push_back( descriptors[ frame.frame_index % descriptors.size( ) ] );
     }
 
+    objs::bind_descriptor_sets(
+        frame,
+        vk::PipelineBindPoint::eGraphics,
+        pipeline_layout_.get( ),
+        frame_descriptors,
+        dynamic_offsets
+    );
+
     return utils::success( );
 }
 
@@ -104,6 +268,18 @@ auto VulkanGraphicsPipeline::is_initialized( ) const -> bool
     return initialized_;
 }
 
+auto VulkanGraphicsPipeline::reload_shaders( ) -> utils::Result< vk::UniquePipeline >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    for ( auto& shader_module : shader_modules_ )
+    {
+        LTB_CHECK( shader_module.reload( ) );
+    }
+
+    return pipeline_.rebuild( );
+}
+
 auto VulkanGraphicsPipeline::shader_modules( ) const -> std::vector< ShaderModule > const&
 {
     return shader_modules_;
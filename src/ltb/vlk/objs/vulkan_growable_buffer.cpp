@@ -0,0 +1,171 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_growable_buffer.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+
+// standard
+#include <algorithm>
+
+namespace ltb::vlk::objs
+{
+
+VulkanGrowableBuffer::VulkanGrowableBuffer( VulkanGpu& gpu, VulkanUploader& uploader )
+    : gpu_( gpu )
+    , uploader_( uploader )
+{
+}
+
+auto VulkanGrowableBuffer::initialize( VulkanGrowableBufferSettings settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( uploader_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.initial_capacity > 0U );
+
+    // The old contents are copied on the queue that uses the buffer, see `reallocate`.
+    LTB_CHECK_VALID( !uploader_.transfers_ownership( ) );
+
+    settings_   = std::move( settings );
+    size_       = 0U;
+    capacity_   = 0U;
+    generation_ = 0U;
+
+    LTB_CHECK( this->reallocate( settings_.initial_capacity ) );
+
+    return utils::success( );
+}
+
+auto VulkanGrowableBuffer::is_initialized( ) const -> bool
+{
+    return nullptr != buffer_;
+}
+
+auto VulkanGrowableBuffer::reset( ) -> void
+{
+    retired_.clear( );
+    buffer_.reset( );
+    size_       = 0U;
+    capacity_   = 0U;
+    generation_ = 0U;
+    settings_   = { };
+}
+
+auto VulkanGrowableBuffer::reserve( vk::DeviceSize const capacity ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK( this->release_retired( ) );
+
+    if ( capacity <= capacity_ )
+    {
+        return utils::success( );
+    }
+    return this->reallocate( capacity );
+}
+
+auto VulkanGrowableBuffer::push_back( void const* const data, vk::DeviceSize const size )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    auto const required = size_ + size;
+    if ( required > capacity_ )
+    {
+        // Doubling keeps the total bytes copied proportional to the final size.
+        LTB_CHECK( this->reserve( std::max( required, capacity_ * 2U ) ) );
+    }
+
+    LTB_CHECK( uploader_.upload( data, size, buffer_->buffer( ), size_ ) );
+    size_ = required;
+
+    return utils::success( );
+}
+
+auto VulkanGrowableBuffer::update(
+    void const* const    data,
+    vk::DeviceSize const size,
+    vk::DeviceSize const offset
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( ( offset + size ) <= size_ );
+
+    return uploader_.upload( data, size, buffer_->buffer( ), offset );
+}
+
+auto VulkanGrowableBuffer::clear( ) -> void
+{
+    size_ = 0U;
+}
+
+auto VulkanGrowableBuffer::release_retired( ) -> utils::Result< void >
+{
+    for ( auto iter = retired_.begin( ); iter != retired_.end( ); )
+    {
+        LTB_CHECK( auto const complete, uploader_.is_complete( iter->submission ) );
+        iter = complete ? retired_.erase( iter ) : std::next( iter );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanGrowableBuffer::size( ) const -> vk::DeviceSize
+{
+    return size_;
+}
+
+auto VulkanGrowableBuffer::capacity( ) const -> vk::DeviceSize
+{
+    return capacity_;
+}
+
+auto VulkanGrowableBuffer::generation( ) const -> uint64
+{
+    return generation_;
+}
+
+auto VulkanGrowableBuffer::buffer( ) const -> VulkanBuffer const&
+{
+    return *buffer_;
+}
+
+auto VulkanGrowableBuffer::reallocate( vk::DeviceSize const capacity ) -> utils::Result< void >
+{
+    auto next = std::make_unique< VulkanBuffer >( gpu_ );
+
+    LTB_CHECK( next->initialize( {
+        .layout       = { .total_size = capacity },
+        .buffer_usage = settings_.buffer_usage
+                      | vk::BufferUsageFlagBits::eTransferSrc
+                      | vk::BufferUsageFlagBits::eTransferDst,
+        .memory_properties  = vk::MemoryPropertyFlagBits::eDeviceLocal,
+        .store_mapped_value = false,
+        .tag                = settings_.tag,
+    } ) );
+
+    if ( nullptr != buffer_ )
+    {
+        // Even an empty copy orders the batch after all earlier work on the queue, so the
+        // old buffer is no longer in use once that batch completes.
+        LTB_CHECK( uploader_.copy( buffer_->buffer( ), 0U, next->buffer( ), 0U, size_ ) );
+
+        retired_.push_back( {
+            .buffer     = std::move( buffer_ ),
+            .submission = uploader_.pending_submission( ),
+        } );
+    }
+
+    buffer_   = std::move( next );
+    capacity_ = capacity;
+    ++generation_;
+
+    return utils::success( );
+}
+
+} // namespace ltb::vlk::objs
@@ -5,7 +5,6 @@
 
 // project
 #include "ltb/vlk/check.hpp"
-#include "ltb/vlk/device_memory_utils.hpp"
 
 namespace ltb::vlk::objs
 {
@@ -15,6 +14,11 @@ VulkanImage::VulkanImage( VulkanGpu& gpu )
 {
 }
 
+VulkanImage::~VulkanImage( )
+{
+    this->reset( );
+}
+
 auto VulkanImage::initialize( VulkanImageSettings settings ) -> utils::Result< void >
 {
     if ( this->is_initialized( ) )
@@ -23,21 +27,27 @@ auto VulkanImage::initialize( VulkanImageSettings settings ) -> utils::Result< v
     }
     LTB_CHECK_VALID( gpu_.is_initialized( ) );
 
+    auto const tiling = ( vk::ImageTiling::eLinear == settings.image.tiling )
+                          ? AllocationTiling::Linear
+                          : AllocationTiling::Optimal;
+
     LTB_CHECK( image_.initialize( std::move( settings.image ) ) );
 
     LTB_CHECK(
-        auto const memory_range,
-        initialize_memory_chunk(
-            memory_,
-            gpu_.physical_device( ),
+        allocation_,
+        gpu_.memory_allocator( ).allocate(
             image_.memory_requirements( ),
-            settings.memory_properties
+            settings.memory_properties,
+            tiling,
+            settings.tag
         )
     );
 
-    VK_CHECK(
-        gpu_.device( ).get( ).bindImageMemory( image_.get( ), memory_.get( ), memory_range.offset )
-    );
+    VK_CHECK( gpu_.device( ).get( ).bindImageMemory(
+        image_.get( ),
+        allocation_.memory,
+        allocation_.range.offset
+    ) );
 
     initialized_ = true;
 
@@ -51,8 +61,9 @@ auto VulkanImage::is_initialized( ) const -> bool
 
 auto VulkanImage::reset( ) -> void
 {
-    memory_.reset( );
     image_.reset( );
+    gpu_.memory_allocator( ).free( allocation_ );
+    allocation_  = { };
     initialized_ = false;
 }
 
@@ -66,14 +77,9 @@ auto VulkanImage::image( ) -> Image&
     return image_;
 }
 
-auto VulkanImage::memory( ) const -> DeviceMemory const&
-{
-    return memory_;
-}
-
-auto VulkanImage::memory( ) -> DeviceMemory&
+auto VulkanImage::allocation( ) const -> DeviceAllocation const&
 {
-    return memory_;
+    return allocation_;
 }
 
 } // namespace ltb::vlk::objs
@@ -0,0 +1,200 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_parallel_recorder.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/descriptor_writer.hpp"
+#include "ltb/vlk/device.hpp"
+#include "ltb/vlk/objs/descriptor_bind_state.hpp"
+
+// standard
+#include <algorithm>
+#include <execution>
+#include <thread>
+
+namespace ltb::vlk::objs
+{
+namespace
+{
+
+auto divide_round_up( std::size_t const value, std::size_t const divisor ) -> std::size_t
+{
+    return ( ( value + divisor ) - 1UZ ) / divisor;
+}
+
+} // namespace
+
+VulkanParallelRecorder::VulkanParallelRecorder( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanParallelRecorder::initialize( VulkanParallelRecorderSettings const settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.frame_count > 0U );
+    LTB_CHECK_VALID( settings.min_items_per_worker > 0UZ );
+
+    auto const worker_count = ( settings.worker_count > 0U )
+                                ? settings.worker_count
+                                : std::max( std::thread::hardware_concurrency( ), 1U );
+
+    // Command pools must be externally synchronized, so each worker of each frame gets
+    // its own. A whole frame's pools are reset at once instead of individual buffers.
+    auto pools = std::deque< WorkerPool >{ };
+    for ( auto pool_index = 0U; pool_index < ( settings.frame_count * worker_count ); ++pool_index )
+    {
+        auto& pool = pools.emplace_back( CommandPool{ gpu_.device( ), gpu_.physical_device( ) } );
+        LTB_CHECK( pool.command_pool.initialize( {
+            .queue_type = settings.queue_type,
+            .flags      = vk::CommandPoolCreateFlagBits::eTransient,
+        } ) );
+    }
+
+    settings_     = settings;
+    worker_count_ = worker_count;
+    pools_        = std::move( pools );
+    initialized_  = true;
+
+    return utils::success( );
+}
+
+auto VulkanParallelRecorder::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto VulkanParallelRecorder::start_frame( FrameInfo const& frame ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( frame.frame_index < settings_.frame_count );
+
+    auto const first_pool = static_cast< std::size_t >( frame.frame_index ) * worker_count_;
+    for ( auto worker_index = 0UZ; worker_index < worker_count_; ++worker_index )
+    {
+        auto& pool = pools_[ first_pool + worker_index ];
+
+        constexpr auto reset_flags = vk::CommandPoolResetFlags{ };
+        VK_CHECK( gpu_.device( ).get( ).resetCommandPool( pool.command_pool.get( ), reset_flags ) );
+        pool.used = 0UZ;
+    }
+
+    return utils::success( );
+}
+
+auto VulkanParallelRecorder::record(
+    FrameInfo const&                        frame,
+    vk::CommandBufferInheritanceInfo const& inheritance,
+    std::size_t const                       item_count,
+    RecordRange const&                      record_range
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( frame.frame_index < settings_.frame_count );
+    LTB_CHECK_VALID( record_range );
+
+    if ( 0UZ == item_count )
+    {
+        return utils::success( );
+    }
+
+    // Workers never flush the frame's writer, so its queued writes are applied first.
+    if ( nullptr != frame.descriptor_writer )
+    {
+        frame.descriptor_writer->flush( );
+    }
+
+    auto const max_chunks = divide_round_up( item_count, settings_.min_items_per_worker );
+    auto const chunk_size = divide_round_up(
+        item_count,
+        std::min( max_chunks, static_cast< std::size_t >( worker_count_ ) )
+    );
+    auto const chunk_count = divide_round_up( item_count, chunk_size );
+
+    auto const first_pool = static_cast< std::size_t >( frame.frame_index ) * worker_count_;
+
+    auto chunks = std::vector< Chunk >( chunk_count );
+    for ( auto chunk_index = 0UZ; chunk_index < chunk_count; ++chunk_index )
+    {
+        auto& chunk = chunks[ chunk_index ];
+        chunk.first = chunk_index * chunk_size;
+        chunk.last  = std::min( chunk.first + chunk_size, item_count );
+        chunk.pool  = &pools_[ first_pool + chunk_index ];
+    }
+
+    // Each chunk only touches its own pool so the chunks need no further synchronization.
+    std::for_each( std::execution::par, chunks.begin( ), chunks.end( ), [ & ]( Chunk& chunk ) {
+        chunk.command_buffer = this->record_chunk( chunk, inheritance, record_range );
+    } );
+
+    auto secondary_command_buffers = std::vector< vk::CommandBuffer >{ };
+    secondary_command_buffers.reserve( chunks.size( ) );
+
+    for ( auto const& chunk : chunks )
+    {
+        LTB_CHECK( auto const command_buffer, chunk.command_buffer );
+        secondary_command_buffers.push_back( command_buffer );
+    }
+
+    frame.command_buffer.executeCommands( secondary_command_buffers );
+
+    // Executing secondary command buffers leaves the primary's bindings undefined.
+    if ( nullptr != frame.descriptor_bind_state )
+    {
+        frame.descriptor_bind_state->reset( frame.command_buffer );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanParallelRecorder::worker_count( ) const -> uint32
+{
+    return worker_count_;
+}
+
+auto VulkanParallelRecorder::settings( ) const -> VulkanParallelRecorderSettings const&
+{
+    return settings_;
+}
+
+auto VulkanParallelRecorder::record_chunk(
+    Chunk const&                            chunk,
+    vk::CommandBufferInheritanceInfo const& inheritance,
+    RecordRange const&                      record_range
+) -> utils::Result< vk::CommandBuffer >
+{
+    auto& pool = *chunk.pool;
+
+    if ( pool.used == pool.command_buffers.size( ) )
+    {
+        LTB_CHECK( pool.command_buffers.emplace_back( gpu_.device( ), pool.command_pool )
+                       .initialize( { .level = vk::CommandBufferLevel::eSecondary } ) );
+    }
+    auto const& command_buffer = pool.command_buffers[ pool.used ].get( );
+    ++pool.used;
+
+    auto usage = vk::CommandBufferUsageFlags{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit };
+    if ( nullptr != inheritance.renderPass )
+    {
+        usage |= vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+    }
+
+    VK_CHECK( command_buffer.begin(
+        vk::CommandBufferBeginInfo{ }.setFlags( usage ).setPInheritanceInfo( &inheritance )
+    ) );
+
+    LTB_CHECK( record_range( command_buffer, chunk.first, chunk.last ) );
+
+    VK_CHECK( command_buffer.end( ) );
+
+    return command_buffer;
+}
+
+} // namespace ltb::vlk::objs
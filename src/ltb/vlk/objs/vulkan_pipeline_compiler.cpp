@@ -0,0 +1,195 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_pipeline_compiler.hpp"
+
+// project
+#include "ltb/utils/cpu_profiler.hpp"
+#include "ltb/vlk/check.hpp"
+
+// standard
+#include <algorithm>
+
+namespace ltb::vlk::objs
+{
+
+PipelineHandle::PipelineHandle( std::shared_future< utils::Result< void > > result )
+    : result_( std::move( result ) )
+{
+}
+
+auto PipelineHandle::is_valid( ) const -> bool
+{
+    return result_.valid( );
+}
+
+auto PipelineHandle::is_ready( ) const -> bool
+{
+    return this->is_valid( )
+        && ( std::future_status::ready == result_.wait_for( std::chrono::seconds::zero( ) ) );
+}
+
+auto PipelineHandle::wait( ) const -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_valid( ) );
+    return result_.get( );
+}
+
+VulkanPipelineCompiler::VulkanPipelineCompiler( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+VulkanPipelineCompiler::~VulkanPipelineCompiler( )
+{
+    for ( auto& worker : workers_ )
+    {
+        worker.request_stop( );
+    }
+    workers_.clear( );
+
+    // Queued tasks are abandoned. Their handles resolve with an error rather than a broken
+    // promise so `PipelineHandle::wait` never throws.
+    constexpr auto abandoned = true;
+    for ( auto& task : tasks_ )
+    {
+        task( abandoned );
+    }
+    tasks_.clear( );
+}
+
+auto VulkanPipelineCompiler::initialize( VulkanPipelineCompilerSettings const settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+
+    auto const worker_count = ( settings.worker_count > 0U )
+                                ? settings.worker_count
+                                : std::max( std::thread::hardware_concurrency( ), 1U );
+
+    workers_.reserve( worker_count );
+    for ( auto worker_index = 0U; worker_index < worker_count; ++worker_index )
+    {
+        workers_.emplace_back( [ this ]( std::stop_token const& stop_token ) {
+            this->run_worker( stop_token );
+        } );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanPipelineCompiler::is_initialized( ) const -> bool
+{
+    return !workers_.empty( );
+}
+
+auto VulkanPipelineCompiler::submit(
+    VulkanGraphicsPipeline&        pipeline,
+    VulkanGraphicsPipelineSettings settings
+) -> utils::Result< PipelineHandle >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    LTB_CHECK( auto pipeline_settings, pipeline.initialize_layouts( std::move( settings ) ) );
+
+    return this->enqueue(
+        [ &pipeline, pipeline_settings = std::move( pipeline_settings ) ]( ) mutable {
+            LTB_PROFILE_ZONE( "Compile graphics pipeline" );
+            return pipeline.compile( std::move( pipeline_settings ) );
+        }
+    );
+}
+
+auto VulkanPipelineCompiler::submit(
+    VulkanComputePipeline&        pipeline,
+    VulkanComputePipelineSettings settings
+) -> utils::Result< PipelineHandle >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    LTB_CHECK( pipeline.initialize_layouts( std::move( settings ) ) );
+
+    return this->enqueue( [ &pipeline ] {
+        LTB_PROFILE_ZONE( "Compile compute pipeline" );
+        return pipeline.compile( );
+    } );
+}
+
+auto VulkanPipelineCompiler::wait_all( ) -> utils::Result< void >
+{
+    auto submitted = std::vector< PipelineHandle >{ };
+    {
+        auto const lock = std::scoped_lock{ mutex_ };
+        submitted.swap( submitted_ );
+    }
+
+    // Every pipeline is waited on, even after an error, so none are still compiling when
+    // this returns.
+    auto result = utils::success( );
+    for ( auto const& handle : submitted )
+    {
+        if ( auto handle_result = handle.wait( ); ( !handle_result ) && result )
+        {
+            result = std::move( handle_result );
+        }
+    }
+    return result;
+}
+
+auto VulkanPipelineCompiler::worker_count( ) const -> uint32
+{
+    return static_cast< uint32 >( workers_.size( ) );
+}
+
+auto VulkanPipelineCompiler::enqueue( CompileFunction compile ) -> PipelineHandle
+{
+    auto task = CompileTask{
+        [ compile = std::move( compile ) ]( bool const abandoned ) mutable
+        -> utils::Result< void > {
+            if ( abandoned )
+            {
+                return LTB_MAKE_UNEXPECTED_ERROR(
+                    "The pipeline compiler was destroyed before the pipeline compiled"
+                );
+            }
+            return compile( );
+        },
+    };
+
+    auto handle = PipelineHandle{ task.get_future( ).share( ) };
+    {
+        auto const lock = std::scoped_lock{ mutex_ };
+        tasks_.push_back( std::move( task ) );
+        submitted_.push_back( handle );
+    }
+    task_added_.notify_one( );
+
+    return handle;
+}
+
+auto VulkanPipelineCompiler::run_worker( std::stop_token const& stop_token ) -> void
+{
+    utils::set_cpu_profiler_thread_name( "Pipeline compiler" );
+
+    while ( !stop_token.stop_requested( ) )
+    {
+        auto task = CompileTask{ };
+        {
+            auto lock = std::unique_lock{ mutex_ };
+            if ( !task_added_.wait( lock, stop_token, [ this ] { return !tasks_.empty( ); } ) )
+            {
+                return;
+            }
+            task = std::move( tasks_.front( ) );
+            tasks_.pop_front( );
+        }
+        constexpr auto abandoned = false;
+        task( abandoned );
+    }
+}
+
+} // namespace ltb::vlk::objs
@@ -4,6 +4,7 @@
 #include "ltb/vlk/objs/vulkan_presentation.hpp"
 
 // project
+#include "ltb/utils/cpu_profiler.hpp"
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device.hpp"
 #include "ltb/vlk/device_memory_utils.hpp"
@@ -14,6 +15,9 @@
 // external
 #include <spdlog/spdlog.h>
 
+// standard
+#include <array>
+
 namespace ltb::vlk::objs
 {
 
@@ -28,6 +32,7 @@ auto VulkanPresentation::initialize( VulkanPresentationSettings settings ) -> ut
     {
         return utils::success( );
     }
+    LTB_PROFILE_ZONE( "VulkanPresentation::initialize" );
     LTB_CHECK_VALID( gpu_.is_initialized( ) );
 
     if ( ExtentMode::FromSurface == settings.extent_mode )
@@ -108,8 +113,22 @@ auto VulkanPresentation::begin_render_pass( BeginRenderPassSettings const& setti
                                       .setFramebuffer( framebuffer.get( ) )
                                       .setRenderArea( render_area )
                                       .setClearValues( clear_values );
-    settings.command_buffer.beginRenderPass( render_pass_info, vk::SubpassContents::eInline );
 
+    // Dynamic state set before the pass carries into it, which keeps this valid when
+    // the pass contents are recorded in secondary command buffers.
+    this->set_viewport_and_scissor( settings.command_buffer, settings.viewport, settings.scissor );
+
+    settings.command_buffer.beginRenderPass( render_pass_info, settings.subpass_contents );
+
+    return utils::success( );
+}
+
+auto VulkanPresentation::set_viewport_and_scissor(
+    vk::CommandBuffer const&            command_buffer,
+    std::optional< vk::Viewport > const viewport,
+    std::optional< vk::Rect2D > const   scissor
+) const -> void
+{
     auto const default_viewport
         = vk::Viewport{ }
               .setX( 0.0F )
@@ -119,20 +138,27 @@ auto VulkanPresentation::begin_render_pass( BeginRenderPassSettings const& setti
               .setMinDepth( 0.0F )
               .setMaxDepth( 1.0F );
 
-    auto const     viewport             = settings.viewport.value_or( default_viewport );
-    auto const     viewports            = std::vector{ viewport };
+    auto const     viewports            = std::array{ viewport.value_or( default_viewport ) };
     constexpr auto first_viewport_index = 0UL;
-    settings.command_buffer.setViewport( first_viewport_index, viewports );
+    command_buffer.setViewport( first_viewport_index, viewports );
 
     auto const default_scissor
         = vk::Rect2D{ }.setOffset( { 0, 0 } ).setExtent( swapchain_.settings( ).extent );
 
-    auto const     scissor             = settings.scissor.value_or( default_scissor );
-    auto const     scissors            = std::vector{ scissor };
+    auto const     scissors            = std::array{ scissor.value_or( default_scissor ) };
     constexpr auto first_scissor_index = 0UL;
-    settings.command_buffer.setScissor( first_scissor_index, scissors );
+    command_buffer.setScissor( first_scissor_index, scissors );
+}
 
-    return utils::success( );
+auto VulkanPresentation::inheritance_info( uint32 const image_index ) const
+    -> utils::Result< vk::CommandBufferInheritanceInfo >
+{
+    LTB_CHECK_VALID( image_index < framebuffers_.size( ) );
+
+    return vk::CommandBufferInheritanceInfo{ }
+        .setRenderPass( render_pass_.get( ) )
+        .setSubpass( 0U )
+        .setFramebuffer( framebuffers_[ image_index ].get( ) );
 }
 
 auto VulkanPresentation::swapchain( ) const -> Swapchain const&
@@ -165,14 +191,9 @@ auto VulkanPresentation::depth_image( ) -> Image&
     return d_image_.image( );
 }
 
-auto VulkanPresentation::depth_memory( ) const -> DeviceMemory const&
-{
-    return d_image_.memory( );
-}
-
-auto VulkanPresentation::depth_memory( ) -> DeviceMemory&
+auto VulkanPresentation::depth_allocation( ) const -> DeviceAllocation const&
 {
-    return d_image_.memory( );
+    return d_image_.allocation( );
 }
 
 auto VulkanPresentation::depth_image_view( ) const -> ImageView const&
@@ -249,6 +270,7 @@ auto VulkanPresentation::initialize_swapchain(
         LTB_CHECK( d_image_.initialize( {
             .image             = std::move( image ),
             .memory_properties = vk::MemoryPropertyFlagBits::eDeviceLocal,
+            .tag               = "depth attachment",
         } ) );
 
         LTB_CHECK( depth_image_view_.initialize( {
@@ -0,0 +1,291 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_readback.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/physical_device.hpp"
+
+// standard
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace ltb::vlk::objs
+{
+namespace
+{
+
+// Keeps every copy suitably aligned for whatever type is read out of it.
+constexpr auto copy_alignment = vk::DeviceSize{ 16U };
+
+auto align_up( vk::DeviceSize const value, vk::DeviceSize const alignment ) -> vk::DeviceSize
+{
+    return ( ( value + alignment ) - 1U ) / alignment * alignment;
+}
+
+auto align_down( vk::DeviceSize const value, vk::DeviceSize const alignment ) -> vk::DeviceSize
+{
+    return value / alignment * alignment;
+}
+
+} // namespace
+
+VulkanReadback::VulkanReadback( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanReadback::initialize( VulkanReadbackSettings const settings ) -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.frame_count > 0U );
+    LTB_CHECK_VALID( settings.frame_size > 0U );
+
+    // Cached memory makes CPU reads fast but is usually not coherent,
+    // in which case each range is invalidated before it is read.
+    constexpr auto cached_properties
+        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCached;
+    constexpr auto coherent_properties
+        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+    auto const any_memory_type = vk::MemoryRequirements{ }.setMemoryTypeBits( ~0U );
+    auto const has_cached_memory
+        = gpu_.physical_device( )
+              .find_memory_type_index( { any_memory_type }, cached_properties )
+              .has_value( );
+
+    auto const frame_stride = align_up( settings.frame_size, copy_alignment );
+
+    LTB_CHECK( staging_.initialize( {
+        .layout       = { .total_size = frame_stride * settings.frame_count },
+        .buffer_usage = vk::BufferUsageFlagBits::eTransferDst,
+        .memory_properties  = has_cached_memory ? cached_properties : coherent_properties,
+        .store_mapped_value = true,
+        .tag                = "readback staging",
+    } ) );
+
+    auto const memory_type_index = staging_.allocation( ).memory_type_index;
+    auto const memory_type_flags
+        = gpu_.physical_device( ).get( ).getMemoryProperties( ).memoryTypes[ memory_type_index ]
+              .propertyFlags;
+
+    settings_     = settings;
+    frames_       = std::vector< FrameRegion >( settings.frame_count );
+    frame_stride_ = frame_stride;
+    coherent_     = static_cast< bool >(
+        memory_type_flags & vk::MemoryPropertyFlagBits::eHostCoherent
+    );
+    initialized_ = true;
+
+    return utils::success( );
+}
+
+auto VulkanReadback::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto VulkanReadback::start_frame( FrameInfo const& frame ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( frame.frame_index < frames_.size( ) );
+
+    auto& region          = frames_[ frame.frame_index ];
+    region.fence          = frame.frame_fence;
+    region.timeline       = frame.timeline_semaphore;
+    region.timeline_value = frame.timeline_value;
+    region.used           = 0U;
+    ++region.epoch;
+
+    return utils::success( );
+}
+
+auto VulkanReadback::read(
+    FrameInfo const&     frame,
+    Buffer const&        src_buffer,
+    vk::DeviceSize const src_offset,
+    vk::DeviceSize const size
+) -> utils::Result< ReadbackHandle >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( src_buffer.is_initialized( ) );
+    LTB_CHECK_VALID( frame.frame_index < frames_.size( ) );
+    LTB_CHECK_VALID( size > 0U );
+
+    auto& region = frames_[ frame.frame_index ];
+    LTB_CHECK_VALID( region.fence == frame.frame_fence );
+    LTB_CHECK_VALID( region.timeline_value == frame.timeline_value );
+
+    auto const offset = align_up( region.used, copy_alignment );
+    if ( ( offset + size ) > settings_.frame_size )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Readback frame is full ({} of {} bytes used, {} requested)",
+            region.used,
+            settings_.frame_size,
+            size
+        );
+    }
+    region.used = offset + size;
+
+    auto const dst_offset = ( frame_stride_ * frame.frame_index ) + offset;
+
+    frame.command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::DependencyFlags{ },
+        vk::MemoryBarrier{ }
+            .setSrcAccessMask( vk::AccessFlagBits::eMemoryWrite )
+            .setDstAccessMask( vk::AccessFlagBits::eTransferRead ),
+        { },
+        { }
+    );
+
+    frame.command_buffer.copyBuffer(
+        src_buffer.get( ),
+        staging_.buffer( ).get( ),
+        vk::BufferCopy{ }.setSrcOffset( src_offset ).setDstOffset( dst_offset ).setSize( size )
+    );
+
+    // Make the copy available to the host once the frame's fence has signaled.
+    frame.command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eHost,
+        vk::DependencyFlags{ },
+        vk::MemoryBarrier{ }
+            .setSrcAccessMask( vk::AccessFlagBits::eTransferWrite )
+            .setDstAccessMask( vk::AccessFlagBits::eHostRead ),
+        { },
+        { }
+    );
+
+    return ReadbackHandle{
+        .frame_index = frame.frame_index,
+        .frame_epoch = region.epoch,
+        .offset      = dst_offset,
+        .size        = size,
+    };
+}
+
+auto VulkanReadback::is_ready( ReadbackHandle const& handle ) const -> utils::Result< bool >
+{
+    LTB_CHECK( auto const* const region, this->find_frame( handle ) );
+
+    if ( nullptr != region->timeline )
+    {
+        VK_CHECK(
+            auto const value,
+            gpu_.device( ).get( ).getSemaphoreCounterValue( region->timeline )
+        );
+        return value >= region->timeline_value;
+    }
+
+    auto const status = gpu_.device( ).get( ).getFenceStatus( region->fence );
+    if ( vk::Result::eNotReady == status )
+    {
+        return false;
+    }
+    VK_CHECK( status );
+
+    return true;
+}
+
+auto VulkanReadback::wait( ReadbackHandle const& handle ) const -> utils::Result< void >
+{
+    LTB_CHECK( auto const* const region, this->find_frame( handle ) );
+
+    constexpr auto max_possible_timeout = std::numeric_limits< uint64 >::max( );
+    constexpr auto wait_for_all         = true;
+
+    if ( nullptr != region->timeline )
+    {
+        auto const semaphores = std::array{ region->timeline };
+        auto const values     = std::array{ region->timeline_value };
+        auto const wait_info
+            = vk::SemaphoreWaitInfo{ }.setSemaphores( semaphores ).setValues( values );
+
+        VK_CHECK( gpu_.device( ).get( ).waitSemaphores( wait_info, max_possible_timeout ) );
+
+        return utils::success( );
+    }
+
+    auto const fences = std::array{ region->fence };
+    VK_CHECK( gpu_.device( ).get( ).waitForFences( fences, wait_for_all, max_possible_timeout ) );
+
+    return utils::success( );
+}
+
+auto VulkanReadback::data( ReadbackHandle const& handle ) const
+    -> utils::Result< std::span< uint8 const > >
+{
+    LTB_CHECK( auto const ready, this->is_ready( handle ) );
+    if ( !ready )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Readback from frame {} is not ready yet",
+            handle.frame_index
+        );
+    }
+
+    if ( !coherent_ )
+    {
+        // The allocator keeps non-coherent allocations on whole atoms
+        // so the expanded range never leaves the staging allocation.
+        auto const& allocation = staging_.allocation( );
+        auto const  atom_size  = std::max(
+            gpu_.physical_device( ).properties( ).limits.nonCoherentAtomSize,
+            vk::DeviceSize{ 1U }
+        );
+
+        auto const begin = align_down( allocation.range.offset + handle.offset, atom_size );
+        auto const end   = std::min(
+            align_up( allocation.range.offset + handle.offset + handle.size, atom_size ),
+            allocation.range.offset + allocation.range.size
+        );
+
+        VK_CHECK( gpu_.device( ).get( ).invalidateMappedMemoryRanges(
+            vk::MappedMemoryRange{ }
+                .setMemory( allocation.memory )
+                .setOffset( begin )
+                .setSize( end - begin )
+        ) );
+    }
+
+    return std::span< uint8 const >{ staging_.mapped_data( ) + handle.offset, handle.size };
+}
+
+auto VulkanReadback::settings( ) const -> VulkanReadbackSettings const&
+{
+    return settings_;
+}
+
+auto VulkanReadback::buffer( ) const -> VulkanBuffer const&
+{
+    return staging_;
+}
+
+auto VulkanReadback::find_frame( ReadbackHandle const& handle ) const
+    -> utils::Result< FrameRegion const* >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( handle.frame_index < frames_.size( ) );
+
+    auto const& region = frames_[ handle.frame_index ];
+    if ( region.epoch != handle.frame_epoch )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Readback from frame {} expired when the frame was started again",
+            handle.frame_index
+        );
+    }
+
+    return &region;
+}
+
+} // namespace ltb::vlk::objs
@@ -0,0 +1,369 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_shader_reloader.hpp"
+
+// project
+#include "ltb/utils/cpu_profiler.hpp"
+#include "ltb/utils/ignore.hpp"
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/ltb_vlk_config.hpp"
+
+// external
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/transform.hpp>
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <string_view>
+
+namespace ltb::vlk::objs
+{
+namespace
+{
+
+// The sources compiled by the shader build rules and the files they include.
+constexpr auto shader_extensions = std::array< std::string_view, 6UZ >{
+    ".vert",
+    ".geom",
+    ".tesc",
+    ".tese",
+    ".frag",
+    ".comp",
+};
+constexpr auto include_extension = std::string_view{ ".glsl" };
+
+auto is_shader_source( std::filesystem::path const& path ) -> bool
+{
+    auto const extension = path.extension( ).string( );
+    return std::ranges::find( shader_extensions, extension ) != shader_extensions.end( );
+}
+
+// Matches the output of the shader build rules.
+auto spirv_path( std::filesystem::path const& source ) -> std::filesystem::path
+{
+    auto spirv = source;
+    spirv += ".spv";
+    return spirv.lexically_normal( );
+}
+
+auto normalized_spirv_file( ShaderModule const& shader_module ) -> std::filesystem::path
+{
+    return shader_module.settings( ).spirv_file.lexically_normal( );
+}
+
+} // namespace
+
+VulkanShaderReloader::VulkanShaderReloader( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanShaderReloader::initialize( VulkanShaderReloaderSettings settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+
+    if ( settings.shader_dir.empty( ) )
+    {
+        settings.shader_dir = config::shader_dir_path( );
+    }
+    if ( settings.glslc.empty( ) )
+    {
+        settings.glslc = config::glslc_path( );
+    }
+
+    auto error = std::error_code{ };
+    if ( !std::filesystem::is_directory( settings.shader_dir, error ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Shader directory '{}' not found",
+            settings.shader_dir.string( )
+        );
+    }
+    if ( settings.glslc.empty( ) || !std::filesystem::exists( settings.glslc, error ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "glslc not found at '{}'", settings.glslc.string( ) );
+    }
+
+    settings_ = std::move( settings );
+
+    // Records the current write times so only later edits are compiled.
+    this->poll_sources( );
+
+    watcher_ = std::jthread{ [ this ]( std::stop_token const& stop_token ) {
+        this->run_watcher( stop_token );
+    } };
+    spdlog::info( "Watching '{}' for shader changes", settings_.shader_dir.string( ) );
+
+    return utils::success( );
+}
+
+auto VulkanShaderReloader::is_initialized( ) const -> bool
+{
+    return watcher_.joinable( );
+}
+
+auto VulkanShaderReloader::watch( VulkanComputePipeline& pipeline, QueueType const queue_type )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( pipeline.is_initialized( ) );
+    LTB_CHECK_VALID( gpu_.device( ).queues( ).contains( queue_type ) );
+
+    watched_.push_back( {
+        .spirv_files    = { normalized_spirv_file( pipeline.shader_module( ) ) },
+        .reload_shaders = [ &pipeline ] { return pipeline.reload_shaders( ); },
+        .queue_type     = queue_type,
+    } );
+
+    return utils::success( );
+}
+
+auto VulkanShaderReloader::watch( VulkanGraphicsPipeline& pipeline, QueueType const queue_type )
+    -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( pipeline.is_initialized( ) );
+    LTB_CHECK_VALID( gpu_.device( ).queues( ).contains( queue_type ) );
+
+    watched_.push_back( {
+        .spirv_files = pipeline.shader_modules( )
+                     | ranges::views::transform( normalized_spirv_file )
+                     | ranges::to< std::vector >( ),
+        .reload_shaders = [ &pipeline ] { return pipeline.reload_shaders( ); },
+        .queue_type     = queue_type,
+    } );
+
+    return utils::success( );
+}
+
+auto VulkanShaderReloader::swap_pipelines( ) -> utils::Result< uint32 >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK( this->release_retired( ) );
+
+    auto compiled = std::set< std::filesystem::path >{ };
+    {
+        auto const lock = std::scoped_lock{ mutex_ };
+        compiled.swap( compiled_spirv_ );
+    }
+    if ( compiled.empty( ) )
+    {
+        return 0U;
+    }
+
+    LTB_PROFILE_ZONE( "VulkanShaderReloader::swap_pipelines" );
+
+    auto swapped = 0U;
+    for ( auto const& watched : watched_ )
+    {
+        auto const was_compiled = [ &compiled ]( std::filesystem::path const& spirv_file ) {
+            return compiled.contains( spirv_file );
+        };
+        if ( std::ranges::none_of( watched.spirv_files, was_compiled ) )
+        {
+            continue;
+        }
+
+        // The pipeline keeps running the old shaders when the new ones are rejected.
+        auto old_pipeline = watched.reload_shaders( );
+        if ( !old_pipeline )
+        {
+            spdlog::error(
+                "Pipeline reload failed:\n"
+                "{}",
+                old_pipeline.error( ).debug_error_message( )
+            );
+            continue;
+        }
+
+        LTB_CHECK( this->retire( std::move( old_pipeline.value( ) ), watched.queue_type ) );
+        ++swapped;
+    }
+
+    if ( swapped > 0U )
+    {
+        spdlog::info( "Swapped {} reloaded pipeline(s)", swapped );
+    }
+    return swapped;
+}
+
+auto VulkanShaderReloader::failed_shader_count( ) const -> std::size_t
+{
+    auto const lock = std::scoped_lock{ mutex_ };
+    return failed_shaders_.size( );
+}
+
+auto VulkanShaderReloader::settings( ) const -> VulkanShaderReloaderSettings const&
+{
+    return settings_;
+}
+
+auto VulkanShaderReloader::run_watcher( std::stop_token const& stop_token ) -> void
+{
+    utils::set_cpu_profiler_thread_name( "Shader reloader" );
+
+    while ( !stop_token.stop_requested( ) )
+    {
+        {
+            // Sleeps for the poll interval, waking early only to stop.
+            auto lock = std::unique_lock{ mutex_ };
+            utils::ignore( wake_watcher_.wait_for( lock, stop_token, settings_.poll_interval, [] {
+                return false;
+            } ) );
+        }
+        if ( stop_token.stop_requested( ) )
+        {
+            return;
+        }
+        this->poll_sources( );
+    }
+}
+
+auto VulkanShaderReloader::poll_sources( ) -> void
+{
+    auto all_sources     = std::vector< std::filesystem::path >{ };
+    auto changed_sources = std::vector< std::filesystem::path >{ };
+    auto include_changed = false;
+
+    // Editors replace files while they save, so errors skip entries instead of throwing.
+    auto       error = std::error_code{ };
+    auto const end   = std::filesystem::recursive_directory_iterator{ };
+    for ( auto iter = std::filesystem::recursive_directory_iterator( settings_.shader_dir, error );
+          ( !error ) && ( iter != end );
+          iter.increment( error ) )
+    {
+        auto const& path       = iter->path( );
+        auto const  is_include = ( include_extension == path.extension( ).string( ) );
+        if ( ( !is_include ) && ( !is_shader_source( path ) ) )
+        {
+            continue;
+        }
+
+        auto const write_time = iter->last_write_time( error );
+        if ( error )
+        {
+            error.clear( );
+            continue;
+        }
+
+        if ( !is_include )
+        {
+            all_sources.push_back( path );
+        }
+
+        auto const [ time_iter, inserted ] = write_times_.try_emplace( path, write_time );
+        if ( inserted || ( time_iter->second == write_time ) )
+        {
+            continue;
+        }
+        time_iter->second = write_time;
+
+        if ( is_include )
+        {
+            include_changed = true;
+        }
+        else
+        {
+            changed_sources.push_back( path );
+        }
+    }
+
+    // Dependencies are not tracked, so an edited include recompiles every shader.
+    for ( auto const& source : include_changed ? all_sources : changed_sources )
+    {
+        auto const compiled = this->compile( source );
+
+        auto const lock = std::scoped_lock{ mutex_ };
+        if ( compiled )
+        {
+            compiled_spirv_.insert( spirv_path( source ) );
+            failed_shaders_.erase( source );
+        }
+        else
+        {
+            failed_shaders_.insert( source );
+        }
+    }
+}
+
+auto VulkanShaderReloader::compile( std::filesystem::path const& source ) -> bool
+{
+    LTB_PROFILE_ZONE( "Compile shader" );
+
+    auto const spirv = spirv_path( source );
+    auto       temp  = spirv;
+    temp += ".tmp";
+
+    // glslc prints its own diagnostics. The output is renamed into place once complete so
+    // a pipeline never loads a partially written file.
+    auto const command = fmt::format(
+        "\"{}\" \"{}\" -o \"{}\"",
+        settings_.glslc.string( ),
+        source.string( ),
+        temp.string( )
+    );
+    spdlog::info( "Compiling '{}'", source.string( ) );
+
+    auto error = std::error_code{ };
+    if ( 0 != std::system( command.c_str( ) ) )
+    {
+        spdlog::error( "Failed to compile '{}'", source.string( ) );
+        std::filesystem::remove( temp, error );
+        return false;
+    }
+
+    std::filesystem::rename( temp, spirv, error );
+    if ( error )
+    {
+        spdlog::error( "Failed to replace '{}': {}", spirv.string( ), error.message( ) );
+        return false;
+    }
+    return true;
+}
+
+auto VulkanShaderReloader::retire( vk::UniquePipeline pipeline, QueueType const queue_type )
+    -> utils::Result< void >
+{
+    auto fence = std::make_unique< Fence >( gpu_.device( ) );
+    LTB_CHECK( fence->initialize( { .flags = { } } ) );
+
+    // An empty submission signals its fence once every earlier submission to the queue
+    // has completed, which includes every use of the old pipeline.
+    auto const& queue = gpu_.device( ).queues( ).at( queue_type );
+    VK_CHECK( queue.submit( { }, fence->get( ) ) );
+
+    retired_.push_back( {
+        .pipeline = std::move( pipeline ),
+        .fence    = std::move( fence ),
+    } );
+
+    return utils::success( );
+}
+
+auto VulkanShaderReloader::release_retired( ) -> utils::Result< void >
+{
+    for ( auto iter = retired_.begin( ); iter != retired_.end( ); )
+    {
+        auto const status = gpu_.device( ).get( ).getFenceStatus( iter->fence->get( ) );
+        if ( vk::Result::eNotReady == status )
+        {
+            ++iter;
+            continue;
+        }
+        VK_CHECK( status );
+        iter = retired_.erase( iter );
+    }
+
+    return utils::success( );
+}
+
+} // namespace ltb::vlk::objs
@@ -0,0 +1,123 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_submit_batch.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+
+// standard
+#include <algorithm>
+
+namespace ltb::vlk::objs
+{
+
+VulkanSubmitBatch::VulkanSubmitBatch( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanSubmitBatch::initialize( VulkanSubmitBatchSettings const settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( gpu_.device( ).queues( ).contains( settings.queue_type ) );
+
+    settings_    = settings;
+    queue_       = gpu_.device( ).queues( ).at( settings.queue_type );
+    initialized_ = true;
+
+    return utils::success( );
+}
+
+auto VulkanSubmitBatch::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto VulkanSubmitBatch::add( PendingSubmit submit, vk::Fence const fence ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    if ( nullptr != fence )
+    {
+        if ( nullptr != fence_ )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "A submit batch can only signal one fence. Use timeline semaphores or flush "
+                "before adding another fenced submission"
+            );
+        }
+        fence_ = fence;
+    }
+
+    pending_.push_back( std::move( submit ) );
+
+    return utils::success( );
+}
+
+auto VulkanSubmitBatch::flush( ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    if ( pending_.empty( ) )
+    {
+        return utils::success( );
+    }
+
+    auto submit_infos = std::vector< vk::SubmitInfo2 >{ };
+    submit_infos.reserve( pending_.size( ) );
+
+    for ( auto const& submit : pending_ )
+    {
+        submit_infos.push_back( vk::SubmitInfo2{ }
+                                    .setWaitSemaphoreInfos( submit.waits )
+                                    .setCommandBufferInfos( submit.command_buffers )
+                                    .setSignalSemaphoreInfos( submit.signals ) );
+    }
+
+    VK_CHECK( queue_.submit2( submit_infos, fence_ ) );
+
+    pending_.clear( );
+    fence_ = nullptr;
+
+    return utils::success( );
+}
+
+auto VulkanSubmitBatch::is_pending( vk::Semaphore const semaphore, uint64 const value ) const
+    -> bool
+{
+    if ( 0U == value )
+    {
+        // Every timeline starts at zero.
+        return false;
+    }
+
+    return std::ranges::any_of( pending_, [ semaphore, value ]( PendingSubmit const& submit ) {
+        return std::ranges::any_of( submit.signals, [ semaphore, value ]( auto const& signal ) {
+            return ( signal.semaphore == semaphore ) && ( signal.value >= value );
+        } );
+    } );
+}
+
+auto VulkanSubmitBatch::is_pending( vk::Fence const fence ) const -> bool
+{
+    return ( nullptr != fence ) && ( fence == fence_ );
+}
+
+auto VulkanSubmitBatch::empty( ) const -> bool
+{
+    return pending_.empty( );
+}
+
+auto VulkanSubmitBatch::queue( ) const -> vk::Queue const&
+{
+    return queue_;
+}
+
+} // namespace ltb::vlk::objs
@@ -0,0 +1,134 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_uniform_arena.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/physical_device.hpp"
+
+// standard
+#include <algorithm>
+#include <limits>
+
+namespace ltb::vlk::objs
+{
+namespace
+{
+
+auto align_up( vk::DeviceSize const value, vk::DeviceSize const alignment ) -> vk::DeviceSize
+{
+    return ( ( value + alignment ) - 1U ) / alignment * alignment;
+}
+
+} // namespace
+
+VulkanUniformArena::VulkanUniformArena( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanUniformArena::initialize( VulkanUniformArenaSettings const settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.frame_count > 0U );
+    LTB_CHECK_VALID( settings.frame_size > 0U );
+
+    auto const alignment = std::max(
+        gpu_.physical_device( ).properties( ).limits.minUniformBufferOffsetAlignment,
+        vk::DeviceSize{ 1U }
+    );
+    auto const frame_stride = align_up( settings.frame_size, alignment );
+
+    // Dynamic offsets are 32 bits.
+    LTB_CHECK_VALID(
+        ( frame_stride * settings.frame_count ) <= std::numeric_limits< uint32 >::max( )
+    );
+
+    LTB_CHECK( buffer_.initialize( {
+        .layout       = { .total_size = frame_stride * settings.frame_count },
+        .buffer_usage = vk::BufferUsageFlagBits::eUniformBuffer,
+        .memory_properties
+        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+        .store_mapped_value = true,
+        .tag                = "uniform arena",
+    } ) );
+
+    settings_     = settings;
+    alignment_    = alignment;
+    frame_stride_ = frame_stride;
+    frame_begin_  = 0U;
+    frame_used_   = 0U;
+    initialized_  = true;
+
+    return utils::success( );
+}
+
+auto VulkanUniformArena::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto VulkanUniformArena::start_frame( uint32 const frame_index ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( frame_index < settings_.frame_count );
+
+    frame_begin_ = frame_stride_ * frame_index;
+    frame_used_  = 0U;
+
+    return utils::success( );
+}
+
+auto VulkanUniformArena::allocate( vk::DeviceSize const size ) -> utils::Result< UniformSlice >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( size > 0U );
+
+    auto const offset = align_up( frame_used_, alignment_ );
+    if ( ( offset + size ) > settings_.frame_size )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Uniform arena frame is full ({} of {} bytes used, {} requested)",
+            frame_used_,
+            settings_.frame_size,
+            size
+        );
+    }
+
+    frame_used_ = offset + size;
+
+    auto const buffer_offset = frame_begin_ + offset;
+
+    return UniformSlice{
+        .mapped_data    = buffer_.mapped_data( ) + buffer_offset,
+        .dynamic_offset = static_cast< uint32 >( buffer_offset ),
+        .size           = size,
+    };
+}
+
+auto VulkanUniformArena::descriptor_info( vk::DeviceSize const range ) const
+    -> vk::DescriptorBufferInfo
+{
+    return vk::DescriptorBufferInfo{ }
+        .setBuffer( buffer_.buffer( ).get( ) )
+        .setOffset( 0U )
+        .setRange( range );
+}
+
+auto VulkanUniformArena::settings( ) const -> VulkanUniformArenaSettings const&
+{
+    return settings_;
+}
+
+auto VulkanUniformArena::buffer( ) const -> VulkanBuffer const&
+{
+    return buffer_;
+}
+
+} // namespace ltb::vlk::objs
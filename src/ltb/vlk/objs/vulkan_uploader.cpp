@@ -0,0 +1,721 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_uploader.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+#include "ltb/vlk/physical_device.hpp"
+
+// external
+#include <vulkan/vulkan_format_traits.hpp>
+
+// standard
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace ltb::vlk::objs
+{
+namespace
+{
+
+constexpr auto memory_read_write = vk::AccessFlagBits::eMemoryRead
+                                 | vk::AccessFlagBits::eMemoryWrite;
+
+auto align_up( uint64 const value, uint64 const alignment ) -> uint64
+{
+    return ( ( value + alignment ) - 1U ) / alignment * alignment;
+}
+
+/// \brief The second half of a queue family ownership transfer. The semaphore wait that
+///        precedes these barriers uses the same stage so they are ordered after it.
+auto record_acquire_barriers(
+    vk::CommandBuffer const&                      command_buffer,
+    std::vector< vk::BufferMemoryBarrier > const& buffer_barriers,
+    std::vector< vk::ImageMemoryBarrier > const&  image_barriers
+) -> void
+{
+    command_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::DependencyFlags{ },
+        { },
+        buffer_barriers,
+        image_barriers
+    );
+}
+
+/// \brief Makes the writes done by `src_stages` available to transfer commands that follow.
+auto record_transfer_barrier(
+    vk::CommandBuffer const&     command_buffer,
+    vk::PipelineStageFlags const src_stages,
+    vk::AccessFlags const        src_access
+) -> void
+{
+    command_buffer.pipelineBarrier(
+        src_stages,
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::DependencyFlags{ },
+        vk::MemoryBarrier{ }
+            .setSrcAccessMask( src_access )
+            .setDstAccessMask(
+                vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite
+            ),
+        { },
+        { }
+    );
+}
+
+} // namespace
+
+VulkanUploader::VulkanUploader( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanUploader::initialize( VulkanUploaderSettings const settings ) -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.staging_size > 0U );
+    LTB_CHECK_VALID( settings.max_batches_in_flight > 0U );
+
+    auto const& queues         = gpu_.device( ).queues( );
+    auto const& queue_families = gpu_.physical_device( ).queue_families( );
+    LTB_CHECK_VALID( queues.contains( settings.queue_type ) );
+    LTB_CHECK_VALID( queues.contains( settings.dst_queue_type ) );
+
+    LTB_CHECK( command_pool_.initialize( {
+        .queue_type = settings.queue_type,
+    } ) );
+
+    LTB_CHECK( staging_.initialize( {
+        .layout       = { .total_size = settings.staging_size },
+        .buffer_usage = vk::BufferUsageFlagBits::eTransferSrc,
+        .memory_properties
+        = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+        .store_mapped_value = true,
+        .tag                = "upload staging",
+    } ) );
+
+    command_buffers_.reserve( settings.max_batches_in_flight );
+    fences_.reserve( settings.max_batches_in_flight );
+    semaphores_.reserve( settings.max_batches_in_flight );
+
+    for ( auto batch_index = 0U; batch_index < settings.max_batches_in_flight; ++batch_index )
+    {
+        LTB_CHECK( command_buffers_.emplace_back( gpu_.device( ), command_pool_ ).initialize( ) );
+        LTB_CHECK( fences_.emplace_back( gpu_.device( ) ).initialize( ) );
+        LTB_CHECK( semaphores_.emplace_back( gpu_.device( ) ).initialize( ) );
+    }
+
+    settings_            = settings;
+    queue_               = queues.at( settings.queue_type );
+    dst_queue_           = queues.at( settings.dst_queue_type );
+    queue_family_        = queue_families.at( settings.queue_type );
+    dst_queue_family_    = queue_families.at( settings.dst_queue_type );
+    transfers_ownership_ = ( queue_family_ != dst_queue_family_ );
+    copy_alignment_      = std::max(
+        gpu_.physical_device( ).properties( ).limits.optimalBufferCopyOffsetAlignment,
+        vk::DeviceSize{ 16U }
+    );
+
+    if ( transfers_ownership_ )
+    {
+        LTB_CHECK( dst_command_pool_.initialize( {
+            .queue_type = settings.dst_queue_type,
+        } ) );
+        LTB_CHECK( dst_command_buffer_.initialize( ) );
+        LTB_CHECK( dst_fence_.initialize( ) );
+    }
+
+    initialized_ = true;
+
+    return utils::success( );
+}
+
+auto VulkanUploader::is_initialized( ) const -> bool
+{
+    return initialized_;
+}
+
+auto VulkanUploader::upload(
+    void const* const    data,
+    vk::DeviceSize const size,
+    Buffer const&        dst_buffer,
+    vk::DeviceSize const dst_offset
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( dst_buffer.is_initialized( ) );
+    LTB_CHECK_VALID( ( nullptr != data ) || ( 0U == size ) );
+
+    auto const* const src_data = static_cast< uint8 const* >( data );
+
+    // Anything larger than the ring is streamed through it in ring sized chunks.
+    for ( auto copied = vk::DeviceSize{ 0U }; copied < size; )
+    {
+        auto const chunk_size = std::min( size - copied, settings_.staging_size );
+
+        LTB_CHECK(
+            auto const staging_offset,
+            this->reserve_staging( chunk_size, copy_alignment_ )
+        );
+
+        auto* const staging_data = staging_.mapped_data( ) + staging_offset;
+        LTB_CHECK_VALID(
+            std::memcpy( staging_data, src_data + copied, chunk_size ) == staging_data
+        );
+
+        pending_copies_.push_back( {
+            .dst_buffer = dst_buffer.get( ),
+            .region     = vk::BufferCopy{ }
+                          .setSrcOffset( staging_offset )
+                          .setDstOffset( dst_offset + copied )
+                          .setSize( chunk_size ),
+        } );
+
+        copied += chunk_size;
+    }
+
+    return utils::success( );
+}
+
+auto VulkanUploader::upload(
+    void const* const     data,
+    vk::DeviceSize const  size,
+    Image const&          dst_image,
+    vk::ImageLayout const final_layout
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( dst_image.is_initialized( ) );
+    LTB_CHECK_VALID( nullptr != data );
+    LTB_CHECK_VALID( size > 0U );
+
+    // Image copies address texel rows so they are never split across the ring.
+    LTB_CHECK_VALID( size <= settings_.staging_size );
+
+    auto const& image_settings = dst_image.settings( );
+
+    auto const texel_size = vk::DeviceSize{ vk::blockSize( image_settings.format ) };
+    LTB_CHECK_VALID( texel_size > 0U );
+
+    LTB_CHECK(
+        auto const staging_offset,
+        this->reserve_staging( size, std::lcm( copy_alignment_, texel_size ) )
+    );
+
+    auto* const staging_data = staging_.mapped_data( ) + staging_offset;
+    LTB_CHECK_VALID( std::memcpy( staging_data, data, size ) == staging_data );
+
+    constexpr auto aspect     = vk::ImageAspectFlagBits::eColor;
+    constexpr auto mip_level  = 0U;
+    constexpr auto base_layer = 0U;
+
+    pending_image_copies_.push_back( {
+        .dst_image = dst_image.get( ),
+        .region    = vk::BufferImageCopy{ }
+                      .setBufferOffset( staging_offset )
+                      .setImageSubresource( vk::ImageSubresourceLayers{ }
+                                                .setAspectMask( aspect )
+                                                .setMipLevel( mip_level )
+                                                .setBaseArrayLayer( base_layer )
+                                                .setLayerCount( image_settings.array_layers ) )
+                      .setImageExtent( image_settings.extent ),
+        .range = vk::ImageSubresourceRange{ }
+                     .setAspectMask( aspect )
+                     .setBaseMipLevel( mip_level )
+                     .setLevelCount( 1U )
+                     .setBaseArrayLayer( base_layer )
+                     .setLayerCount( image_settings.array_layers ),
+        .final_layout = final_layout,
+    } );
+
+    return utils::success( );
+}
+
+auto VulkanUploader::copy(
+    Buffer const&        src_buffer,
+    vk::DeviceSize const src_offset,
+    Buffer const&        dst_buffer,
+    vk::DeviceSize const dst_offset,
+    vk::DeviceSize const size
+) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( !transfers_ownership_ );
+    LTB_CHECK_VALID( src_buffer.is_initialized( ) );
+    LTB_CHECK_VALID( dst_buffer.is_initialized( ) );
+
+    pending_copies_.push_back( {
+        .src_buffer = src_buffer.get( ),
+        .dst_buffer = dst_buffer.get( ),
+        .region     = vk::BufferCopy{ }
+                      .setSrcOffset( src_offset )
+                      .setDstOffset( dst_offset )
+                      .setSize( size ),
+    } );
+
+    return utils::success( );
+}
+
+auto VulkanUploader::flush( ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    if ( pending_copies_.empty( ) && pending_image_copies_.empty( ) )
+    {
+        return utils::success( );
+    }
+
+    LTB_CHECK( this->retire_completed_batches( ) );
+
+    if ( in_flight_batches_.size( ) >= settings_.max_batches_in_flight )
+    {
+        LTB_CHECK( this->retire_oldest_batch( ) );
+    }
+    if ( unacquired_batches_.size( ) >= settings_.max_batches_in_flight )
+    {
+        // The caller has not acquired the oldest batch yet so its semaphore is still
+        // signaled. Acquire everything here rather than reusing it.
+        LTB_CHECK( this->acquire_on_dst_queue( ) );
+    }
+
+    // Batches are retired in submission order so the next slot is always free here.
+    auto const  batch_index    = next_batch_;
+    auto const& command_buffer = command_buffers_[ batch_index ].get( );
+    auto const& fence          = fences_[ batch_index ].get( );
+    auto const& semaphore      = semaphores_[ batch_index ].get( );
+
+    constexpr auto reset_flags = vk::CommandBufferResetFlags{ };
+    VK_CHECK( command_buffer.reset( reset_flags ) );
+    VK_CHECK( command_buffer.begin(
+        vk::CommandBufferBeginInfo{ }.setFlags( vk::CommandBufferUsageFlagBits::eOneTimeSubmit )
+    ) );
+
+    // Images are written in full so their previous contents can be discarded.
+    auto to_transfer_dst = std::vector< vk::ImageMemoryBarrier >{ };
+    for ( auto const& copy : pending_image_copies_ )
+    {
+        to_transfer_dst.push_back( vk::ImageMemoryBarrier{ }
+                                       .setDstAccessMask( vk::AccessFlagBits::eTransferWrite )
+                                       .setOldLayout( vk::ImageLayout::eUndefined )
+                                       .setNewLayout( vk::ImageLayout::eTransferDstOptimal )
+                                       .setSrcQueueFamilyIndex( vk::QueueFamilyIgnored )
+                                       .setDstQueueFamilyIndex( vk::QueueFamilyIgnored )
+                                       .setImage( copy.dst_image )
+                                       .setSubresourceRange( copy.range ) );
+    }
+    if ( !to_transfer_dst.empty( ) )
+    {
+        command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTopOfPipe,
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::DependencyFlags{ },
+            { },
+            { },
+            to_transfer_dst
+        );
+    }
+
+    auto const is_device_copy = []( PendingCopy const& copy ) {
+        return nullptr != copy.src_buffer;
+    };
+
+    if ( std::ranges::any_of( pending_copies_, is_device_copy ) )
+    {
+        // Device copies read buffers that earlier work on this queue may still be
+        // writing. Waiting on it here also means that work is finished once this
+        // batch's fence signals.
+        record_transfer_barrier(
+            command_buffer,
+            vk::PipelineStageFlagBits::eAllCommands,
+            vk::AccessFlagBits::eMemoryWrite
+        );
+    }
+
+    // Consecutive copies between the same buffers are recorded as one command.
+    auto regions = std::vector< vk::BufferCopy >{ };
+    for ( auto i = 0UZ; i < pending_copies_.size( ); ++i )
+    {
+        auto const& copy = pending_copies_[ i ];
+        if ( copy.region.size > 0U )
+        {
+            regions.push_back( copy.region );
+        }
+
+        auto const is_last = ( ( i + 1UZ ) == pending_copies_.size( ) );
+        if ( is_last
+             || ( pending_copies_[ i + 1UZ ].src_buffer != copy.src_buffer )
+             || ( pending_copies_[ i + 1UZ ].dst_buffer != copy.dst_buffer ) )
+        {
+            auto const src_buffer
+                = is_device_copy( copy ) ? copy.src_buffer : staging_.buffer( ).get( );
+
+            if ( !regions.empty( ) )
+            {
+                command_buffer.copyBuffer( src_buffer, copy.dst_buffer, regions );
+                regions.clear( );
+            }
+            // A device copy may read what earlier copies in this batch wrote (e.g. a
+            // staged write followed by growing the buffer), and later copies may
+            // overwrite what a device copy read or wrote.
+            if ( ( !is_last )
+                 && ( is_device_copy( copy ) || is_device_copy( pending_copies_[ i + 1UZ ] ) ) )
+            {
+                record_transfer_barrier(
+                    command_buffer,
+                    vk::PipelineStageFlagBits::eTransfer,
+                    vk::AccessFlagBits::eTransferWrite
+                );
+            }
+        }
+    }
+
+    for ( auto const& copy : pending_image_copies_ )
+    {
+        command_buffer.copyBufferToImage(
+            staging_.buffer( ).get( ),
+            copy.dst_image,
+            vk::ImageLayout::eTransferDstOptimal,
+            copy.region
+        );
+    }
+
+    auto batch = UnacquiredBatch{ .batch_index = batch_index };
+
+    if ( transfers_ownership_ )
+    {
+        // Release ownership to the destination family. The matching acquire barriers are
+        // recorded on the destination queue once the batch's semaphore is waited on.
+        auto release_buffers = std::vector< vk::BufferMemoryBarrier >{ };
+        auto release_images  = std::vector< vk::ImageMemoryBarrier >{ };
+
+        for ( auto const& copy : pending_copies_ )
+        {
+            auto const barrier = vk::BufferMemoryBarrier{ }
+                                     .setSrcQueueFamilyIndex( queue_family_ )
+                                     .setDstQueueFamilyIndex( dst_queue_family_ )
+                                     .setBuffer( copy.dst_buffer )
+                                     .setOffset( copy.region.dstOffset )
+                                     .setSize( copy.region.size );
+
+            release_buffers.push_back(
+                vk::BufferMemoryBarrier{ barrier }.setSrcAccessMask(
+                    vk::AccessFlagBits::eTransferWrite
+                )
+            );
+            batch.buffer_barriers.push_back(
+                vk::BufferMemoryBarrier{ barrier }.setDstAccessMask( memory_read_write )
+            );
+        }
+
+        for ( auto const& copy : pending_image_copies_ )
+        {
+            auto const barrier = vk::ImageMemoryBarrier{ }
+                                     .setOldLayout( vk::ImageLayout::eTransferDstOptimal )
+                                     .setNewLayout( copy.final_layout )
+                                     .setSrcQueueFamilyIndex( queue_family_ )
+                                     .setDstQueueFamilyIndex( dst_queue_family_ )
+                                     .setImage( copy.dst_image )
+                                     .setSubresourceRange( copy.range );
+
+            release_images.push_back(
+                vk::ImageMemoryBarrier{ barrier }.setSrcAccessMask(
+                    vk::AccessFlagBits::eTransferWrite
+                )
+            );
+            batch.image_barriers.push_back(
+                vk::ImageMemoryBarrier{ barrier }.setDstAccessMask( memory_read_write )
+            );
+        }
+
+        command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eBottomOfPipe,
+            vk::DependencyFlags{ },
+            { },
+            release_buffers,
+            release_images
+        );
+    }
+    else
+    {
+        // Make the copies visible to everything submitted to this queue afterwards.
+        auto const barrier = vk::MemoryBarrier{ }
+                                 .setSrcAccessMask( vk::AccessFlagBits::eTransferWrite )
+                                 .setDstAccessMask( memory_read_write );
+
+        auto to_final_layout = std::vector< vk::ImageMemoryBarrier >{ };
+        for ( auto const& copy : pending_image_copies_ )
+        {
+            to_final_layout.push_back( vk::ImageMemoryBarrier{ }
+                                           .setSrcAccessMask( vk::AccessFlagBits::eTransferWrite )
+                                           .setDstAccessMask( memory_read_write )
+                                           .setOldLayout( vk::ImageLayout::eTransferDstOptimal )
+                                           .setNewLayout( copy.final_layout )
+                                           .setSrcQueueFamilyIndex( vk::QueueFamilyIgnored )
+                                           .setDstQueueFamilyIndex( vk::QueueFamilyIgnored )
+                                           .setImage( copy.dst_image )
+                                           .setSubresourceRange( copy.range ) );
+        }
+
+        command_buffer.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eAllCommands,
+            vk::DependencyFlags{ },
+            barrier,
+            { },
+            to_final_layout
+        );
+    }
+
+    VK_CHECK( command_buffer.end( ) );
+
+    auto submit_info = vk::SubmitInfo{ }.setCommandBuffers( command_buffer );
+    if ( transfers_ownership_ )
+    {
+        submit_info.setSignalSemaphores( semaphore );
+    }
+
+    VK_CHECK( gpu_.device( ).get( ).resetFences( fence ) );
+    VK_CHECK( queue_.submit( submit_info, fence ) );
+
+    in_flight_batches_.push_back( {
+        .batch_index  = batch_index,
+        .submission   = ++submitted_,
+        .ring_release = ring_write_,
+    } );
+    if ( transfers_ownership_ )
+    {
+        unacquired_batches_.push_back( std::move( batch ) );
+    }
+    next_batch_ = ( next_batch_ + 1U ) % settings_.max_batches_in_flight;
+    pending_copies_.clear( );
+    pending_image_copies_.clear( );
+
+    return utils::success( );
+}
+
+auto VulkanUploader::acquire( vk::CommandBuffer const& command_buffer )
+    -> utils::Result< std::vector< SemaphoreAndStage > >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    auto wait_semaphores = std::vector< SemaphoreAndStage >{ };
+
+    while ( !unacquired_batches_.empty( ) )
+    {
+        auto const& batch = unacquired_batches_.front( );
+
+        // The fence and semaphore are signaled together when the batch completes.
+        auto const status
+            = gpu_.device( ).get( ).getFenceStatus( fences_[ batch.batch_index ].get( ) );
+        if ( vk::Result::eNotReady == status )
+        {
+            break;
+        }
+        VK_CHECK( status );
+
+        record_acquire_barriers( command_buffer, batch.buffer_barriers, batch.image_barriers );
+        wait_semaphores.push_back( {
+            .semaphore = semaphores_[ batch.batch_index ].get( ),
+            .stage     = vk::PipelineStageFlagBits::eAllCommands,
+        } );
+
+        unacquired_batches_.pop_front( );
+    }
+
+    return wait_semaphores;
+}
+
+auto VulkanUploader::wait( ) -> utils::Result< void >
+{
+    LTB_CHECK( this->flush( ) );
+    LTB_CHECK( this->acquire_on_dst_queue( ) );
+
+    while ( !in_flight_batches_.empty( ) )
+    {
+        LTB_CHECK( this->retire_oldest_batch( ) );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanUploader::transfers_ownership( ) const -> bool
+{
+    return transfers_ownership_;
+}
+
+auto VulkanUploader::pending_submission( ) const -> uint64
+{
+    return submitted_ + 1U;
+}
+
+auto VulkanUploader::is_complete( uint64 const submission ) -> utils::Result< bool >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK( this->retire_completed_batches( ) );
+
+    return submission <= completed_;
+}
+
+auto VulkanUploader::settings( ) const -> VulkanUploaderSettings const&
+{
+    return settings_;
+}
+
+auto VulkanUploader::queue( ) const -> vk::Queue const&
+{
+    return queue_;
+}
+
+auto VulkanUploader::dst_queue( ) const -> vk::Queue const&
+{
+    return dst_queue_;
+}
+
+auto VulkanUploader::staging( ) const -> VulkanBuffer const&
+{
+    return staging_;
+}
+
+auto VulkanUploader::reserve_staging( vk::DeviceSize const size, vk::DeviceSize const alignment )
+    -> utils::Result< vk::DeviceSize >
+{
+    auto const capacity = settings_.staging_size;
+    LTB_CHECK_VALID( size <= capacity );
+
+    while ( true )
+    {
+        if ( ring_write_ == ring_free_ )
+        {
+            // Nothing is in use so start again from the front of the ring.
+            ring_write_ = align_up( ring_write_, capacity );
+            ring_free_  = ring_write_;
+        }
+
+        auto const ring_base = ring_write_ - ( ring_write_ % capacity );
+        auto       start     = align_up( ring_write_ - ring_base, alignment );
+
+        if ( ( start + size ) > capacity )
+        {
+            // Skip the tail so the region stays contiguous.
+            start = capacity;
+        }
+
+        auto const region_end = ring_base + start + size;
+
+        if ( ( region_end - ring_free_ ) <= capacity )
+        {
+            ring_write_ = region_end;
+            return start % capacity;
+        }
+
+        // The ring is full. Wait for the oldest batch to release its region.
+        LTB_CHECK( this->retire_oldest_batch( ) );
+    }
+}
+
+auto VulkanUploader::retire_completed_batches( ) -> utils::Result< void >
+{
+    while ( !in_flight_batches_.empty( ) )
+    {
+        auto const& batch = in_flight_batches_.front( );
+
+        auto const status
+            = gpu_.device( ).get( ).getFenceStatus( fences_[ batch.batch_index ].get( ) );
+        if ( vk::Result::eNotReady == status )
+        {
+            break;
+        }
+        VK_CHECK( status );
+
+        ring_free_ = batch.ring_release;
+        completed_ = batch.submission;
+        in_flight_batches_.pop_front( );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanUploader::retire_oldest_batch( ) -> utils::Result< void >
+{
+    if ( in_flight_batches_.empty( ) )
+    {
+        // Only unsubmitted copies are holding the ring.
+        LTB_CHECK_VALID( !pending_copies_.empty( ) || !pending_image_copies_.empty( ) );
+        LTB_CHECK( this->flush( ) );
+    }
+
+    auto const batch = in_flight_batches_.front( );
+
+    constexpr auto max_possible_timeout = std::numeric_limits< uint64 >::max( );
+    constexpr auto wait_for_all         = true;
+
+    auto const fences = std::array{ fences_[ batch.batch_index ].get( ) };
+    VK_CHECK( gpu_.device( ).get( ).waitForFences( fences, wait_for_all, max_possible_timeout ) );
+
+    ring_free_ = batch.ring_release;
+    completed_ = batch.submission;
+    in_flight_batches_.pop_front( );
+
+    return utils::success( );
+}
+
+auto VulkanUploader::acquire_on_dst_queue( ) -> utils::Result< void >
+{
+    if ( unacquired_batches_.empty( ) )
+    {
+        return utils::success( );
+    }
+
+    auto const& command_buffer = dst_command_buffer_.get( );
+    auto const& fence          = dst_fence_.get( );
+
+    constexpr auto reset_flags = vk::CommandBufferResetFlags{ };
+    VK_CHECK( command_buffer.reset( reset_flags ) );
+    VK_CHECK( command_buffer.begin(
+        vk::CommandBufferBeginInfo{ }.setFlags( vk::CommandBufferUsageFlagBits::eOneTimeSubmit )
+    ) );
+
+    auto wait_semaphores = std::vector< vk::Semaphore >{ };
+    auto wait_stages     = std::vector< vk::PipelineStageFlags >{ };
+
+    for ( auto const& batch : unacquired_batches_ )
+    {
+        record_acquire_barriers( command_buffer, batch.buffer_barriers, batch.image_barriers );
+        wait_semaphores.push_back( semaphores_[ batch.batch_index ].get( ) );
+        wait_stages.emplace_back( vk::PipelineStageFlagBits::eAllCommands );
+    }
+
+    VK_CHECK( command_buffer.end( ) );
+
+    auto const submit_info = vk::SubmitInfo{ }
+                                 .setWaitSemaphores( wait_semaphores )
+                                 .setWaitDstStageMask( wait_stages )
+                                 .setCommandBuffers( command_buffer );
+
+    VK_CHECK( gpu_.device( ).get( ).resetFences( fence ) );
+    VK_CHECK( dst_queue_.submit( submit_info, fence ) );
+
+    constexpr auto max_possible_timeout = std::numeric_limits< uint64 >::max( );
+    constexpr auto wait_for_all         = true;
+
+    auto const fences = std::array{ fence };
+    VK_CHECK( gpu_.device( ).get( ).waitForFences( fences, wait_for_all, max_possible_timeout ) );
+
+    unacquired_batches_.clear( );
+
+    return utils::success( );
+}
+
+} // namespace ltb::vlk::objs
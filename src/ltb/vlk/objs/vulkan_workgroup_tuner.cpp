@@ -0,0 +1,380 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/objs/vulkan_workgroup_tuner.hpp"
+
+// project
+#include "ltb/utils/cpu_profiler.hpp"
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+#include "ltb/vlk/physical_device.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <sstream>
+
+namespace ltb::vlk::objs
+{
+namespace
+{
+
+constexpr auto nanos_per_milli = 1'000'000.0;
+
+constexpr auto begin_query     = 0U;
+constexpr auto end_query       = 1U;
+constexpr auto timestamp_count = 2U;
+
+// The driver version is part of the key because a new driver can change which size wins.
+auto make_device_key( vk::PhysicalDeviceProperties const& properties ) -> std::string
+{
+    return fmt::format(
+        "{} ({:04x}:{:04x}, driver {})",
+        std::string( properties.deviceName ),
+        properties.vendorID,
+        properties.deviceID,
+        properties.driverVersion
+    );
+}
+
+constexpr auto field_separator = '\t';
+
+struct CacheEntry
+{
+    std::string device_key  = { };
+    std::string kernel_name = { };
+    glm::uvec3  size        = { };
+};
+
+// Returns nothing for lines that were edited into a different shape.
+auto parse_cache_line( std::string const& line ) -> std::optional< CacheEntry >
+{
+    auto stream = std::istringstream( line );
+    auto entry  = CacheEntry{ };
+    auto size   = std::string{ };
+    if ( ( !std::getline( stream, entry.device_key, field_separator ) )
+         || ( !std::getline( stream, entry.kernel_name, field_separator ) )
+         || ( !std::getline( stream, size ) ) )
+    {
+        return std::nullopt;
+    }
+
+    auto size_stream = std::istringstream( size );
+    if ( !( size_stream >> entry.size.x >> entry.size.y >> entry.size.z ) )
+    {
+        return std::nullopt;
+    }
+    return entry;
+}
+
+} // namespace
+
+VulkanWorkgroupTuner::VulkanWorkgroupTuner( VulkanGpu& gpu )
+    : gpu_( gpu )
+{
+}
+
+auto VulkanWorkgroupTuner::initialize( VulkanWorkgroupTunerSettings settings )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( gpu_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.iterations > 0U );
+
+    auto const& physical_device = gpu_.physical_device( );
+    LTB_CHECK_VALID( physical_device.queue_families( ).contains( settings.queue_type ) );
+    LTB_CHECK_VALID( gpu_.device( ).queues( ).contains( settings.queue_type ) );
+
+    auto const queue_family      = physical_device.queue_families( ).at( settings.queue_type );
+    auto const family_properties = physical_device.get( ).getQueueFamilyProperties( );
+    LTB_CHECK_VALID( queue_family < family_properties.size( ) );
+
+    // Only the low `timestampValidBits` of each timestamp are meaningful.
+    auto const valid_bits = family_properties[ queue_family ].timestampValidBits;
+    if ( 0U == valid_bits )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Queue family {} does not support timestamps",
+            queue_family
+        );
+    }
+
+    LTB_CHECK( command_pool_.initialize( { .queue_type = settings.queue_type } ) );
+    LTB_CHECK( command_buffer_.initialize( ) );
+    LTB_CHECK( query_pool_.initialize( {
+        .query_type  = vk::QueryType::eTimestamp,
+        .query_count = timestamp_count,
+    } ) );
+    LTB_CHECK( fence_.initialize( ) );
+
+    timestamp_mask_ = ( valid_bits >= 64U ) ? std::numeric_limits< uint64 >::max( )
+                                             : ( ( uint64{ 1U } << valid_bits ) - 1U );
+    ms_per_tick_
+        = static_cast< float64 >( physical_device.properties( ).limits.timestampPeriod )
+        / nanos_per_milli;
+
+    device_key_ = make_device_key( physical_device.properties( ) );
+
+    if ( std::filesystem::exists( settings.cache_file ) )
+    {
+        auto file = std::ifstream( settings.cache_file );
+
+        // Damaged lines are dropped on the next save rather than failing startup.
+        auto invalid_lines = 0UZ;
+        for ( auto line = std::string{ }; std::getline( file, line ); )
+        {
+            if ( line.empty( ) )
+            {
+                continue;
+            }
+            if ( auto entry = parse_cache_line( line ) )
+            {
+                cache_[ std::move( entry->device_key ) ][ std::move( entry->kernel_name ) ]
+                    = entry->size;
+            }
+            else
+            {
+                ++invalid_lines;
+            }
+        }
+
+        if ( invalid_lines > 0UZ )
+        {
+            spdlog::warn(
+                "Ignoring {} invalid lines in workgroup size cache '{}'",
+                invalid_lines,
+                settings.cache_file.string( )
+            );
+        }
+    }
+
+    settings_ = std::move( settings );
+
+    return utils::success( );
+}
+
+auto VulkanWorkgroupTuner::is_initialized( ) const -> bool
+{
+    return fence_.is_initialized( );
+}
+
+auto VulkanWorkgroupTuner::tune(
+    std::string const&               kernel_name,
+    VulkanComputePipeline&           pipeline,
+    std::vector< glm::uvec3 > const& candidates,
+    RecordTuningDispatch const&      record
+) -> utils::Result< glm::uvec3 >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+    LTB_CHECK_VALID( pipeline.is_initialized( ) );
+    LTB_CHECK_VALID( !candidates.empty( ) );
+
+    // The name is written as one field of a cache line.
+    LTB_CHECK_VALID( kernel_name.find_first_of( "\t\n" ) == std::string::npos );
+
+    auto& kernels = cache_[ device_key_ ];
+
+    auto const is_candidate = [ &candidates ]( glm::uvec3 const size ) {
+        return std::ranges::find( candidates, size ) != candidates.end( );
+    };
+
+    auto const cached = kernels.contains( kernel_name )
+                          ? std::optional< glm::uvec3 >{ kernels.at( kernel_name ) }
+                          : std::nullopt;
+    if ( cached && is_candidate( *cached ) )
+    {
+        if ( pipeline.workgroup_size( ) != *cached )
+        {
+            LTB_CHECK( pipeline.set_workgroup_size( *cached ) );
+        }
+        spdlog::debug(
+            "Using cached workgroup size ({}, {}, {}) for '{}'",
+            cached->x,
+            cached->y,
+            cached->z,
+            kernel_name
+        );
+        return *cached;
+    }
+
+    LTB_PROFILE_ZONE( "VulkanWorkgroupTuner::tune" );
+
+    auto best_size = std::optional< glm::uvec3 >{ };
+    auto best_ms   = std::numeric_limits< float64 >::max( );
+
+    for ( auto const& size : candidates )
+    {
+        // The GPU is idle between timed dispatches, so the old pipeline can go right away.
+        if ( auto const old_pipeline = pipeline.set_workgroup_size( size ); !old_pipeline )
+        {
+            spdlog::warn(
+                "Skipping workgroup size ({}, {}, {}) for '{}':\n"
+                "{}",
+                size.x,
+                size.y,
+                size.z,
+                kernel_name,
+                old_pipeline.error( ).debug_error_message( )
+            );
+            continue;
+        }
+
+        // The first run pays for caches and clocks warming up and is not counted.
+        LTB_CHECK( this->time_dispatch( pipeline, record ) );
+
+        auto fastest_ms = std::numeric_limits< float64 >::max( );
+        for ( auto i = 0U; i < settings_.iterations; ++i )
+        {
+            LTB_CHECK( auto const ms, this->time_dispatch( pipeline, record ) );
+            fastest_ms = std::min( fastest_ms, ms );
+        }
+
+        spdlog::debug(
+            "'{}' workgroup size ({}, {}, {}): {:.4f} ms",
+            kernel_name,
+            size.x,
+            size.y,
+            size.z,
+            fastest_ms
+        );
+
+        if ( fastest_ms < best_ms )
+        {
+            best_ms   = fastest_ms;
+            best_size = size;
+        }
+    }
+
+    if ( !best_size )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "No workgroup size candidate is valid for '{}'",
+            kernel_name
+        );
+    }
+
+    if ( pipeline.workgroup_size( ) != *best_size )
+    {
+        LTB_CHECK( pipeline.set_workgroup_size( *best_size ) );
+    }
+    kernels[ kernel_name ] = *best_size;
+
+    spdlog::info(
+        "Tuned '{}' to workgroup size ({}, {}, {}): {:.4f} ms",
+        kernel_name,
+        best_size->x,
+        best_size->y,
+        best_size->z,
+        best_ms
+    );
+    return *best_size;
+}
+
+auto VulkanWorkgroupTuner::save( ) const -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    auto file = std::ofstream( settings_.cache_file );
+    if ( !file.is_open( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Failed to open file '{}'",
+            settings_.cache_file.string( )
+        );
+    }
+    for ( auto const& [ device_key, kernels ] : cache_ )
+    {
+        for ( auto const& [ kernel_name, size ] : kernels )
+        {
+            file << fmt::format(
+                "{}{}{}{}{} {} {}\n",
+                device_key,
+                field_separator,
+                kernel_name,
+                field_separator,
+                size.x,
+                size.y,
+                size.z
+            );
+        }
+    }
+    file.flush( );
+    if ( !file.good( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Failed to write file '{}'",
+            settings_.cache_file.string( )
+        );
+    }
+
+    return utils::success( );
+}
+
+auto VulkanWorkgroupTuner::settings( ) const -> VulkanWorkgroupTunerSettings const&
+{
+    return settings_;
+}
+
+auto VulkanWorkgroupTuner::time_dispatch(
+    VulkanComputePipeline&      pipeline,
+    RecordTuningDispatch const& record
+) -> utils::Result< float64 >
+{
+    auto const& command_buffer = command_buffer_.get( );
+    auto const& query_pool     = query_pool_.get( );
+    auto const& fence          = fence_.get( );
+
+    constexpr auto reset_flags = vk::CommandBufferResetFlags{ };
+    VK_CHECK( command_buffer.reset( reset_flags ) );
+    VK_CHECK( command_buffer.begin(
+        vk::CommandBufferBeginInfo{ }.setFlags( vk::CommandBufferUsageFlagBits::eOneTimeSubmit )
+    ) );
+
+    command_buffer.resetQueryPool( query_pool, begin_query, timestamp_count );
+    command_buffer.writeTimestamp( vk::PipelineStageFlagBits::eTopOfPipe, query_pool, begin_query );
+    LTB_CHECK( record( command_buffer, pipeline ) );
+    command_buffer.writeTimestamp(
+        vk::PipelineStageFlagBits::eBottomOfPipe,
+        query_pool,
+        end_query
+    );
+
+    VK_CHECK( command_buffer.end( ) );
+
+    auto const submit_info = vk::SubmitInfo{ }.setCommandBuffers( command_buffer );
+    auto const& queue      = gpu_.device( ).queues( ).at( settings_.queue_type );
+
+    VK_CHECK( gpu_.device( ).get( ).resetFences( fence ) );
+    VK_CHECK( queue.submit( submit_info, fence ) );
+
+    constexpr auto max_possible_timeout = std::numeric_limits< uint64 >::max( );
+    constexpr auto wait_for_all         = true;
+
+    auto const fences = std::array{ fence };
+    VK_CHECK( gpu_.device( ).get( ).waitForFences( fences, wait_for_all, max_possible_timeout ) );
+
+    auto timestamps = std::array< uint64, timestamp_count >{ };
+    VK_CHECK( gpu_.device( ).get( ).getQueryPoolResults(
+        query_pool,
+        begin_query,
+        timestamp_count,
+        timestamps.size( ) * sizeof( uint64 ),
+        timestamps.data( ),
+        sizeof( uint64 ),
+        vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait
+    ) );
+
+    auto const ticks = ( timestamps[ end_query ] - timestamps[ begin_query ] ) & timestamp_mask_;
+    return static_cast< float64 >( ticks ) * ms_per_tick_;
+}
+
+} // namespace ltb::vlk::objs
@@ -17,7 +17,8 @@
 #include <spdlog/spdlog.h>
 
 // standard
-
+#include <algorithm>
+#include <iterator>
 #include <queue>
 
 namespace ltb::vlk
@@ -25,6 +26,18 @@ namespace ltb::vlk
 namespace
 {
 
+auto supports_bindless( vk::PhysicalDevice const& physical_device ) -> bool
+{
+    auto const features = physical_device.getFeatures2<
+        vk::PhysicalDeviceFeatures2,
+        vk::PhysicalDeviceVulkan12Features >( );
+    auto const& vulkan_12_features = features.get< vk::PhysicalDeviceVulkan12Features >( );
+
+    return std::ranges::all_of( bindless_features, [ &vulkan_12_features ]( auto const feature ) {
+        return static_cast< bool >( vulkan_12_features.*feature );
+    } );
+}
+
 auto find_supported_format(
     vk::PhysicalDevice const&        physical_device,
     std::vector< vk::Format > const& candidates,
@@ -106,8 +119,13 @@ auto PhysicalDevice::initialize( DeviceSettings settings, Surface const* const s
              = detail::CheckExtensionSupport{ extensions }( physical_device )
                    .and_then( detail::AppendSupportedExtensions{ extensions, optional_extensions } )
                    .and_then( detail::CheckFeatureSupport{ settings.device_features } )
+                   .and_then( detail::CheckCoreFeatureSupport{ } )
                    .and_then( detail::CheckSurfaceSupport{ vk_surface } )
-                   .and_then( BuildQueueFamilyMap{ settings.queue_flags, vk_surface } ) )
+                   .and_then( BuildQueueFamilyMap{
+                       settings.queue_flags,
+                       vk_surface,
+                       settings.prefer_async_compute,
+                   } ) )
         {
             sorted_devices.emplace(
                 physical_device,
@@ -145,12 +163,32 @@ auto PhysicalDevice::initialize( DeviceSettings settings, Surface const* const s
         );
     }
 
+    auto const supported_features = selected_device.physical_device.getFeatures( );
+
+    auto device_features = settings.device_features;
+    std::ranges::copy_if(
+        settings.optional_device_features,
+        std::back_inserter( device_features ),
+        [ &supported_features ]( PhysicalDeviceFeature const feature ) {
+            return static_cast< bool >( supported_features.*feature );
+        }
+    );
+
+    auto const has_bindless
+        = settings.bindless && supports_bindless( selected_device.physical_device );
+    if ( settings.bindless && ( !has_bindless ) )
+    {
+        spdlog::warn( "The selected device does not support bindless descriptors" );
+    }
+
     settings_              = std::move( settings );
     physical_device_       = selected_device.physical_device;
     extensions_            = std::move( selected_device.extensions );
+    device_features_       = std::move( device_features );
     properties_            = physical_device_.getProperties( );
     queue_families_        = std::move( selected_device.queue_families );
     unique_queue_families_ = queue_families_ | ranges::views::values | ranges::to< std::set >( );
+    has_bindless_          = has_bindless;
 
     spdlog::info( "Selected device {}", physical_device_.getProperties( ).deviceName );
 
@@ -172,6 +210,21 @@ auto PhysicalDevice::get( ) -> vk::PhysicalDevice&
     return physical_device_;
 }
 
+auto PhysicalDevice::device_features( ) const -> std::vector< PhysicalDeviceFeature > const&
+{
+    return device_features_;
+}
+
+auto PhysicalDevice::has_feature( PhysicalDeviceFeature const feature ) const -> bool
+{
+    return std::ranges::find( device_features_, feature ) != device_features_.end( );
+}
+
+auto PhysicalDevice::has_bindless( ) const -> bool
+{
+    return has_bindless_;
+}
+
 auto PhysicalDevice::properties( ) const -> vk::PhysicalDeviceProperties const&
 {
     return properties_;
@@ -187,6 +240,13 @@ auto PhysicalDevice::extensions( ) const -> std::vector< char const* > const&
     return extensions_;
 }
 
+auto PhysicalDevice::has_extension( std::string_view const extension ) const -> bool
+{
+    return std::ranges::any_of( extensions_, [ extension ]( char const* const name ) {
+        return extension == name;
+    } );
+}
+
 auto PhysicalDevice::queue_families( ) const -> QueueFamilyMap const&
 {
     return queue_families_;
@@ -0,0 +1,209 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/pipeline_cache.hpp"
+
+// project
+#include "ltb/utils/file_utils.hpp"
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+#include "ltb/vlk/physical_device.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+// standard
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+
+namespace ltb::vlk
+{
+namespace
+{
+
+constexpr auto file_magic = uint32{ 0x4C54'4250U }; // "LTBP"
+
+/// \brief Precedes the driver's cache data on disk. The driver's own header does not
+///        include the driver version, so it is recorded here as well.
+struct FileHeader
+{
+    uint32                            magic          = file_magic;
+    uint32                            vendor_id      = 0U;
+    uint32                            device_id      = 0U;
+    uint32                            driver_version = 0U;
+    std::array< uint8, vk::UuidSize > cache_uuid     = { };
+    uint64                            data_size      = 0U;
+};
+
+auto make_file_header( vk::PhysicalDeviceProperties const& properties, uint64 const data_size )
+    -> FileHeader
+{
+    auto header = FileHeader{
+        .vendor_id      = properties.vendorID,
+        .device_id      = properties.deviceID,
+        .driver_version = properties.driverVersion,
+        .data_size      = data_size,
+    };
+    std::ranges::copy( properties.pipelineCacheUUID, header.cache_uuid.begin( ) );
+    return header;
+}
+
+auto matches( FileHeader const& lhs, FileHeader const& rhs ) -> bool
+{
+    return ( lhs.magic == rhs.magic ) && ( lhs.vendor_id == rhs.vendor_id )
+        && ( lhs.device_id == rhs.device_id ) && ( lhs.driver_version == rhs.driver_version )
+        && ( lhs.cache_uuid == rhs.cache_uuid );
+}
+
+} // namespace
+
+PipelineCache::PipelineCache( Device& device )
+    : device_( device )
+{
+}
+
+auto PipelineCache::initialize( PipelineCacheSettings settings ) -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( device_.is_initialized( ) );
+
+    settings_ = std::move( settings );
+
+    auto const initial_data = this->load_initial_data( );
+
+    auto const pipeline_cache_info = vk::PipelineCacheCreateInfo{ }
+                                         .setInitialDataSize( initial_data.size( ) )
+                                         .setPInitialData( initial_data.data( ) );
+
+    VK_CHECK(
+        auto pipeline_cache,
+        device_.get( ).createPipelineCacheUnique( pipeline_cache_info )
+    );
+    spdlog::debug( "vk::createPipelineCacheUnique()" );
+
+    pipeline_cache_ = std::move( pipeline_cache );
+
+    return utils::success( );
+}
+
+auto PipelineCache::is_initialized( ) const -> bool
+{
+    return nullptr != pipeline_cache_.get( );
+}
+
+auto PipelineCache::save( ) const -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    if ( settings_.file_path.empty( ) )
+    {
+        return utils::success( );
+    }
+
+    VK_CHECK( auto const data, device_.get( ).getPipelineCacheData( pipeline_cache_.get( ) ) );
+
+    auto const header
+        = make_file_header( device_.physical_device( ).properties( ), data.size( ) );
+
+    // Write next to the cache and swap it in so an interrupted save never leaves a
+    // truncated file behind.
+    auto temp_path = settings_.file_path;
+    temp_path += ".tmp";
+    {
+        auto file = std::ofstream( temp_path, std::ios::binary | std::ios::trunc );
+        if ( !file.is_open( ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR( "Failed to open file '{}'", temp_path.string( ) );
+        }
+        file.write( reinterpret_cast< char const* >( &header ), sizeof( header ) );
+        file.write(
+            reinterpret_cast< char const* >( data.data( ) ),
+            static_cast< std::streamsize >( data.size( ) )
+        );
+        if ( !file.good( ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR( "Failed to write file '{}'", temp_path.string( ) );
+        }
+    }
+
+    auto error = std::error_code{ };
+    std::filesystem::rename( temp_path, settings_.file_path, error );
+    if ( error )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "Failed to replace '{}': {}",
+            settings_.file_path.string( ),
+            error.message( )
+        );
+    }
+    spdlog::debug(
+        "Saved {} byte pipeline cache to '{}'",
+        data.size( ),
+        settings_.file_path.string( )
+    );
+
+    return utils::success( );
+}
+
+auto PipelineCache::get( ) const -> vk::PipelineCache const&
+{
+    return pipeline_cache_.get( );
+}
+
+auto PipelineCache::get( ) -> vk::PipelineCache&
+{
+    return pipeline_cache_.get( );
+}
+
+auto PipelineCache::settings( ) const -> PipelineCacheSettings const&
+{
+    return settings_;
+}
+
+auto PipelineCache::load_initial_data( ) const -> std::vector< uint8 >
+{
+    if ( settings_.file_path.empty( ) || ( !std::filesystem::exists( settings_.file_path ) ) )
+    {
+        return { };
+    }
+
+    auto contents = utils::get_binary_file_contents< uint8 >( settings_.file_path );
+    if ( !contents )
+    {
+        spdlog::warn( contents.error( ).debug_error_message( ) );
+        return { };
+    }
+
+    // A stale cache is expected after a driver update, so it is quietly discarded.
+    auto header = FileHeader{ };
+    if ( contents->size( ) < sizeof( header ) )
+    {
+        return { };
+    }
+    std::memcpy( &header, contents->data( ), sizeof( header ) );
+
+    auto const expected
+        = make_file_header( device_.physical_device( ).properties( ), header.data_size );
+    if ( ( !matches( header, expected ) )
+         || ( header.data_size != ( contents->size( ) - sizeof( header ) ) ) )
+    {
+        spdlog::info(
+            "Ignoring pipeline cache '{}' made by another device or driver",
+            settings_.file_path.string( )
+        );
+        return { };
+    }
+
+    contents->erase(
+        contents->begin( ),
+        contents->begin( ) + static_cast< std::ptrdiff_t >( sizeof( header ) )
+    );
+    return std::move( contents.value( ) );
+}
+
+} // namespace ltb::vlk
@@ -6,6 +6,7 @@
 // project
 #include "ltb/vlk/check.hpp"
 #include "ltb/vlk/device.hpp"
+#include "ltb/vlk/object_cache.hpp"
 
 // external
 #include <spdlog/spdlog.h>
@@ -36,24 +37,42 @@ auto PipelineLayout::initialize( PipelineLayoutSettings settings ) -> utils::Res
     spdlog::debug( "vk::createPipelineLayout()" );
 
     settings_        = std::move( settings );
-    pipeline_layout_ = std::move( pipeline_layout );
+    pipeline_layout_ = pipeline_layout.get( );
+    owned_layout_    = std::move( pipeline_layout );
+
+    return utils::success( );
+}
+
+auto PipelineLayout::initialize( PipelineLayoutSettings settings, ObjectCache& cache )
+    -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( cache.is_initialized( ) );
+
+    LTB_CHECK( auto const pipeline_layout, cache.pipeline_layout( settings ) );
+
+    settings_        = std::move( settings );
+    pipeline_layout_ = pipeline_layout;
 
     return utils::success( );
 }
 
 auto PipelineLayout::is_initialized( ) const -> bool
 {
-    return nullptr != pipeline_layout_.get( );
+    return nullptr != pipeline_layout_;
 }
 
 auto PipelineLayout::get( ) const -> vk::PipelineLayout const&
 {
-    return pipeline_layout_.get( );
+    return pipeline_layout_;
 }
 
 auto PipelineLayout::get( ) -> vk::PipelineLayout&
 {
-    return pipeline_layout_.get( );
+    return pipeline_layout_;
 }
 
 } // namespace ltb::vlk
@@ -0,0 +1,67 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/query_pool.hpp"
+
+// project
+#include "ltb/vlk/check.hpp"
+#include "ltb/vlk/device.hpp"
+
+// external
+#include <spdlog/spdlog.h>
+
+namespace ltb::vlk
+{
+
+QueryPool::QueryPool( Device& device )
+    : device_( device )
+{
+}
+
+auto QueryPool::initialize( QueryPoolSettings const settings ) -> utils::Result< void >
+{
+    if ( this->is_initialized( ) )
+    {
+        return utils::success( );
+    }
+    LTB_CHECK_VALID( device_.is_initialized( ) );
+    LTB_CHECK_VALID( settings.query_count > 0U );
+
+    auto const query_pool_info = vk::QueryPoolCreateInfo{ }
+                                     .setQueryType( settings.query_type )
+                                     .setQueryCount( settings.query_count )
+                                     .setPipelineStatistics( settings.pipeline_statistics );
+
+    VK_CHECK( auto query_pool, device_.get( ).createQueryPoolUnique( query_pool_info ) );
+    spdlog::debug( "vk::createQueryPoolUnique()" );
+
+    // Queries must be reset before their first use.
+    device_.get( ).resetQueryPool( query_pool.get( ), 0U, settings.query_count );
+
+    settings_   = settings;
+    query_pool_ = std::move( query_pool );
+
+    return utils::success( );
+}
+
+auto QueryPool::is_initialized( ) const -> bool
+{
+    return nullptr != query_pool_.get( );
+}
+
+auto QueryPool::settings( ) const -> QueryPoolSettings const&
+{
+    return settings_;
+}
+
+auto QueryPool::get( ) const -> vk::QueryPool const&
+{
+    return query_pool_.get( );
+}
+
+auto QueryPool::get( ) -> vk::QueryPool&
+{
+    return query_pool_.get( );
+}
+
+} // namespace ltb::vlk
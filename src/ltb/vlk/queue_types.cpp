@@ -14,6 +14,9 @@
 #include <range/v3/view/transform.hpp>
 #include <spdlog/spdlog.h>
 
+// standard
+#include <optional>
+
 namespace ltb::vlk
 {
 namespace
@@ -48,6 +51,57 @@ auto all_queue_families_present(
     return queue_families;
 }
 
+/// \brief Prefers a family without graphics or compute support so transfers can run
+///        alongside rendering. Graphics and compute families implicitly support
+///        transfers so the first of those is used as a fallback.
+auto find_transfer_queue_family( std::vector< vk::QueueFamilyProperties > const& queue_families )
+    -> utils::Result< QueueIndex >
+{
+    constexpr auto graphics_or_compute = vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute;
+
+    auto fallback = std::optional< QueueIndex >{ };
+
+    auto const queue_family_count = queue_families.size( );
+    for ( auto i = QueueIndex{ 0 }; i < queue_family_count; ++i )
+    {
+        auto const queue_flags = queue_families[ i ].queueFlags;
+
+        if ( queue_flags & graphics_or_compute )
+        {
+            fallback = fallback.value_or( i );
+        }
+        else if ( queue_flags & vk::QueueFlagBits::eTransfer )
+        {
+            return i;
+        }
+    }
+
+    if ( !fallback.has_value( ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "No queue family supports transfers" );
+    }
+    return fallback.value( );
+}
+
+/// \brief The first family that supports compute but not graphics, if any.
+auto find_async_compute_queue_family(
+    std::vector< vk::QueueFamilyProperties > const& queue_families
+) -> std::optional< QueueIndex >
+{
+    auto const queue_family_count = queue_families.size( );
+    for ( auto i = QueueIndex{ 0 }; i < queue_family_count; ++i )
+    {
+        auto const queue_flags = queue_families[ i ].queueFlags;
+
+        if ( ( queue_flags & vk::QueueFlagBits::eCompute )
+             && !( queue_flags & vk::QueueFlagBits::eGraphics ) )
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
 } // namespace
 
 auto to_queue_type( vk::QueueFlagBits const& queue_type ) -> QueueType
@@ -91,7 +145,8 @@ struct NotUnknownQueueType
 auto build_queue_family_map(
     vk::PhysicalDevice const&               physical_device,
     std::vector< vk::QueueFlagBits > const& types,
-    vk::SurfaceKHR const&                   surface
+    vk::SurfaceKHR const&                   surface,
+    bool const                              prefer_async_compute
 ) -> utils::Result< QueueFamilyMap >
 {
     auto expected_types = types | ranges::views::transform( ToQueueType{ } )
@@ -102,6 +157,9 @@ auto build_queue_family_map(
         expected_types.push_back( QueueType::Surface );
     }
 
+    // The transfer family is chosen separately once everything else has been found.
+    auto const transfer_requested = std::erase( expected_types, QueueType::Transfer ) > 0UZ;
+
     auto       queue_family_map = QueueFamilyMap{ };
     auto const queue_families   = physical_device.getQueueFamilyProperties( );
 
@@ -124,6 +182,10 @@ auto build_queue_family_map(
 
         for ( auto const& type : types )
         {
+            if ( vk::QueueFlagBits::eTransfer == type )
+            {
+                continue;
+            }
             if ( queue_families[ i ].queueFlags & type )
             {
                 queue_family_map[ to_queue_type( type ) ] = i;
@@ -132,6 +194,21 @@ auto build_queue_family_map(
 
         if ( ( result = all_queue_families_present( queue_family_map, expected_types ) ) )
         {
+            if ( transfer_requested )
+            {
+                LTB_CHECK(
+                    result.value( )[ QueueType::Transfer ],
+                    find_transfer_queue_family( queue_families )
+                );
+            }
+            if ( prefer_async_compute && result.value( ).contains( QueueType::Compute ) )
+            {
+                auto const async_family = find_async_compute_queue_family( queue_families );
+                if ( async_family.has_value( ) )
+                {
+                    result.value( )[ QueueType::Compute ] = async_family.value( );
+                }
+            }
             return result;
         }
     }
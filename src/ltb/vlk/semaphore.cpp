@@ -31,7 +31,12 @@ auto Semaphore::initialize( SemaphoreSettings const settings ) -> utils::Result<
     }
     LTB_CHECK_VALID( device_.is_initialized( ) );
 
-    auto const semaphore_info = vk::SemaphoreCreateInfo{ }.setFlags( settings.flags );
+    auto const type_info = vk::SemaphoreTypeCreateInfo{ }
+                               .setSemaphoreType( settings.type )
+                               .setInitialValue( settings.initial_value );
+
+    auto const semaphore_info
+        = vk::SemaphoreCreateInfo{ }.setFlags( settings.flags ).setPNext( &type_info );
 
     VK_CHECK( auto semaphore, device_.get( ).createSemaphoreUnique( semaphore_info ) );
     spdlog::debug( "vk::createSemaphoreUnique()" );
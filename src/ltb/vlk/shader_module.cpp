@@ -12,6 +12,10 @@
 // external
 #include <spdlog/spdlog.h>
 
+// standard
+#include <algorithm>
+#include <vector>
+
 namespace ltb::vlk
 {
 
@@ -27,19 +31,59 @@ auto ShaderModule::initialize( ShaderModuleSettings settings ) -> utils::Result<
         return utils::success( );
     }
     LTB_CHECK_VALID( device_.is_initialized( ) );
+    LTB_CHECK( this->set_specialization_constants( settings.specialization_constants ) );
 
-    LTB_CHECK( auto const code, utils::get_binary_file_contents< uint32 >( settings.spirv_file ) );
+    auto file_code = std::vector< uint32 >{ };
+    auto code      = settings.spirv_code;
+    if ( code.empty( ) )
+    {
+        LTB_CHECK( file_code, utils::get_binary_file_contents< uint32 >( settings.spirv_file ) );
+        code = file_code;
+    }
+    LTB_CHECK( auto reflection, reflect_spirv( code, settings.stage ) );
 
     auto const create_info = vk::ShaderModuleCreateInfo{ }.setCode( code );
     VK_CHECK( auto shader_module, device_.get( ).createShaderModuleUnique( create_info ) );
-    spdlog::debug( "vk::createShaderModuleUnique() for '{}'", settings.spirv_file.string( ) );
+    spdlog::debug(
+        "vk::createShaderModuleUnique() for '{}'{}",
+        settings.spirv_file.string( ),
+        settings.spirv_code.empty( ) ? "" : " (embedded)"
+    );
 
     settings_      = std::move( settings );
+    reflection_    = std::move( reflection );
     shader_module_ = std::move( shader_module );
 
     return utils::success( );
 }
 
+auto ShaderModule::reload( ) -> utils::Result< void >
+{
+    LTB_CHECK_VALID( this->is_initialized( ) );
+
+    LTB_CHECK( auto const code, utils::get_binary_file_contents< uint32 >( settings_.spirv_file ) );
+
+    // The descriptor sets and pipeline layouts built for the old code are reused.
+    LTB_CHECK( auto const reflection, reflect_spirv( code, settings_.stage ) );
+    if ( !reflection.has_same_layout( reflection_ ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR(
+            "'{}' changed its descriptors, push constants or vertex inputs. "
+            "Restart to apply the change.",
+            settings_.spirv_file.string( )
+        );
+    }
+
+    auto const create_info = vk::ShaderModuleCreateInfo{ }.setCode( code );
+    VK_CHECK( auto shader_module, device_.get( ).createShaderModuleUnique( create_info ) );
+    spdlog::debug( "vk::createShaderModuleUnique() for '{}'", settings_.spirv_file.string( ) );
+
+    settings_.spirv_code = { };
+    shader_module_       = std::move( shader_module );
+
+    return utils::success( );
+}
+
 auto ShaderModule::is_initialized( ) const -> bool
 {
     return nullptr != shader_module_.get( );
@@ -60,12 +104,60 @@ auto ShaderModule::settings( ) const -> ShaderModuleSettings const&
     return settings_;
 }
 
+auto ShaderModule::reflection( ) const -> ShaderReflection const&
+{
+    return reflection_;
+}
+
+auto ShaderModule::set_specialization_constants( std::vector< SpecializationConstant > constants )
+    -> utils::Result< void >
+{
+    auto entries = std::vector< vk::SpecializationMapEntry >{ };
+    auto data    = std::vector< uint32 >{ };
+    entries.reserve( constants.size( ) );
+    data.reserve( constants.size( ) );
+
+    for ( auto const& constant : constants )
+    {
+        auto const same_id = [ &constant ]( vk::SpecializationMapEntry const& entry ) {
+            return entry.constantID == constant.constant_id;
+        };
+        if ( std::ranges::any_of( entries, same_id ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Specialization constant {} is set more than once",
+                constant.constant_id
+            );
+        }
+
+        auto const offset = static_cast< uint32 >( data.size( ) * sizeof( uint32 ) );
+        entries.push_back( vk::SpecializationMapEntry{ }
+                               .setConstantID( constant.constant_id )
+                               .setOffset( offset )
+                               .setSize( sizeof( uint32 ) ) );
+        data.push_back( constant.value );
+    }
+
+    settings_.specialization_constants = std::move( constants );
+    specialization_entries_            = std::move( entries );
+    specialization_data_               = std::move( data );
+    specialization_info_               = vk::SpecializationInfo{ }
+                               .setMapEntries( specialization_entries_ )
+                               .setData< uint32 >( specialization_data_ );
+
+    return utils::success( );
+}
+
 auto ShaderModule::get_shader_stage_create_info( ) const -> vk::PipelineShaderStageCreateInfo
 {
+    auto const* const specialization_info
+        = specialization_entries_.empty( ) ? nullptr : &specialization_info_;
+
     return vk::PipelineShaderStageCreateInfo{ }
         .setStage( settings_.stage )
         .setModule( this->get( ) )
-        .setPName( settings_.name );
+        .setPName( settings_.name )
+        .setPSpecializationInfo( specialization_info );
 }
 
 auto GetShaderStageCreateInfo::operator( )( ShaderModule const& shader_module ) const
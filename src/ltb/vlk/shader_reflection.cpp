@@ -0,0 +1,766 @@
+// ///////////////////////////////////////////////////////////////////////////////////////
+// A Logan Thomas Barnes project
+// ///////////////////////////////////////////////////////////////////////////////////////
+#include "ltb/vlk/shader_reflection.hpp"
+
+// standard
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <tuple>
+
+namespace ltb::vlk
+{
+namespace
+{
+
+// The parts of the SPIR-V specification needed to find a shader's interface.
+constexpr auto spirv_magic_number      = 0x07230203U;
+constexpr auto spirv_header_word_count = 5UZ;
+constexpr auto spirv_opcode_mask       = 0xFFFFU;
+constexpr auto spirv_word_count_shift  = 16U;
+
+enum class SpirvOp : uint32
+{
+    TypeInt                   = 21U,
+    TypeFloat                 = 22U,
+    TypeVector                = 23U,
+    TypeMatrix                = 24U,
+    TypeImage                 = 25U,
+    TypeSampler               = 26U,
+    TypeSampledImage          = 27U,
+    TypeArray                 = 28U,
+    TypeRuntimeArray          = 29U,
+    TypeStruct                = 30U,
+    TypePointer               = 32U,
+    Constant                  = 43U,
+    SpecConstant              = 50U,
+    Variable                  = 59U,
+    Decorate                  = 71U,
+    MemberDecorate            = 72U,
+    TypeAccelerationStructure = 5341U,
+};
+
+enum class SpirvDecoration : uint32
+{
+    Block         = 2U,
+    BufferBlock   = 3U,
+    RowMajor      = 4U,
+    ArrayStride   = 6U,
+    MatrixStride  = 7U,
+    BuiltIn       = 11U,
+    Location      = 30U,
+    Binding       = 33U,
+    DescriptorSet = 34U,
+    Offset        = 35U,
+};
+
+enum class SpirvStorageClass : uint32
+{
+    UniformConstant = 0U,
+    Input           = 1U,
+    Uniform         = 2U,
+    PushConstant    = 9U,
+    StorageBuffer   = 12U,
+};
+
+constexpr auto spirv_dim_buffer       = 5U;
+constexpr auto spirv_dim_subpass_data = 6U;
+constexpr auto spirv_image_storage    = 2U;
+
+struct SpirvInstruction
+{
+    SpirvOp                   op       = { };
+    std::span< uint32 const > operands = { };
+};
+
+struct SpirvDecorations
+{
+    std::optional< uint32 > set           = std::nullopt;
+    std::optional< uint32 > binding       = std::nullopt;
+    std::optional< uint32 > location      = std::nullopt;
+    std::optional< uint32 > offset        = std::nullopt;
+    std::optional< uint32 > array_stride  = std::nullopt;
+    std::optional< uint32 > matrix_stride = std::nullopt;
+
+    bool buffer_block = false;
+    bool built_in     = false;
+    bool row_major    = false;
+};
+
+struct SpirvModule
+{
+    // Types and constants by result id.
+    std::map< uint32, SpirvInstruction > types = { };
+
+    std::map< uint32, SpirvDecorations >                      decorations        = { };
+    std::map< std::pair< uint32, uint32 >, SpirvDecorations > member_decorations = { };
+
+    std::vector< SpirvInstruction > variables = { };
+};
+
+// The operands read below for each instruction the reflection looks at.
+auto min_operand_count( SpirvOp const op ) -> std::size_t
+{
+    switch ( op )
+    {
+        case SpirvOp::TypeSampler:
+        case SpirvOp::TypeStruct:
+        case SpirvOp::TypeAccelerationStructure:
+            return 1UZ;
+        case SpirvOp::TypeFloat:
+        case SpirvOp::TypeSampledImage:
+        case SpirvOp::TypeRuntimeArray:
+        case SpirvOp::Decorate:
+            return 2UZ;
+        case SpirvOp::TypeInt:
+        case SpirvOp::TypeVector:
+        case SpirvOp::TypeMatrix:
+        case SpirvOp::TypeArray:
+        case SpirvOp::TypePointer:
+        case SpirvOp::Constant:
+        case SpirvOp::SpecConstant:
+        case SpirvOp::Variable:
+        case SpirvOp::MemberDecorate:
+            return 3UZ;
+        case SpirvOp::TypeImage:
+            return 7UZ;
+    }
+    return 0UZ;
+}
+
+auto decorate(
+    SpirvDecorations&               decorations,
+    SpirvDecoration const           decoration,
+    std::span< uint32 const > const literals
+) -> void
+{
+    auto const literal = [ &literals ] {
+        return literals.empty( ) ? 0U : literals.front( );
+    };
+
+    switch ( decoration )
+    {
+        case SpirvDecoration::Block:
+            break;
+        case SpirvDecoration::BufferBlock:
+            decorations.buffer_block = true;
+            break;
+        case SpirvDecoration::RowMajor:
+            decorations.row_major = true;
+            break;
+        case SpirvDecoration::ArrayStride:
+            decorations.array_stride = literal( );
+            break;
+        case SpirvDecoration::MatrixStride:
+            decorations.matrix_stride = literal( );
+            break;
+        case SpirvDecoration::BuiltIn:
+            decorations.built_in = true;
+            break;
+        case SpirvDecoration::Location:
+            decorations.location = literal( );
+            break;
+        case SpirvDecoration::Binding:
+            decorations.binding = literal( );
+            break;
+        case SpirvDecoration::DescriptorSet:
+            decorations.set = literal( );
+            break;
+        case SpirvDecoration::Offset:
+            decorations.offset = literal( );
+            break;
+    }
+}
+
+auto parse_spirv( std::span< uint32 const > const code ) -> utils::Result< SpirvModule >
+{
+    if ( ( code.size( ) < spirv_header_word_count ) || ( spirv_magic_number != code.front( ) ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "Not a SPIR-V module" );
+    }
+
+    auto spirv = SpirvModule{ };
+
+    for ( auto word = spirv_header_word_count; word < code.size( ); )
+    {
+        auto const word_count = std::size_t{ code[ word ] >> spirv_word_count_shift };
+        if ( ( 0UZ == word_count ) || ( ( word + word_count ) > code.size( ) ) )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR( "Truncated SPIR-V instruction at word {}", word );
+        }
+
+        auto const instruction = SpirvInstruction{
+            .op       = static_cast< SpirvOp >( code[ word ] & spirv_opcode_mask ),
+            .operands = code.subspan( word + 1UZ, word_count - 1UZ ),
+        };
+        word += word_count;
+
+        auto const min_operands = min_operand_count( instruction.op );
+        if ( 0UZ == min_operands )
+        {
+            continue;
+        }
+        if ( instruction.operands.size( ) < min_operands )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "SPIR-V instruction {} is missing operands",
+                static_cast< uint32 >( instruction.op )
+            );
+        }
+
+        auto const& operands = instruction.operands;
+        switch ( instruction.op )
+        {
+            case SpirvOp::Decorate:
+                decorate(
+                    spirv.decorations[ operands[ 0 ] ],
+                    static_cast< SpirvDecoration >( operands[ 1 ] ),
+                    operands.subspan( 2UZ )
+                );
+                break;
+            case SpirvOp::MemberDecorate:
+                decorate(
+                    spirv.member_decorations[ { operands[ 0 ], operands[ 1 ] } ],
+                    static_cast< SpirvDecoration >( operands[ 2 ] ),
+                    operands.subspan( 3UZ )
+                );
+                break;
+            case SpirvOp::Variable:
+                spirv.variables.push_back( instruction );
+                break;
+            case SpirvOp::Constant:
+            case SpirvOp::SpecConstant:
+                // The result id follows the result type.
+                spirv.types[ operands[ 1 ] ] = instruction;
+                break;
+            default:
+                // Every other instruction with operands is a type.
+                spirv.types[ operands[ 0 ] ] = instruction;
+                break;
+        }
+    }
+
+    return spirv;
+}
+
+auto find_type( SpirvModule const& spirv, uint32 const id ) -> utils::Result< SpirvInstruction >
+{
+    auto const iter = spirv.types.find( id );
+    if ( spirv.types.end( ) == iter )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "SPIR-V id {} is not a known type or constant", id );
+    }
+    return iter->second;
+}
+
+auto find_decorations( SpirvModule const& spirv, uint32 const id ) -> SpirvDecorations
+{
+    auto const iter = spirv.decorations.find( id );
+    return ( spirv.decorations.end( ) == iter ) ? SpirvDecorations{ } : iter->second;
+}
+
+auto find_member_decorations( SpirvModule const& spirv, uint32 const id, uint32 const member )
+    -> SpirvDecorations
+{
+    auto const iter = spirv.member_decorations.find( { id, member } );
+    return ( spirv.member_decorations.end( ) == iter ) ? SpirvDecorations{ } : iter->second;
+}
+
+// Array lengths may be specialization constants, in which case the default is used.
+auto constant_value( SpirvModule const& spirv, uint32 const id ) -> utils::Result< uint32 >
+{
+    LTB_CHECK( auto const constant, find_type( spirv, id ) );
+    if ( ( ( SpirvOp::Constant != constant.op ) && ( SpirvOp::SpecConstant != constant.op ) )
+         || ( constant.operands.size( ) < 3UZ ) )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "SPIR-V id {} is not an integer constant", id );
+    }
+    return constant.operands[ 2 ];
+}
+
+// The size a type occupies in a block laid out with explicit offsets and strides.
+auto block_size( SpirvModule const& spirv, uint32 const type_id, SpirvDecorations const& member )
+    -> utils::Result< uint32 >
+{
+    LTB_CHECK( auto const type, find_type( spirv, type_id ) );
+    auto const& operands = type.operands;
+
+    switch ( type.op )
+    {
+        case SpirvOp::TypeInt:
+        case SpirvOp::TypeFloat:
+            return operands[ 1 ] / 8U;
+
+        case SpirvOp::TypeVector:
+        {
+            LTB_CHECK( auto const component_size, block_size( spirv, operands[ 1 ], member ) );
+            return component_size * operands[ 2 ];
+        }
+
+        case SpirvOp::TypeMatrix:
+        {
+            if ( !member.matrix_stride )
+            {
+                return LTB_MAKE_UNEXPECTED_ERROR( "SPIR-V matrix {} has no stride", type_id );
+            }
+            LTB_CHECK( auto const column, find_type( spirv, operands[ 1 ] ) );
+            auto const vectors = member.row_major ? column.operands[ 2 ] : operands[ 2 ];
+            return vectors * member.matrix_stride.value( );
+        }
+
+        case SpirvOp::TypeArray:
+        {
+            auto const stride = find_decorations( spirv, type_id ).array_stride;
+            if ( !stride )
+            {
+                return LTB_MAKE_UNEXPECTED_ERROR( "SPIR-V array {} has no stride", type_id );
+            }
+            LTB_CHECK( auto const length, constant_value( spirv, operands[ 2 ] ) );
+            return length * stride.value( );
+        }
+
+        case SpirvOp::TypeRuntimeArray:
+            return 0U;
+
+        case SpirvOp::TypeStruct:
+        {
+            auto size = 0U;
+            for ( auto index = 1UZ; index < operands.size( ); ++index )
+            {
+                auto const member_index = static_cast< uint32 >( index - 1UZ );
+                auto const decorations  = find_member_decorations( spirv, type_id, member_index );
+                LTB_CHECK(
+                    auto const member_size,
+                    block_size( spirv, operands[ index ], decorations )
+                );
+                size = std::max( size, decorations.offset.value_or( 0U ) + member_size );
+            }
+            return size;
+        }
+
+        default:
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "SPIR-V type {} cannot be used in a push constant block",
+                type_id
+            );
+    }
+}
+
+auto push_constant_range(
+    SpirvModule const&            spirv,
+    uint32 const                  struct_id,
+    vk::ShaderStageFlagBits const stage
+) -> utils::Result< vk::PushConstantRange >
+{
+    LTB_CHECK( auto const type, find_type( spirv, struct_id ) );
+    if ( SpirvOp::TypeStruct != type.op )
+    {
+        return LTB_MAKE_UNEXPECTED_ERROR( "SPIR-V push constants {} are not a block", struct_id );
+    }
+
+    // Stages that share the push constants often declare only the members they read, so
+    // the range starts at the first member rather than at zero.
+    auto begin = std::numeric_limits< uint32 >::max( );
+    for ( auto index = 1UZ; index < type.operands.size( ); ++index )
+    {
+        auto const member = static_cast< uint32 >( index - 1UZ );
+        auto const offset = find_member_decorations( spirv, struct_id, member ).offset;
+        begin             = std::min( begin, offset.value_or( 0U ) );
+    }
+    LTB_CHECK( auto const end, block_size( spirv, struct_id, { } ) );
+    begin = std::min( begin, end );
+
+    // Ranges are measured in whole words.
+    constexpr auto word_size = uint32{ sizeof( uint32 ) };
+    auto const     size      = ( ( ( end - begin ) + word_size - 1U ) / word_size ) * word_size;
+
+    return vk::PushConstantRange{ }.setStageFlags( stage ).setOffset( begin ).setSize( size );
+}
+
+auto descriptor_type(
+    SpirvModule const&      spirv,
+    SpirvInstruction const& type,
+    SpirvStorageClass const storage_class,
+    uint32 const            type_id
+) -> utils::Result< vk::DescriptorType >
+{
+    if ( SpirvStorageClass::StorageBuffer == storage_class )
+    {
+        return vk::DescriptorType::eStorageBuffer;
+    }
+    if ( SpirvStorageClass::Uniform == storage_class )
+    {
+        // Older compilers mark storage buffers as uniform `BufferBlock`s.
+        return find_decorations( spirv, type_id ).buffer_block ? vk::DescriptorType::eStorageBuffer
+                                                              : vk::DescriptorType::eUniformBuffer;
+    }
+
+    switch ( type.op )
+    {
+        case SpirvOp::TypeSampler:
+            return vk::DescriptorType::eSampler;
+        case SpirvOp::TypeSampledImage:
+            return vk::DescriptorType::eCombinedImageSampler;
+        case SpirvOp::TypeAccelerationStructure:
+            return vk::DescriptorType::eAccelerationStructureKHR;
+        case SpirvOp::TypeImage:
+        {
+            auto const dim     = type.operands[ 2 ];
+            auto const storage = ( spirv_image_storage == type.operands[ 6 ] );
+            if ( spirv_dim_buffer == dim )
+            {
+                return storage ? vk::DescriptorType::eStorageTexelBuffer
+                               : vk::DescriptorType::eUniformTexelBuffer;
+            }
+            if ( spirv_dim_subpass_data == dim )
+            {
+                return vk::DescriptorType::eInputAttachment;
+            }
+            return storage ? vk::DescriptorType::eStorageImage : vk::DescriptorType::eSampledImage;
+        }
+        default:
+            return LTB_MAKE_UNEXPECTED_ERROR( "SPIR-V type {} is not a descriptor", type_id );
+    }
+}
+
+auto reflect_descriptor(
+    SpirvModule const&      spirv,
+    SpirvDecorations const& decorations,
+    SpirvStorageClass const storage_class,
+    uint32                  type_id
+) -> utils::Result< ReflectedDescriptor >
+{
+    auto descriptor = ReflectedDescriptor{
+        .slot = {
+            .set     = decorations.set.value_or( 0U ),
+            .binding = decorations.binding.value_or( 0U ),
+        },
+    };
+
+    // Arrays of descriptors, possibly nested, are flattened into one binding.
+    LTB_CHECK( auto type, find_type( spirv, type_id ) );
+    while ( ( SpirvOp::TypeArray == type.op ) || ( SpirvOp::TypeRuntimeArray == type.op ) )
+    {
+        if ( SpirvOp::TypeArray == type.op )
+        {
+            LTB_CHECK( auto const length, constant_value( spirv, type.operands[ 2 ] ) );
+            descriptor.count *= length;
+        }
+        else
+        {
+            descriptor.count = 0U;
+        }
+        type_id = type.operands[ 1 ];
+        LTB_CHECK( type, find_type( spirv, type_id ) );
+    }
+
+    LTB_CHECK( descriptor.type, descriptor_type( spirv, type, storage_class, type_id ) );
+    return descriptor;
+}
+
+auto vertex_format( SpirvModule const& spirv, uint32 const type_id ) -> utils::Result< vk::Format >
+{
+    using Formats = std::array< vk::Format, 4UZ >;
+
+    constexpr auto float_formats = Formats{
+        vk::Format::eR32Sfloat,
+        vk::Format::eR32G32Sfloat,
+        vk::Format::eR32G32B32Sfloat,
+        vk::Format::eR32G32B32A32Sfloat,
+    };
+    constexpr auto double_formats = Formats{
+        vk::Format::eR64Sfloat,
+        vk::Format::eR64G64Sfloat,
+        vk::Format::eR64G64B64Sfloat,
+        vk::Format::eR64G64B64A64Sfloat,
+    };
+    constexpr auto int_formats = Formats{
+        vk::Format::eR32Sint,
+        vk::Format::eR32G32Sint,
+        vk::Format::eR32G32B32Sint,
+        vk::Format::eR32G32B32A32Sint,
+    };
+    constexpr auto uint_formats = Formats{
+        vk::Format::eR32Uint,
+        vk::Format::eR32G32Uint,
+        vk::Format::eR32G32B32Uint,
+        vk::Format::eR32G32B32A32Uint,
+    };
+
+    LTB_CHECK( auto type, find_type( spirv, type_id ) );
+    auto components = 1U;
+    if ( SpirvOp::TypeVector == type.op )
+    {
+        components = type.operands[ 2 ];
+        LTB_CHECK( type, find_type( spirv, type.operands[ 1 ] ) );
+    }
+
+    // Matrices and structs span several locations and have no single format.
+    auto const is_scalar = ( SpirvOp::TypeFloat == type.op ) || ( SpirvOp::TypeInt == type.op );
+    if ( ( !is_scalar ) || ( components < 1U ) || ( components > 4U ) )
+    {
+        return vk::Format::eUndefined;
+    }
+
+    auto const width = type.operands[ 1 ];
+    auto const index = components - 1U;
+    if ( SpirvOp::TypeFloat == type.op )
+    {
+        if ( 32U == width )
+        {
+            return float_formats[ index ];
+        }
+        if ( 64U == width )
+        {
+            return double_formats[ index ];
+        }
+    }
+    if ( ( SpirvOp::TypeInt == type.op ) && ( 32U == width ) )
+    {
+        auto const is_signed = ( 0U != type.operands[ 2 ] );
+        return is_signed ? int_formats[ index ] : uint_formats[ index ];
+    }
+    return vk::Format::eUndefined;
+}
+
+} // namespace
+
+auto ShaderReflection::has_same_layout( ShaderReflection const& other ) const -> bool
+{
+    return ( stage == other.stage ) && ( descriptors == other.descriptors )
+        && ( push_constants == other.push_constants ) && ( vertex_inputs == other.vertex_inputs );
+}
+
+auto reflect_spirv( std::span< uint32 const > const code, vk::ShaderStageFlagBits const stage )
+    -> utils::Result< ShaderReflection >
+{
+    LTB_CHECK( auto const spirv, parse_spirv( code ) );
+
+    auto reflection = ShaderReflection{ .stage = stage };
+
+    for ( auto const& variable : spirv.variables )
+    {
+        auto const variable_id   = variable.operands[ 1 ];
+        auto const storage_class = static_cast< SpirvStorageClass >( variable.operands[ 2 ] );
+        auto const decorations   = find_decorations( spirv, variable_id );
+
+        LTB_CHECK( auto const pointer, find_type( spirv, variable.operands[ 0 ] ) );
+        if ( SpirvOp::TypePointer != pointer.op )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR( "SPIR-V variable {} is not a pointer", variable_id );
+        }
+        auto const type_id = pointer.operands[ 2 ];
+
+        switch ( storage_class )
+        {
+            case SpirvStorageClass::UniformConstant:
+            case SpirvStorageClass::Uniform:
+            case SpirvStorageClass::StorageBuffer:
+            {
+                LTB_CHECK(
+                    auto const descriptor,
+                    reflect_descriptor( spirv, decorations, storage_class, type_id )
+                );
+                reflection.descriptors.push_back( descriptor );
+                break;
+            }
+
+            case SpirvStorageClass::PushConstant:
+            {
+                LTB_CHECK(
+                    reflection.push_constants,
+                    push_constant_range( spirv, type_id, stage )
+                );
+                break;
+            }
+
+            case SpirvStorageClass::Input:
+            {
+                // Built-ins like `gl_VertexIndex` are not fed by vertex attributes.
+                if ( ( vk::ShaderStageFlagBits::eVertex != stage ) || decorations.built_in
+                     || ( !decorations.location ) )
+                {
+                    break;
+                }
+                LTB_CHECK( auto const format, vertex_format( spirv, type_id ) );
+                reflection.vertex_inputs.push_back( {
+                    .location = decorations.location.value( ),
+                    .format   = format,
+                } );
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    std::ranges::sort( reflection.descriptors, [ ]( auto const& lhs, auto const& rhs ) {
+        return std::tie( lhs.slot.set, lhs.slot.binding )
+             < std::tie( rhs.slot.set, rhs.slot.binding );
+    } );
+    std::ranges::sort( reflection.vertex_inputs, { }, &ReflectedVertexInput::location );
+
+    return reflection;
+}
+
+auto reflect_pipeline_layout(
+    std::span< ShaderReflection const > const stages,
+    std::span< DescriptorSlot const > const   dynamic_buffers
+) -> utils::Result< ReflectedPipelineLayout >
+{
+    auto layout = ReflectedPipelineLayout{ };
+
+    auto const find_binding
+        = [ &layout ]( DescriptorSlot const& slot ) -> vk::DescriptorSetLayoutBinding* {
+        if ( slot.set >= layout.binding_sets.size( ) )
+        {
+            return nullptr;
+        }
+        auto&      bindings = layout.binding_sets[ slot.set ];
+        auto const iter
+            = std::ranges::find( bindings, slot.binding, &vk::DescriptorSetLayoutBinding::binding );
+        return ( bindings.end( ) == iter ) ? nullptr : &( *iter );
+    };
+
+    for ( auto const& stage : stages )
+    {
+        for ( auto const& descriptor : stage.descriptors )
+        {
+            auto const& slot = descriptor.slot;
+            if ( auto* const binding = find_binding( slot ) )
+            {
+                if ( ( binding->descriptorType != descriptor.type )
+                     || ( binding->descriptorCount != descriptor.count ) )
+                {
+                    return LTB_MAKE_UNEXPECTED_ERROR(
+                        "Set {} binding {} is declared differently by the {} stage",
+                        slot.set,
+                        slot.binding,
+                        vk::to_string( stage.stage )
+                    );
+                }
+                binding->stageFlags |= stage.stage;
+                continue;
+            }
+
+            if ( slot.set >= layout.binding_sets.size( ) )
+            {
+                layout.binding_sets.resize( slot.set + 1U );
+            }
+            layout.binding_sets[ slot.set ].push_back(
+                vk::DescriptorSetLayoutBinding{ }
+                    .setBinding( slot.binding )
+                    .setDescriptorType( descriptor.type )
+                    .setDescriptorCount( descriptor.count )
+                    .setStageFlags( stage.stage )
+            );
+        }
+
+        if ( !stage.push_constants )
+        {
+            continue;
+        }
+
+        // Stages sharing the same range share one entry. Overlapping ranges stay separate,
+        // so each is pushed with the flags of its own stage.
+        auto const& push_constants = stage.push_constants.value( );
+        auto const  same_range     = [ &push_constants ]( vk::PushConstantRange const& range ) {
+            return ( range.offset == push_constants.offset )
+                && ( range.size == push_constants.size );
+        };
+        auto range = std::ranges::find_if( layout.push_constant_ranges, same_range );
+        if ( layout.push_constant_ranges.end( ) == range )
+        {
+            layout.push_constant_ranges.push_back( push_constants );
+        }
+        else
+        {
+            range->stageFlags |= stage.stage;
+        }
+    }
+
+    for ( auto const& slot : dynamic_buffers )
+    {
+        auto* const binding = find_binding( slot );
+        if ( nullptr == binding )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Dynamic buffer at set {} binding {} is not used by any stage",
+                slot.set,
+                slot.binding
+            );
+        }
+
+        if ( vk::DescriptorType::eUniformBuffer == binding->descriptorType )
+        {
+            binding->descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+        }
+        else if ( vk::DescriptorType::eStorageBuffer == binding->descriptorType )
+        {
+            binding->descriptorType = vk::DescriptorType::eStorageBufferDynamic;
+        }
+        else
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Set {} binding {} is a {}, which cannot be dynamic",
+                slot.set,
+                slot.binding,
+                vk::to_string( binding->descriptorType )
+            );
+        }
+    }
+
+    // Dynamic offsets are consumed in binding order.
+    for ( auto& bindings : layout.binding_sets )
+    {
+        std::ranges::sort( bindings, { }, &vk::DescriptorSetLayoutBinding::binding );
+    }
+
+    return layout;
+}
+
+auto check_descriptor_counts( std::span< vk::DescriptorSetLayoutBinding const > const bindings )
+    -> utils::Result< void >
+{
+    for ( auto const& binding : bindings )
+    {
+        if ( 0U == binding.descriptorCount )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Binding {} is a runtime sized array and needs an explicit layout",
+                binding.binding
+            );
+        }
+    }
+
+    return utils::success( );
+}
+
+auto check_vertex_inputs(
+    ShaderReflection const&                                      reflection,
+    std::span< vk::VertexInputAttributeDescription const > const attributes
+) -> utils::Result< void >
+{
+    for ( auto const& input : reflection.vertex_inputs )
+    {
+        auto const attribute = std::ranges::find(
+            attributes,
+            input.location,
+            &vk::VertexInputAttributeDescription::location
+        );
+        if ( attributes.end( ) == attribute )
+        {
+            return LTB_MAKE_UNEXPECTED_ERROR(
+                "Vertex input at location {} has no attribute",
+                input.location
+            );
+        }
+    }
+
+    return utils::success( );
+}
+
+} // namespace ltb::vlk